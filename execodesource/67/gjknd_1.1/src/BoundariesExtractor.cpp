@@ -19,21 +19,21 @@
 
 #include "BoundariesExtractor.hpp"
 #include <queue>
-#include "Array2D.hpp"
 
 namespace Utils {
 
 /*
  Initialization:
-  We start by creating two arrays for the vertical and horizontal edges.
-  verticalEdge(i,j) (resp. horizontalEdge(i,j)) is 1 if the pixels image(i,j)
-  and image(i+1,j) (resp. image(i,j) and image(i,j+1)) have a different color
-  We then consider all the edges with neighboring pixels of different colors.
-  We put their values at -1 (otherwise it's 0).
+  We start by creating two maps for the vertical and horizontal edges.
+  verticalEdge(i,j) (resp. horizontalEdge(i,j)) is an edge if the pixels
+  image(i,j) and image(i+1,j) (resp. image(i,j) and image(i,j+1)) have a
+  different color. Those edges are marked as Untracked (otherwise they are
+  NoEdge). The maps are packed (2 bits per edge) and filled row by row, in the
+  storage order of the image.
 
  Body:
-  For each -1 founded in the array we compute the curve of this edge with the
-  routine trackNextEdge (reccursion).
+  For each Untracked edge found in the maps we compute the curve of this edge
+  with the routine trackBoundary.
   In order to have an ordered sequence of points, we start by the edges at the
   boundary of the image and then, we treat the interior edges.
 */
@@ -42,80 +42,75 @@ std::vector<BoundariesExtractor::Curve> BoundariesExtractor::extractBoundaries()
   std::vector<Curve> result;
 
   if (myImage) {
-    // we initialize the edge arrays for the contour extraction
-    verticalEdge   = Array2D<int>(myImage->get_width() - 1,
-                                  myImage->get_height());
-    horizontalEdge = Array2D<int>(myImage->get_width(),
-                                  myImage->get_height() - 1);
-
-    for (size_t i = 0; i < verticalEdge.width(); ++i)
-      for (size_t j = 0; j < verticalEdge.height(); ++j) {
-        verticalEdge(i,j) = 0;
-        if (myImage->get_pixel(i,j) != myImage->get_pixel(i+1,j))
-          verticalEdge(i,j) = -1;
-      }
+    const size_t width  = myImage->get_width();
+    const size_t height = myImage->get_height();
 
-    for (size_t i = 0; i < horizontalEdge.width(); ++i)
-      for (size_t j = 0; j < horizontalEdge.height(); ++j) {
-        horizontalEdge(i,j) = 0;
-        if (myImage->get_pixel(i,j) != myImage->get_pixel(i,j+1))
-          horizontalEdge(i,j) = -1;
-      }
+    // we initialize the edge maps for the contour extraction
+    verticalEdge   = EdgeMap(width - 1, height);
+    horizontalEdge = EdgeMap(width, height - 1);
+    untrackedEdges = 0;
+
+    for (size_t j = 0; j < height; ++j) {
+      const Image::row_type & row = (*myImage)[j];
+      for (size_t i = 0; i + 1 < width; ++i)
+        if (row[i] != row[i+1]) {
+          verticalEdge.set(i, j, EdgeMap::Untracked);
+          ++untrackedEdges;
+        }
+    }
+
+    for (size_t j = 0; j + 1 < height; ++j) {
+      const Image::row_type & row     = (*myImage)[j];
+      const Image::row_type & nextRow = (*myImage)[j+1];
+      for (size_t i = 0; i < width; ++i)
+        if (row[i] != nextRow[i]) {
+          horizontalEdge.set(i, j, EdgeMap::Untracked);
+          ++untrackedEdges;
+        }
+    }
 
     // We shall compute the connected components of this graph structure
-    // registered in the two edges arrays. We investigate the vertical edges to
+    // registered in the two edge maps. We investigate the vertical edges to
     // start the curve extraction. The edges that have already been extracted
-    // take negative values... the second curve has values -2...beware of the
-    // possible ambiguity
+    // are marked as Tracked. Once every edge is tracked, the remaining scans
+    // can be skipped.
     // 01
     // 10
-    int color = 0;
-
     Curve currentCurve;
     // we start with the vertical edges on the horizontal boundaries
-    for (size_t i = 0; i < verticalEdge.width(); ++i) {
-      if (verticalEdge(i,0) == -1) {
-        ++color;
+    for (size_t i = 0; i < verticalEdge.width() && untrackedEdges > 0; ++i) {
+      if (verticalEdge(i,0) == EdgeMap::Untracked) {
         currentCurve.clear();
-        trackNextEgde(Vertical, i, 0, color,
-                       currentCurve);
+        trackBoundary(Vertical, i, 0, currentCurve);
         result.push_back(currentCurve);
       }
-      if (verticalEdge(i,verticalEdge.height()-1) == -1) {
-        ++color;
+      if (verticalEdge(i,verticalEdge.height()-1) == EdgeMap::Untracked) {
         currentCurve.clear();
-        trackNextEgde(Vertical, i, verticalEdge.height()-1, color,
-                       currentCurve);
+        trackBoundary(Vertical, i, verticalEdge.height()-1, currentCurve);
         result.push_back(currentCurve);
       }
     }
 
     // we continue with the horizontal edges on the vertical boundaries
-    for (size_t j = 0; j < horizontalEdge.height(); ++j) {
-      if (horizontalEdge(0,j) == -1) {
-        ++color;
+    for (size_t j = 0; j < horizontalEdge.height() && untrackedEdges > 0; ++j) {
+      if (horizontalEdge(0,j) == EdgeMap::Untracked) {
         currentCurve.clear();
-        trackNextEgde(Horizontal, 0, j, color,
-                       currentCurve);
+        trackBoundary(Horizontal, 0, j, currentCurve);
         result.push_back(currentCurve);
       }
-      if (horizontalEdge(horizontalEdge.width()-1,j) == -1) {
-        ++color;
+      if (horizontalEdge(horizontalEdge.width()-1,j) == EdgeMap::Untracked) {
         currentCurve.clear();
-        trackNextEgde(Horizontal, horizontalEdge.width()-1, j, color,
-                       currentCurve);
+        trackBoundary(Horizontal, horizontalEdge.width()-1, j, currentCurve);
         result.push_back(currentCurve);
       }
     }
 
     // we eventually treat the rest of the image
-    for (size_t i = 1; i< verticalEdge.width(); ++i)
+    for (size_t i = 1; i < verticalEdge.width() && untrackedEdges > 0; ++i)
       for (size_t j = 1; j < horizontalEdge.height(); ++j) {
-        if (verticalEdge(i,j) == -1) {
-          ++color;
+        if (verticalEdge(i,j) == EdgeMap::Untracked) {
           currentCurve.clear();
-          trackNextEgde(Vertical, i, j, color,
-                         currentCurve);
+          trackBoundary(Vertical, i, j, currentCurve);
           // close the curve if needed
           if (currentCurve.front() != currentCurve.back())
             currentCurve.push_back(currentCurve.front());
@@ -123,11 +118,9 @@ std::vector<BoundariesExtractor::Curve> BoundariesExtractor::extractBoundaries()
           result.push_back(currentCurve);
         }
 
-        if (horizontalEdge(i,j) == -1) {
-          ++color;
+        if (horizontalEdge(i,j) == EdgeMap::Untracked) {
           currentCurve.clear();
-          trackNextEgde(Horizontal, i, j, color,
-                         currentCurve);
+          trackBoundary(Horizontal, i, j, currentCurve);
           // close the curve if needed
           if (currentCurve.front() != currentCurve.back())
             currentCurve.push_back(currentCurve.front());
@@ -135,6 +128,10 @@ std::vector<BoundariesExtractor::Curve> BoundariesExtractor::extractBoundaries()
           result.push_back(currentCurve);
         }
       }
+
+    // release the edge maps
+    verticalEdge   = EdgeMap();
+    horizontalEdge = EdgeMap();
   }
   return result;
 }
@@ -223,22 +220,49 @@ BoundariesExtractor::color4ConnectedComponents(const Image & inputImage)
 
 
 /**
-  This function is the core routine of the contour extraction. It extracts the
-  edges of the curve containing a given edge. We have the edge (horizontal or
-  vertical depending on the \a direction parameter) of coordinate (\a i, \a j)
-  and we want to compute the next edges in both directions (clockwise and
-  counterclockwise). We mark the edge during the traversal by updating its
-  value from -1 to -2 before doing the second direction and, last, to \a color.
+  Set the state of the edge (\a i, \a j) of the map given by \a direction and
+  keep the count of untracked edges up to date.
  */
-void BoundariesExtractor::trackNextEgde(Direction direction,
-                                         size_t i, size_t j, int color,
-                                         Curve & result)
+void BoundariesExtractor::markEdge(Direction direction, size_t i, size_t j,
+                                   EdgeMap::State state)
 {
-  // we follow the curve in the trignometric direction
-  if (direction == Vertical) {
-    if (verticalEdge(i,j) == -1) {
-      verticalEdge(i,j) = -2;
-      if (myImage->get_pixel(i,j) > 0) {
+  EdgeMap & edges = (direction == Vertical ? verticalEdge : horizontalEdge);
+  if (edges(i,j) == EdgeMap::Untracked)
+    --untrackedEdges;
+  edges.set(i, j, state);
+}
+
+
+/**
+  Return true if the edge (\a i, \a j) of the map given by \a direction has
+  not been visited yet.
+ */
+bool BoundariesExtractor::isUntracked(Direction direction,
+                                      size_t i, size_t j) const
+{
+  const EdgeMap & edges = (direction == Vertical ? verticalEdge
+                                                 : horizontalEdge);
+  return edges(i,j) == EdgeMap::Untracked;
+}
+
+
+/**
+  First half of a tracking step: we follow the curve in the trigonometric
+  direction. If the edge of \a step is untracked, it is marked as Tracking and
+  its point is appended to \a result. Return true if an untracked edge has to
+  be tracked next, in which case it is stored in \a next.
+ */
+bool BoundariesExtractor::nextTrigonometricEdge(const TrackingStep & step,
+                                                Curve & result,
+                                                TrackingStep & next)
+{
+  const size_t i = step.i;
+  const size_t j = step.j;
+
+  if (step.direction == Vertical) {
+    if (verticalEdge(i,j) == EdgeMap::Untracked) {
+      markEdge(Vertical, i, j, EdgeMap::Tracking);
+      if ((*myImage)[j][i] > 0) {
         // we determine if the new point (i,j) should be added in the list
         if (result.empty() || Coordinates(i,j) != result.back()) {
           result.push_back(Coordinates(i,j));
@@ -246,25 +270,18 @@ void BoundariesExtractor::trackNextEgde(Direction direction,
 
         // we search the next edge
         if (j < horizontalEdge.height()) {
-          if (horizontalEdge(i,j) != 0) {
-            if (horizontalEdge(i,j) == -1) {
-              trackNextEgde(Horizontal, i, j, color, result);
-            }
+          if (horizontalEdge(i,j) != EdgeMap::NoEdge) {
+            next = TrackingStep(Horizontal, i, j);
           }
-          else {
-            if (verticalEdge(i,j+1) != 0) {
-              if (verticalEdge(i,j+1) == -1) {
-                trackNextEgde(Vertical, i, j+1, color, result);
-              }
-            }
-            else {
-              if (i < horizontalEdge.width() - 1) {
-                if (horizontalEdge(i+1,j) == -1) {
-                  trackNextEgde(Horizontal, i+1, j, color, result);
-                }
-              }
-            }
+          else if (verticalEdge(i,j+1) != EdgeMap::NoEdge) {
+            next = TrackingStep(Vertical, i, j+1);
           }
+          else if (i < horizontalEdge.width() - 1) {
+            next = TrackingStep(Horizontal, i+1, j);
+          }
+          else
+            return false;
+          return isUntracked(next.direction, next.i, next.j);
         }
       }
       else {
@@ -275,56 +292,36 @@ void BoundariesExtractor::trackNextEgde(Direction direction,
 
         // we search the next edges
         if (j > 0) {
-          if (horizontalEdge(i+1,j-1) != 0) {
-            if (horizontalEdge(i+1,j-1) == -1) {
-              trackNextEgde(Horizontal, i+1, j-1, color, result);
-            }
-          }
-          else {
-            if (verticalEdge(i,j-1) != 0) {
-              if (verticalEdge(i,j-1) == -1) {
-                trackNextEgde(Vertical, i, j-1, color, result);
-              }
-            }
-            else {
-              if (horizontalEdge(i,j-1) == -1) {
-                trackNextEgde(Horizontal, i, j-1, color, result);
-              }
-            }
-          }
+          if (horizontalEdge(i+1,j-1) != EdgeMap::NoEdge)
+            next = TrackingStep(Horizontal, i+1, j-1);
+          else if (verticalEdge(i,j-1) != EdgeMap::NoEdge)
+            next = TrackingStep(Vertical, i, j-1);
+          else
+            next = TrackingStep(Horizontal, i, j-1);
+          return isUntracked(next.direction, next.i, next.j);
         }
       }
     }
   }
-  if (direction == Horizontal) {
-    if (horizontalEdge(i,j) == -1) {
-      horizontalEdge(i,j) = -2;
-      if (myImage->get_pixel(i,j) > 0) {
+  else {
+    if (horizontalEdge(i,j) == EdgeMap::Untracked) {
+      markEdge(Horizontal, i, j, EdgeMap::Tracking);
+      if ((*myImage)[j][i] > 0) {
         // we determine if the new point (i,j) should be added in the list
         if (result.empty() || Coordinates(i,j) != result.back()) {
           result.push_back(Coordinates(i,j));
         }
 
         if (i > 0) {
-          if (verticalEdge(i-1,j) != 0) {
-            if (verticalEdge(i-1,j) == -1) {
-              trackNextEgde(Vertical, i-1, j, color, result);
-            }
-          }
-          else {
-            if (horizontalEdge(i-1,j) != 0) {
-              if (horizontalEdge(i-1,j) == -1) {
-                trackNextEgde(Horizontal, i-1, j, color, result);
-              }
-            }
-            else {
-              if (j < verticalEdge.height() - 1) {
-                if (verticalEdge(i-1,j+1) == -1) {
-                  trackNextEgde(Vertical, i-1, j+1, color, result);
-                }
-              }
-            }
-          }
+          if (verticalEdge(i-1,j) != EdgeMap::NoEdge)
+            next = TrackingStep(Vertical, i-1, j);
+          else if (horizontalEdge(i-1,j) != EdgeMap::NoEdge)
+            next = TrackingStep(Horizontal, i-1, j);
+          else if (j < verticalEdge.height() - 1)
+            next = TrackingStep(Vertical, i-1, j+1);
+          else
+            return false;
+          return isUntracked(next.direction, next.i, next.j);
         }
       }
       else {
@@ -334,125 +331,155 @@ void BoundariesExtractor::trackNextEgde(Direction direction,
         }
 
         if (i < verticalEdge.width()) {
-          if (verticalEdge(i,j+1) != 0) {
-            if (verticalEdge(i,j+1) == -1) {
-              trackNextEgde(Vertical, i, j+1, color, result);
-            }
-          }
-          else {
-            if (horizontalEdge(i+1,j) != 0) {
-              if (horizontalEdge(i+1,j) == -1) {
-                trackNextEgde(Horizontal, i+1, j, color, result);
-              }
-            }
-            else {
-              if (verticalEdge(i,j) == -1) {
-                trackNextEgde(Vertical, i, j, color, result);
-              }
-            }
-          }
+          if (verticalEdge(i,j+1) != EdgeMap::NoEdge)
+            next = TrackingStep(Vertical, i, j+1);
+          else if (horizontalEdge(i+1,j) != EdgeMap::NoEdge)
+            next = TrackingStep(Horizontal, i+1, j);
+          else
+            next = TrackingStep(Vertical, i, j);
+          return isUntracked(next.direction, next.i, next.j);
         }
       }
     }
   }
+  return false;
+}
+
+
+/**
+  Second half of a tracking step: we follow the curve in the
+  antitrigonometric direction. The edge of \a step is marked as Tracked and
+  the stage of \a step is advanced. A vertical edge may have two candidates in
+  this direction, the second one is only considered once the curve from the
+  first one has been tracked (stage SecondAntitrigonometric). Return true if
+  an untracked edge has to be tracked next, in which case it is stored in
+  \a next.
+ */
+bool BoundariesExtractor::nextAntitrigonometricEdge(TrackingStep & step,
+                                                    TrackingStep & next)
+{
+  const size_t i = step.i;
+  const size_t j = step.j;
+
+  if (step.stage == TrackingStep::SecondAntitrigonometric) {
+    step.stage = TrackingStep::Finished;
+    if (i < horizontalEdge.width() - 1) {
+      next = TrackingStep(Horizontal, i+1, j-1);
+      return isUntracked(Horizontal, i+1, j-1);
+    }
+    return false;
+  }
 
-  // now, we follow the curve in the antitrigonometric direction
-  if (direction == Horizontal) {
-    if (horizontalEdge(i,j) == -2 || horizontalEdge(i,j) == -1) {
-      horizontalEdge(i,j) = color;
-      if (myImage->get_pixel(i,j) > 0) {
+  step.stage = TrackingStep::Finished;
+  if (step.direction == Horizontal) {
+    const EdgeMap::State state = horizontalEdge(i,j);
+    if (state == EdgeMap::Tracking || state == EdgeMap::Untracked) {
+      markEdge(Horizontal, i, j, EdgeMap::Tracked);
+      if ((*myImage)[j][i] > 0) {
         if (i < verticalEdge.width()) {
-          if (verticalEdge(i,j) != 0) {
-            if (verticalEdge(i,j) == -1) {
-              trackNextEgde(Vertical, i, j, color, result);
-            }
-          }
-          else {
-            if (horizontalEdge(i+1,j) != 0) {
-              if (horizontalEdge(i+1,j) == -1) {
-                trackNextEgde(Horizontal, i+1, j, color, result);
-              }
-            }
-            else {
-              if (j < verticalEdge.height() - 1) {
-                if (verticalEdge(i,j+1) == -1) {
-                  trackNextEgde(Vertical, i, j+1, color, result);
-                }
-              }
-            }
-          }
+          if (verticalEdge(i,j) != EdgeMap::NoEdge)
+            next = TrackingStep(Vertical, i, j);
+          else if (horizontalEdge(i+1,j) != EdgeMap::NoEdge)
+            next = TrackingStep(Horizontal, i+1, j);
+          else if (j < verticalEdge.height() - 1)
+            next = TrackingStep(Vertical, i, j+1);
+          else
+            return false;
+          return isUntracked(next.direction, next.i, next.j);
         }
       }
       else {
         if (i > 0) {
-          if (verticalEdge(i-1,j+1) != 0) {
-            if (verticalEdge(i-1,j+1) == -1) {
-              trackNextEgde(Vertical, i-1, j+1, color, result);
-            }
-          }
-          else {
-            if (horizontalEdge(i-1,j) != 0) {
-              if (horizontalEdge(i-1,j) == -1) {
-                trackNextEgde(Horizontal, i-1, j, color, result);
-              }
-            }
-            else {
-              if (verticalEdge(i-1,j) == -1) {
-                trackNextEgde(Vertical, i-1, j, color, result);
-              }
-            }
-          }
+          if (verticalEdge(i-1,j+1) != EdgeMap::NoEdge)
+            next = TrackingStep(Vertical, i-1, j+1);
+          else if (horizontalEdge(i-1,j) != EdgeMap::NoEdge)
+            next = TrackingStep(Horizontal, i-1, j);
+          else
+            next = TrackingStep(Vertical, i-1, j);
+          return isUntracked(next.direction, next.i, next.j);
         }
       }
     }
   }
-  if (direction == Vertical) {
-    if (verticalEdge(i,j) == -2 || verticalEdge(i,j) == -1) {
-      verticalEdge(i,j)= color;
-      if (myImage->get_pixel(i,j) > 0) {
+  else {
+    const EdgeMap::State state = verticalEdge(i,j);
+    if (state == EdgeMap::Tracking || state == EdgeMap::Untracked) {
+      markEdge(Vertical, i, j, EdgeMap::Tracked);
+      if ((*myImage)[j][i] > 0) {
         if (j > 0) {
-          if (horizontalEdge(i,j-1) != 0) {
-            if (horizontalEdge(i,j-1) == -1) {
-              trackNextEgde(Horizontal, i, j-1, color, result);
-            }
+          if (horizontalEdge(i,j-1) != EdgeMap::NoEdge) {
+            next = TrackingStep(Horizontal, i, j-1);
+            return isUntracked(Horizontal, i, j-1);
           }
-          else {
-            if (verticalEdge(i,j-1) != 0) {
-              if (verticalEdge(i,j-1) == -1) {
-                trackNextEgde(Vertical, i, j-1, color, result);
-              }
-            }
-            if (i < horizontalEdge.width() - 1) {
-              if (horizontalEdge(i+1,j-1) == -1) {
-                trackNextEgde(Horizontal, i+1, j-1, color, result);
-              }
-            }
+          // both the edge below and the one on the right-hand side are
+          // candidates, the latter is checked once the former is tracked
+          step.stage = TrackingStep::SecondAntitrigonometric;
+          if (verticalEdge(i,j-1) != EdgeMap::NoEdge) {
+            next = TrackingStep(Vertical, i, j-1);
+            return isUntracked(Vertical, i, j-1);
           }
         }
       }
       else {
         if (j < horizontalEdge.height()) {
-          if (horizontalEdge(i+1,j) != 0) {
-            if (horizontalEdge(i+1,j) == -1) {
-              trackNextEgde(Horizontal, i+1, j, color, result);
-            }
-          }
-          else{
-            if (verticalEdge(i,j+1) != 0) {
-              if (verticalEdge(i,j+1) == -1) {
-                trackNextEgde(Vertical, i, j+1, color, result);
-              }
-            }
-            else{
-              if (horizontalEdge(i,j) == -1) {
-                trackNextEgde(Horizontal, i, j, color, result);
-              }
-            }
-          }
+          if (horizontalEdge(i+1,j) != EdgeMap::NoEdge)
+            next = TrackingStep(Horizontal, i+1, j);
+          else if (verticalEdge(i,j+1) != EdgeMap::NoEdge)
+            next = TrackingStep(Vertical, i, j+1);
+          else
+            next = TrackingStep(Horizontal, i, j);
+          return isUntracked(next.direction, next.i, next.j);
         }
       }
     }
   }
+  return false;
+}
+
+
+/**
+  This function is the core routine of the contour extraction. It extracts the
+  edges of the curve containing a given edge. We have the edge (horizontal or
+  vertical depending on the \a direction parameter) of coordinate (\a i, \a j)
+  and we want to compute the next edges in both directions (clockwise and
+  counterclockwise). An edge is marked as Tracking when it is reached in the
+  first direction and as Tracked before doing the second direction.
+
+  The traversal is a depth-first one: each edge first leads to its successor in
+  the trigonometric direction, and once the whole curve beyond it has been
+  followed, to its successor in the antitrigonometric direction. The pending
+  edges are kept on an explicit stack so that long boundaries cannot overflow
+  the call stack.
+ */
+void BoundariesExtractor::trackBoundary(Direction direction,
+                                        size_t i, size_t j, Curve & result)
+{
+  trackingStack.clear();
+  trackingStack.push_back(TrackingStep(direction, i, j));
+
+  TrackingStep next(direction, i, j);
+  while (!trackingStack.empty()) {
+    TrackingStep & step = trackingStack.back();
+    bool found = false;
+
+    switch (step.stage) {
+    case TrackingStep::Trigonometric:
+      step.stage = TrackingStep::Antitrigonometric;
+      found = nextTrigonometricEdge(step, result, next);
+      break;
+    case TrackingStep::Antitrigonometric:
+    case TrackingStep::SecondAntitrigonometric:
+      found = nextAntitrigonometricEdge(step, next);
+      break;
+    case TrackingStep::Finished:
+      trackingStack.pop_back();
+      break;
+    }
+
+    // step may be invalidated by this insertion
+    if (found)
+      trackingStack.push_back(next);
+  }
 }
 
 } // namespace Utils
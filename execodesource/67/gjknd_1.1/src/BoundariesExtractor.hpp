@@ -22,7 +22,7 @@
 
 #include <vector>
 #include <utility>
-#include "Array2D.hpp"
+#include "EdgeMap.hpp"
 #include "png++/png.hpp"
 
 namespace Utils {
@@ -79,7 +79,8 @@ public:
     Create a new BoundariesExtractor to extract the contour of each 4-connected
     component of the \a image.
    */
-  BoundariesExtractor(const Image * image = 0) : myImage(image) {}
+  BoundariesExtractor(const Image * image = 0)
+    : myImage(image), untrackedEdges(0) {}
   ~BoundariesExtractor() {}
 
   /**
@@ -117,8 +118,32 @@ private:
 
   Image color4ConnectedComponents(const Image & inputImage);
 
-  void trackNextEgde(Direction direction, size_t i, size_t j, int color,
-                     Curve & result);
+  /// A pending step of the contour tracking (see trackBoundary())
+  struct TrackingStep
+  {
+    enum Stage {Trigonometric, Antitrigonometric, SecondAntitrigonometric,
+                Finished};
+
+    TrackingStep(Direction d, size_t x, size_t y)
+      : direction(d), i(x), j(y), stage(Trigonometric) {}
+
+    Direction direction;
+    size_t    i;
+    size_t    j;
+    Stage     stage;
+  };
+
+  void markEdge(Direction direction, size_t i, size_t j,
+                EdgeMap::State state);
+
+  bool isUntracked(Direction direction, size_t i, size_t j) const;
+
+  bool nextTrigonometricEdge(const TrackingStep & step, Curve & result,
+                             TrackingStep & next);
+
+  bool nextAntitrigonometricEdge(TrackingStep & step, TrackingStep & next);
+
+  void trackBoundary(Direction direction, size_t i, size_t j, Curve & result);
 
 private:
   BoundariesExtractor(const BoundariesExtractor &);
@@ -127,8 +152,12 @@ private:
 private:
   const Image * myImage;
 
-  Utils::Array2D<int> verticalEdge;
-  Utils::Array2D<int> horizontalEdge;
+  Utils::EdgeMap verticalEdge;
+  Utils::EdgeMap horizontalEdge;
+  /// number of edges of both maps that are still EdgeMap::Untracked
+  size_t         untrackedEdges;
+  /// explicit stack used by trackBoundary(), kept to reuse its storage
+  std::vector<TrackingStep> trackingStack;
 };
 
 } // namespace Utils
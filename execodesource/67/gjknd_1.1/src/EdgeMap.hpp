@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2012   Laurent Provot <provot.research@gmail.com>,
+ * Yan Gerard <yan.gerard@free.fr> and Fabien Feschet <research@feschet.fr>
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UTILS_EDGE_MAP_HPP
+#define UTILS_EDGE_MAP_HPP
+
+#include <vector>
+#include <cstddef>
+
+namespace Utils {
+
+/**
+  \class EdgeMap
+  \brief A packed 2D array storing the tracking state of the edges between
+         pixels, 2 bits per edge.
+
+  The states are stored row-major (i.e. the edge at position (\a x, \a y)
+  is the (y * width + x)-th one), four edges per byte.
+  \code
+  EdgeMap edges(3,7);
+
+  edges.set(1,4, EdgeMap::Untracked);
+  if (edges(1,4) == EdgeMap::Untracked) ...
+  \endcode
+ */
+class EdgeMap
+{
+public:
+  /// The state of an edge
+  enum State {
+    NoEdge    = 0, ///< both pixels have the same color
+    Untracked = 1, ///< a boundary edge that has not been visited yet
+    Tracking  = 2, ///< an edge whose curve is being tracked
+    Tracked   = 3  ///< an edge that belongs to an extracted curve
+  };
+
+public:
+  /**
+    Construct an empty map.
+   */
+  EdgeMap() : myWidth(0), myHeight(0) {}
+
+  /**
+    Construct a \a width x \a height map where every edge is NoEdge.
+   */
+  EdgeMap(size_t width, size_t height)
+    : myWidth(width), myHeight(height), myBits((width * height + 3) / 4, 0)
+  {}
+
+  /**
+    Return the state of the edge at position (\a x, \a y)
+   */
+  State operator () (size_t x, size_t y) const
+  {
+    const size_t index = y * myWidth + x;
+    return State((myBits[index >> 2] >> ((index & 3) << 1)) & 3);
+  }
+
+  /**
+    Set the state of the edge at position (\a x, \a y) to \a state.
+   */
+  void set(size_t x, size_t y, State state)
+  {
+    const size_t index = y * myWidth + x;
+    const unsigned int shift = (index & 3) << 1;
+    unsigned char & byte = myBits[index >> 2];
+    byte = (byte & ~(3 << shift)) | (state << shift);
+  }
+
+  /**
+    Return the width of the map.
+   */
+  size_t width() const { return myWidth; }
+
+  /**
+    Return the height of the map.
+   */
+  size_t height() const { return myHeight; }
+
+private:
+  size_t                     myWidth;
+  size_t                     myHeight;
+  std::vector<unsigned char> myBits;
+};
+
+} // namespace Utils
+
+#endif // UTILS_EDGE_MAP_HPP
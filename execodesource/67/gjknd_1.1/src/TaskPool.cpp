@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2012   Laurent Provot <provot.research@gmail.com>,
+ * Yan Gerard <yan.gerard@free.fr> and Fabien Feschet <research@feschet.fr>
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TaskPool.hpp"
+#include <algorithm>
+#include <unistd.h>
+
+namespace Utils {
+
+TaskPool::TaskPool(size_t threadNumber)
+  : myThreadNumber(threadNumber > 0 ? threadNumber : availableProcessors()),
+    myTasks(0), myNextTask(0)
+{}
+
+
+size_t TaskPool::availableProcessors()
+{
+  const long processors = sysconf(_SC_NPROCESSORS_ONLN);
+  return processors > 0 ? static_cast<size_t>(processors) : 1;
+}
+
+
+/**
+  Every thread of the pool (the calling one included) runs this loop until
+  there are no more pending tasks. Threads that cannot be created are simply
+  not used: the remaining ones do their share of the work.
+ */
+void TaskPool::run(const std::vector<Task *> & tasks)
+{
+  if (myThreadNumber <= 1 || tasks.size() <= 1) {
+    for (size_t i = 0; i < tasks.size(); ++i)
+      tasks[i]->run();
+    return;
+  }
+
+  myTasks = &tasks;
+  myNextTask = 0;
+  pthread_mutex_init(&myMutex, 0);
+
+  std::vector<pthread_t> threads;
+  const size_t extraThreads = std::min(myThreadNumber, tasks.size()) - 1;
+  for (size_t i = 0; i < extraThreads; ++i) {
+    pthread_t thread;
+    if (pthread_create(&thread, 0, &TaskPool::worker, this) == 0)
+      threads.push_back(thread);
+  }
+
+  worker(this);
+
+  for (size_t i = 0; i < threads.size(); ++i)
+    pthread_join(threads[i], 0);
+
+  pthread_mutex_destroy(&myMutex);
+  myTasks = 0;
+}
+
+
+void * TaskPool::worker(void * pool)
+{
+  TaskPool * self = static_cast<TaskPool *>(pool);
+  for (Task * task = self->nextTask(); task != 0; task = self->nextTask())
+    task->run();
+  return 0;
+}
+
+
+TaskPool::Task * TaskPool::nextTask()
+{
+  Task * task = 0;
+  pthread_mutex_lock(&myMutex);
+  if (myNextTask < myTasks->size())
+    task = (*myTasks)[myNextTask++];
+  pthread_mutex_unlock(&myMutex);
+  return task;
+}
+
+} // namespace Utils
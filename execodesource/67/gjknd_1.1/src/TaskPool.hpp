@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2012   Laurent Provot <provot.research@gmail.com>,
+ * Yan Gerard <yan.gerard@free.fr> and Fabien Feschet <research@feschet.fr>
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef UTILS_TASK_POOL_HPP
+#define UTILS_TASK_POOL_HPP
+
+#include <vector>
+#include <cstddef>
+#include <pthread.h>
+
+namespace Utils {
+
+/**
+  \class TaskPool
+  \brief A minimalist pool of threads that runs a list of independent tasks.
+
+  The tasks are handed out to the threads in the order of the list, each
+  thread picking the next pending task as soon as it is done with its current
+  one. A task must only write into its own result buffer, so that the results
+  do not depend on the scheduling.
+  \code
+  class MyTask : public Utils::TaskPool::Task {
+  public:
+    void run() { ... }
+  };
+
+  std::vector<Utils::TaskPool::Task *> tasks;
+  // fill the list of tasks
+  Utils::TaskPool pool(4);
+  pool.run(tasks);
+  // all the tasks are done here
+  \endcode
+ */
+class TaskPool
+{
+public:
+  /**
+    \brief The interface of a task run by a TaskPool.
+   */
+  class Task
+  {
+  public:
+    virtual ~Task() {}
+
+    /**
+      Do the work of the task. This function is called exactly once, from any
+      thread of the pool.
+     */
+    virtual void run() = 0;
+  };
+
+public:
+  /**
+    Create a pool of \a threadNumber threads (the calling thread included).
+    If \a threadNumber is 0, one thread per available processor is used.
+   */
+  TaskPool(size_t threadNumber = 1);
+  ~TaskPool() {}
+
+  /**
+    Return the number of threads of the pool.
+   */
+  size_t threadNumber() const { return myThreadNumber; }
+
+  /**
+    Run all the \a tasks and return once every one of them is done.
+   */
+  void run(const std::vector<Task *> & tasks);
+
+  /**
+    Return the number of processors available on this computer (at least 1).
+   */
+  static size_t availableProcessors();
+
+private:
+  static void * worker(void * pool);
+
+  Task * nextTask();
+
+private:
+  TaskPool(const TaskPool &);
+  TaskPool & operator=(const TaskPool &);
+
+private:
+  size_t myThreadNumber;
+
+  const std::vector<Task *> * myTasks;
+  size_t                      myNextTask;
+  pthread_mutex_t             myMutex;
+};
+
+} // namespace Utils
+
+#endif // UTILS_TASK_POOL_HPP
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2012   Laurent Provot <provot.research@gmail.com>,
+ * Yan Gerard <yan.gerard@free.fr> and Fabien Feschet <research@feschet.fr>
+ * All rights reserved.
+ *
+ * This is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <iostream>
+#include "tclap/CmdLine.h"
+#include "png++/png.hpp"
+#include "BoundariesExtractor.hpp"
+#include "utils.hpp"
+
+
+using namespace std;
+
+/**
+  Return a copy of \a image where every pixel is replaced by a
+  \a scale x \a scale block of pixels of the same value.
+ */
+png::image<png::gray_pixel> upscale(const png::image<png::gray_pixel> & image,
+                                    size_t scale)
+{
+  png::image<png::gray_pixel> result(image.get_width() * scale,
+                                     image.get_height() * scale);
+  for (size_t j = 0; j < result.get_height(); ++j) {
+    const png::image<png::gray_pixel>::row_type & row = image[j / scale];
+    for (size_t i = 0; i < result.get_width(); ++i)
+      result[j][i] = row[i / scale];
+  }
+  return result;
+}
+
+int main(int argc, char *argv[])
+{
+  // Command-line parsing ------------------------------------------------------
+  std::string inputFile;
+  bool blackBackground;
+  size_t scale;
+  size_t repeat;
+
+  try {
+    TCLAP::CmdLine cmd("Benchmark the boundaries extraction of a binary image",
+                       ' ', "1.0");
+    TCLAP::UnlabeledValueArg<std::string> inputArg("input",
+                                                   "The input file (PNG image)",
+                                                   true, "", "file");
+    TCLAP::SwitchArg bgArg("b", "black-background",
+                           "Specify that the image has a very dark background",
+                           false);
+    TCLAP::ValueArg<size_t> scaleArg("s", "scale",
+                                     "Upscale the image by this factor before "
+                                     "the extraction",
+                                     false, 1, "factor");
+    TCLAP::ValueArg<size_t> repeatArg("r", "repeat",
+                                      "Number of extractions to time",
+                                      false, 10, "count");
+    cmd.add(inputArg);
+    cmd.add(bgArg);
+    cmd.add(scaleArg);
+    cmd.add(repeatArg);
+    cmd.parse(argc, argv);
+
+    inputFile = inputArg.getValue();
+    blackBackground = bgArg.getValue();
+    scale = std::max<size_t>(scaleArg.getValue(), 1);
+    repeat = std::max<size_t>(repeatArg.getValue(), 1);
+  }
+  catch (TCLAP::ArgException & e) {
+    std::cerr << "Error: " << e.error() << " for arg " << e.argId()
+              << std::endl;
+    exit(EXIT_FAILURE);
+  }
+  // End of command-line parsing -----------------------------------------------
+
+  png::image<png::gray_pixel> image(inputFile);
+  Utils::otsuThresholding(image);
+  if (!blackBackground)
+    Utils::binaryImageToNegative(image);
+  if (scale > 1)
+    image = upscale(image, scale);
+
+  typedef Utils::BoundariesExtractor::Curve Curve;
+  Utils::BoundariesExtractor be;
+  std::vector<Curve> contours;
+
+  const std::clock_t start = std::clock();
+  for (size_t r = 0; r < repeat; ++r)
+    contours = be.extractBoundaries(image);
+  const double seconds = static_cast<double>(std::clock() - start)
+                         / CLOCKS_PER_SEC;
+
+  size_t pointNumber = 0;
+  for (std::vector<Curve>::const_iterator curvesItor = contours.begin();
+       curvesItor != contours.end(); ++curvesItor)
+    pointNumber += curvesItor->size();
+
+  std::cout << "Image size: " << image.get_width() << "x"
+            << image.get_height() << std::endl;
+  std::cout << "Contour number: " << contours.size() << std::endl;
+  std::cout << "Point number: " << pointNumber << std::endl;
+  std::cout << "Time per extraction: " << 1000.0 * seconds / repeat << " ms"
+            << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -18,8 +18,10 @@
  */
 
 #include <cstdlib>
+#include <ctime>
 #include <string>
 #include <iostream>
+#include <algorithm>
 #include "tclap/CmdLine.h"
 #include "png++/png.hpp"
 #include "BoundariesExtractor.hpp"
@@ -28,14 +30,114 @@
 #include "StraightLine.hpp"
 #include "Circle.hpp"
 #include "Conic.hpp"
+#include "TaskPool.hpp"
 #include "utils.hpp"
 
 bool blackBackground;
 bool verbose;
 
+/**
+  Return the value of a monotonic clock, in seconds.
+ */
+double wallClock()
+{
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+
+/**
+  The decomposition of all the contours wrt. one DLL model. Each contour is
+  decomposed by its own task into its own result buffer so that the contours
+  (of every model) can be processed concurrently by a Utils::TaskPool. The
+  output image is then filled sequentially, in the order of the contours.
+ */
+class DLLDecomposition
+{
+public:
+  DLLDecomposition(const std::string & modelName) : myName(modelName) {}
+  virtual ~DLLDecomposition() {}
+
+  /// Return the name of the DLL model.
+  const std::string & name() const { return myName; }
+
+  /// Append one task per contour to \a tasks.
+  virtual void addTasks(std::vector<Utils::TaskPool::Task *> & tasks) = 0;
+
+  /// Color each DLL segment into \a output (and print it when verbose).
+  virtual void fillImage(png::image<png::rgb_pixel> & output) = 0;
+
+  /// Print the number of DLL segments and the time spent on the model.
+  virtual void printSummary(std::ostream & out) const = 0;
+
+private:
+  std::string myName;
+};
+
+
 template <typename DLL_Type, typename Curve>
-void fillImageWithDecompostion(const std::vector<Curve> & contours,
-                               png::image<png::rgb_pixel> & output)
+class ModelDecomposition : public DLLDecomposition
+{
+public:
+  typedef typename DLL::Segment<DLL_Type>   DLLSegment;
+
+  ModelDecomposition(const std::string & modelName,
+                     const std::vector<Curve> & contours)
+    : DLLDecomposition(modelName), myContours(contours),
+      myTasks(contours.size())
+  {
+    for (size_t i = 0; i < myTasks.size(); ++i)
+      myTasks[i].contour = &myContours[i];
+  }
+
+  void addTasks(std::vector<Utils::TaskPool::Task *> & tasks)
+  {
+    for (size_t i = 0; i < myTasks.size(); ++i)
+      tasks.push_back(&myTasks[i]);
+  }
+
+  void fillImage(png::image<png::rgb_pixel> & output);
+
+  void printSummary(std::ostream & out) const
+  {
+    size_t nbDLL = 0;
+    double seconds = 0.0;
+    for (size_t i = 0; i < myTasks.size(); ++i) {
+      nbDLL += myTasks[i].dlls.size();
+      seconds += myTasks[i].seconds;
+    }
+    out << name() << ": " << myContours.size() << " contours, "
+        << nbDLL << " DLL segments, " << seconds << " s" << std::endl;
+  }
+
+private:
+  /// The decomposition of a single contour
+  struct ContourTask : public Utils::TaskPool::Task
+  {
+    ContourTask() : contour(0), seconds(0.0) {}
+
+    void run()
+    {
+      const double start = wallClock();
+      Utils::GreedyDecomposition<DLLSegment> decompositor;
+      dlls = decompositor.decomposeCurve(*contour);
+      seconds = wallClock() - start;
+    }
+
+    const Curve *           contour;
+    std::vector<DLLSegment> dlls;
+    double                  seconds;
+  };
+
+  const std::vector<Curve> & myContours;
+  std::vector<ContourTask>   myTasks;
+};
+
+
+template <typename DLL_Type, typename Curve>
+void ModelDecomposition<DLL_Type, Curve>::fillImage(
+    png::image<png::rgb_pixel> & output)
 {
   // Color map for the DLL
   const png::rgb_pixel pixelColors[4] = {
@@ -49,14 +151,9 @@ void fillImageWithDecompostion(const std::vector<Curve> & contours,
     png::rgb_pixel(255,255,0)
   };
 
-  typedef typename DLL::Segment<DLL_Type>   DLLSegment;
-  Utils::GreedyDecomposition<DLLSegment> decompositor;
-
   unsigned int nbDLL = 0;
-  for (typename std::vector<Curve>::const_iterator contourItor = contours.begin();
-       contourItor != contours.end(); ++contourItor) {
-    // decompose the current contour
-    typename std::vector<DLLSegment> dlls = decompositor.decomposeCurve(*contourItor);
+  for (size_t i = 0; i < myTasks.size(); ++i) {
+    const std::vector<DLLSegment> & dlls = myTasks[i].dlls;
     // color each DLL segment into the output image
     // and display the points coordinates of the DLL segment on the console
     unsigned int colorIndex = 3;
@@ -83,12 +180,29 @@ void fillImageWithDecompostion(const std::vector<Curve> & contours,
 }
 
 
+/**
+  Order the tasks by decreasing contour length, so that the longest contours
+  do not end up being decomposed last.
+ */
+struct LongestContourFirst
+{
+  typedef std::pair<size_t, Utils::TaskPool::Task *> SizedTask;
+
+  bool operator()(const SizedTask & t1, const SizedTask & t2) const
+  {
+    return t1.first > t2.first;
+  }
+};
+
+
 int main(int argc, char *argv[])
 {
   // Command-line parsing ------------------------------------------------------
   std::string inputFile;
   std::string outputFile;
   std::vector<std::string> models;
+  size_t threadNumber;
+  bool timing;
 
   try {
     TCLAP::CmdLine cmd("Decomposes the contours of the input PNG image into "
@@ -105,6 +219,16 @@ int main(int argc, char *argv[])
           "b", "black-background",
           "Specify that the image has a very dark background.", false
     );
+    TCLAP::ValueArg<size_t> threadsArg(
+          "j", "threads",
+          "The number of threads used to decompose the contours (0 stands for "
+          "one thread per processor).", false, 1, "count"
+    );
+    TCLAP::SwitchArg timingArg(
+          "t", "timing",
+          "Prints a run-time summary of each DLL model on the terminal's "
+          "standard error.", false
+    );
     TCLAP::MultiArg<std::string> dllArg(
           "d", "dll-model",
           "The underlying DLL model used for the decomposition.", false,
@@ -114,6 +238,8 @@ int main(int argc, char *argv[])
     cmd.add(inputArg);
     cmd.add(verboseArg);
     cmd.add(bgArg);
+    cmd.add(threadsArg);
+    cmd.add(timingArg);
     cmd.add(dllArg);
     cmd.parse(argc, argv);
 
@@ -121,6 +247,8 @@ int main(int argc, char *argv[])
     verbose = verboseArg.getValue();
     blackBackground = bgArg.getValue();
     models = dllArg.getValue();
+    threadNumber = threadsArg.getValue();
+    timing = timingArg.getValue();
   }
   catch (TCLAP::ArgException & e) {
     std::cerr << "Error: " << e.error() << " for arg " << e.argId()
@@ -156,26 +284,58 @@ int main(int argc, char *argv[])
     models.push_back("Circle");
     models.push_back("Conic");
   }
-  // Decompose into DLLs and save the result
+  std::vector<DLLDecomposition *> decompositions;
   for (size_t i = 0; i < models.size(); ++i) {
+    if (models[i] == "StraightLine")
+      decompositions.push_back(
+            new ModelDecomposition<DLL::StraightLine, Curve>(models[i], contours));
+    else if (models[i] == "Circle")
+      decompositions.push_back(
+            new ModelDecomposition<DLL::Circle, Curve>(models[i], contours));
+    else if (models[i] == "Conic")
+      decompositions.push_back(
+            new ModelDecomposition<DLL::Conic, Curve>(models[i], contours));
+    else
+      std::cerr << "Unknown " << models[i] << " DLL model" << std::endl;
+  }
+
+  // Decompose into DLLs: every (model, contour) pair is an independent task
+  std::vector<LongestContourFirst::SizedTask> sizedTasks;
+  for (size_t i = 0; i < decompositions.size(); ++i) {
+    std::vector<Utils::TaskPool::Task *> modelTasks;
+    decompositions[i]->addTasks(modelTasks);
+    for (size_t j = 0; j < modelTasks.size(); ++j)
+      sizedTasks.push_back(std::make_pair(contours[j].size(), modelTasks[j]));
+  }
+  std::stable_sort(sizedTasks.begin(), sizedTasks.end(), LongestContourFirst());
+
+  std::vector<Utils::TaskPool::Task *> tasks(sizedTasks.size());
+  for (size_t i = 0; i < sizedTasks.size(); ++i)
+    tasks[i] = sizedTasks[i].second;
+
+  Utils::TaskPool pool(threadNumber);
+  const double start = wallClock();
+  pool.run(tasks);
+  const double seconds = wallClock() - start;
+
+  // Save the result
+  for (size_t i = 0; i < decompositions.size(); ++i) {
     if (!blackBackground)
       Utils::fillImage(output, png::rgb_pixel(255,255,255));
 
-    if (models[i] == "StraightLine") {
-      fillImageWithDecompostion<DLL::StraightLine>(contours, output);
-      output.write("StraightLine_" + outputFile);
-    }
-    else if (models[i] == "Circle") {
-      fillImageWithDecompostion<DLL::Circle>(contours, output);
-      output.write("Circle_" + outputFile);
-    }
-    else if (models[i] == "Conic") {
-      fillImageWithDecompostion<DLL::Conic>(contours, output);
-      output.write("Conic_" + outputFile);
-    }
-    else
-      std::cerr << "Unknown " << models[i] << " DLL model" << std::endl;
+    decompositions[i]->fillImage(output);
+    output.write(decompositions[i]->name() + "_" + outputFile);
   }
 
+  if (timing) {
+    for (size_t i = 0; i < decompositions.size(); ++i)
+      decompositions[i]->printSummary(std::cerr);
+    std::cerr << "Decomposition: " << seconds << " s with "
+              << pool.threadNumber() << " thread(s)" << std::endl;
+  }
+
+  for (size_t i = 0; i < decompositions.size(); ++i)
+    delete decompositions[i];
+
   return EXIT_SUCCESS;
 }
@@ -27,56 +27,65 @@
 
 #include "BaseDistanceDT.h"
 
-void BaseDistanceTransform::rotate() {
-    GrayscalePixelType *t = dtLines[2];
+template <typename outputPixelType>
+void BaseDistanceTransform<outputPixelType>::rotate() {
+    outputPixelType *t = dtLines[2];
     dtLines[2] = dtLines[1];
     dtLines[1] = dtLines[0];
     dtLines[0] = t;
 }
 
-void BaseDistanceTransform::beginOfImage(int cols, int rows) {
+template <typename outputPixelType>
+void BaseDistanceTransform<outputPixelType>::beginOfImage(int cols, int rows) {
     assert(!_inited);
     assert(_cols == 0);
-    assert(dtLines[0] == NULL);
-    assert(dtLines[1] == NULL);
-    assert(dtLines[2] == NULL);
 
+    // The lines are kept from one image to the next one and only grown
+    // when an image is wider than the previous ones.
+    if (cols > _allocatedCols) {
+	for (int i = 0; i < 3; i++) {
+	    free(dtLines[i]);
+	    dtLines[i] = (outputPixelType *) malloc((2 + cols + 1) * sizeof(outputPixelType));
+	    assert(dtLines[i]);
+	}
+	_allocatedCols = cols;
+    }
     _cols = cols;
-    dtLines[0] = (GrayscalePixelType *) malloc((2 + cols + 1) * sizeof(GrayscalePixelType));
-    memset(dtLines[0], 0, (2 + cols + 1) * sizeof(GrayscalePixelType));
-    dtLines[1] = (GrayscalePixelType *) malloc((2 + cols + 1) * sizeof(GrayscalePixelType));
-    memset(dtLines[1], 0, (2 + cols + 1) * sizeof(GrayscalePixelType));
-    dtLines[2] =  (GrayscalePixelType *) malloc((2 + cols + 1) * sizeof(GrayscalePixelType));
-    memset(dtLines[2], 0, (2 + cols + 1) * sizeof(GrayscalePixelType));
+    memset(dtLines[0], 0, (2 + cols + 1) * sizeof(outputPixelType));
+    memset(dtLines[1], 0, (2 + cols + 1) * sizeof(outputPixelType));
+    memset(dtLines[2], 0, (2 + cols + 1) * sizeof(outputPixelType));
 
-    _consumer->beginOfImage(cols, rows);
+    this->_consumer->beginOfImage(cols, rows);
 
     _inited = true;
 }
 
-void BaseDistanceTransform::endOfImage() {
-    _consumer->endOfImage();
+template <typename outputPixelType>
+void BaseDistanceTransform<outputPixelType>::endOfImage() {
+    this->_consumer->endOfImage();
 
-    free(dtLines[0]);
-    free(dtLines[1]);
-    free(dtLines[2]);
-
-    dtLines[0] = NULL;
-    dtLines[1] = NULL;
-    dtLines[2] = NULL;
     _cols = 0;
     _inited = false;
 }
 
-BaseDistanceTransform::BaseDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer) :
+template <typename outputPixelType>
+BaseDistanceTransform<outputPixelType>::BaseDistanceTransform(ImageConsumer<outputPixelType>* consumer) :
 super(consumer),
 _inited(false),
-_cols(0) {
+_cols(0),
+_allocatedCols(0) {
 
     dtLines[0] = NULL;
     dtLines[1] = NULL;
     dtLines[2] = NULL;
 }
 
-BaseDistanceTransform::~BaseDistanceTransform() {
+template <typename outputPixelType>
+BaseDistanceTransform<outputPixelType>::~BaseDistanceTransform() {
+    free(dtLines[0]);
+    free(dtLines[1]);
+    free(dtLines[2]);
 }
+
+template class BaseDistanceTransform<Grayscale8PixelType>;
+template class BaseDistanceTransform<Grayscale16PixelType>;
@@ -42,48 +42,76 @@ protected:
     _rightMargin(rightMargin),
     _curRow(0),
     _dtRowCount(0),
+    _allocatedCols(0),
+    _allocatedRows(0),
+    _checkAssignments(false),
     _outputRows(NULL) {
 	_tdtRows[0] = NULL;
 	_tdtRows[1] = NULL;
     }
 
+    ~DistanceTransformUntranslator() {
+	for (int row = 0; row < _allocatedRows; row++) {
+	    free(_outputRows[row]);
+	}
+	free(_outputRows);
+	free(_tdtRows[0]);
+	free(_tdtRows[1]);
+    }
+
     void beginOfImage(int cols, int rows, int dtRowCount) {
 	assert(!_inited);
 	assert(_cols == 0);
 	assert(_curRow == 0);
 	assert(_dtRowCount == 0);
-	assert(_outputRows == NULL);
-	assert(_tdtRows[0] == NULL);
-	assert(_tdtRows[1] == NULL);
 	
-	_dtRowCount = dtRowCount;
-	_outputRows = (outputPixelType **)malloc(_dtRowCount * sizeof(outputPixelType *));
-	assert(_outputRows);
-	_tdtRows[0] = (inputPixelType *) malloc((cols + 1) * sizeof(inputPixelType));
+	// Buffers are kept from one image to the next one and only grown
+	// when an image needs more columns or rows than the previous ones.
+	if (cols > _allocatedCols || dtRowCount > _allocatedRows) {
+	    for (int row = 0; row < _allocatedRows; row++) {
+		free(_outputRows[row]);
+	    }
+	    free(_outputRows);
+	    free(_tdtRows[0]);
+	    free(_tdtRows[1]);
+
+	    _allocatedCols = std::max(cols, _allocatedCols);
+	    _allocatedRows = std::max(dtRowCount, _allocatedRows);
+	    _outputRows = (outputPixelType **)malloc(_allocatedRows * sizeof(outputPixelType *));
+	    assert(_outputRows);
+	    _tdtRows[0] = (inputPixelType *) malloc((_allocatedCols + 1) * sizeof(inputPixelType));
+	    assert(_tdtRows[0]);
+	    _tdtRows[1] = (inputPixelType *) malloc((_allocatedCols + 1) * sizeof(inputPixelType));
+	    assert(_tdtRows[1]);
+
+	    for (int row = 0; row < _allocatedRows; row++) {
+		_outputRows[row] = (outputPixelType *) malloc(_allocatedCols * sizeof(outputPixelType));
+	    }
+	}
+#ifndef NDEBUG
+	// Set all values to -1 to check later that each pixel is assigned a
+	// value exactly once.
+	// - assert pixel is -1 before setting a value
+	// - assert pixel is not -1 before outputting and resetting it
+	// The previous image may have left values in rows it did not output.
+	// The check is skipped when the distance values of the image (lower
+	// than dtRowCount) may reach -1, the largest value of 8-bit pixels.
+	_checkAssignments = dtRowCount <= grayscaleMax<outputPixelType>();
+	for (int row = 0; row < _allocatedRows; row++) {
+	    for (int col = 0; col < _allocatedCols; col++) {
+		_outputRows[row][col] = -1;
+	    }
+	}
+#endif
 	memset(_tdtRows[0], 0, (cols + 1) * sizeof(inputPixelType));
-	assert(_tdtRows[0]);
-	_tdtRows[1] = (inputPixelType *) malloc((cols + 1) * sizeof(inputPixelType));
-	assert(_tdtRows[1]);
 	memset(_tdtRows[1], 0, (cols + 1) * sizeof(inputPixelType));
 
+	_dtRowCount = dtRowCount;
 	_curRow = 1;	// Start at 1 to avoid computing the modulo of a negative integer
 	_outRow = _curRow;
 
 	_cols = cols;
 
-	for (int row = 0; row < _dtRowCount; row++) {
-	    _outputRows[row] = (outputPixelType *) malloc(cols * sizeof(outputPixelType));
-    #ifndef NDEBUG
-	    // Set all values to -1 to check later that each pixel is assigned a
-	    // value exactly once.
-	    // - assert pixel is -1 before setting a value
-	    // - assert pixel is not -1 before outputting and resetting it
-	    for (int col = 0; col < cols; col++) {
-		_outputRows[row][col] = -1;
-	    }
-    #endif
-	}
-
 	super::beginOfImage(cols, rows);
 
 	_inited = true;
@@ -106,15 +134,6 @@ protected:
 	_cols = 0;
 	_curRow = 0;
 	_dtRowCount = 0;
-	for (int row = 0; row < _dtRowCount; row++) {
-	    free(_outputRows[row]);
-	}
-	free(_outputRows);
-	_outputRows = NULL;
-	free(_tdtRows[0]);
-	free(_tdtRows[1]);
-	_tdtRows[0] = NULL;
-	_tdtRows[1] = NULL;
 
 	super::endOfImage();
     }
@@ -125,15 +144,36 @@ protected:
     int _curRow;
     int _outRow;
     int _dtRowCount;
+    /** Number of columns and rows of the allocated buffers. */
+    int _allocatedCols;
+    int _allocatedRows;
+    /** Debug check of the assignments of the output pixels. */
+    bool _checkAssignments;
     outputPixelType **_outputRows;
     inputPixelType *_tdtRows[2];
 };
 
-class BaseDistanceTransform: public ImageFilter<BinaryPixelType, GrayscalePixelType> {
+/**
+ * @return the maximal distance value \p dMax (0 for none) bounded by the
+ * maximal value of \p pixelType.
+ */
+template <typename pixelType>
+inline int boundedDMax(int dMax) {
+    return dMax == 0 ? grayscaleMax<pixelType>() : std::min(dMax, grayscaleMax<pixelType>());
+}
+
+/**
+ * @brief Base class of the translated distance transforms.
+ *
+ * The distance transform values are written as pixels of type
+ * \p outputPixelType (Grayscale8PixelType or Grayscale16PixelType).
+ */
+template <typename outputPixelType>
+class BaseDistanceTransform: public ImageFilter<BinaryPixelType, outputPixelType> {
 private:
-    typedef ImageFilter<BinaryPixelType, GrayscalePixelType> super;
+    typedef ImageFilter<BinaryPixelType, outputPixelType> super;
 public:
-    BaseDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer);
+    BaseDistanceTransform(ImageConsumer<outputPixelType>* consumer);
     ~BaseDistanceTransform();
 
     void beginOfImage(int cols, int rows);
@@ -144,13 +184,38 @@ protected:
 
     bool _inited;
     int _cols;
-    GrayscalePixelType* dtLines[3];
+    /** Number of columns of the allocated lines. */
+    int _allocatedCols;
+    outputPixelType* dtLines[3];
 };
 
+/**
+ * @brief Abstract factory of the filters of a distance, for distance
+ * transforms written as pixels of type \p outputPixelType.
+ */
+template <typename outputPixelType>
 class BaseDistance {
 public:
-    virtual BaseDistanceTransform* newTranslatedDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer) const = 0;
-    virtual DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType>* newDistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer) const = 0;
+    virtual ~BaseDistance() {}
+    virtual BaseDistanceTransform<outputPixelType>* newTranslatedDistanceTransform(ImageConsumer<outputPixelType>* consumer) const = 0;
+    virtual DistanceTransformUntranslator<outputPixelType, outputPixelType>* newDistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer) const = 0;
+    /**
+     * @brief create an ImageFilter that extracts the centers of maximal
+     * disks from the regular (centered) distance transform.
+     * @return an instance of MedialAxisExtractor.
+     */
+    virtual ImageFilter<outputPixelType, outputPixelType>* newMedialAxisExtractor(ImageConsumer<outputPixelType>* consumer) const = 0;
+    /**
+     * @brief create an ImageFilter that computes the union of the disks
+     * given by their radii (reverse distance transform).
+     * @return an instance of ReverseDistanceTransform.
+     */
+    virtual ImageFilter<outputPixelType, outputPixelType>* newReverseDistanceTransform(ImageConsumer<outputPixelType>* consumer) const = 0;
+    /**
+     * @return number of occurrences of 2 in the sequence of neighborhoods
+     * between indices 1 and \p r.
+     */
+    virtual int countOf2(int r) const = 0;
 };
 
 #endif
@@ -23,19 +23,39 @@
 #include <algorithm>
 
 #include "D4DistanceDT.h"
+#include "MedialAxis.h"
 
-D4Distance::D4Distance(GrayscalePixelType dMax) :
+template <typename outputPixelType>
+D4Distance<outputPixelType>::D4Distance(int dMax) :
     _dMax(dMax) { }
 
-BaseDistanceTransform* D4Distance::newTranslatedDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer) const {
-    return new D4DistanceTransform(consumer, _dMax);
+template <typename outputPixelType>
+BaseDistanceTransform<outputPixelType>* D4Distance<outputPixelType>::newTranslatedDistanceTransform(ImageConsumer<outputPixelType>* consumer) const {
+    return new D4DistanceTransform<outputPixelType>(consumer, _dMax);
 }
 
-DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType>* D4Distance::newDistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer) const {
-    return new D4DistanceTransformUntranslator(consumer, _dMax);
+template <typename outputPixelType>
+DistanceTransformUntranslator<outputPixelType, outputPixelType>* D4Distance<outputPixelType>::newDistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer) const {
+    return new D4DistanceTransformUntranslator<outputPixelType>(consumer, _dMax);
 }
 
-void D4DistanceTransform::processRow(const BinaryPixelType *imageRow) {
+template <typename outputPixelType>
+ImageFilter<outputPixelType, outputPixelType>* D4Distance<outputPixelType>::newMedialAxisExtractor(ImageConsumer<outputPixelType>* consumer) const {
+    return new MedialAxisExtractor<outputPixelType>(consumer, this, _dMax);
+}
+
+template <typename outputPixelType>
+ImageFilter<outputPixelType, outputPixelType>* D4Distance<outputPixelType>::newReverseDistanceTransform(ImageConsumer<outputPixelType>* consumer) const {
+    return new ReverseDistanceTransform<outputPixelType>(consumer, this, _dMax);
+}
+
+template <typename outputPixelType>
+int D4Distance<outputPixelType>::countOf2(int /*r*/) const {
+    return 0;
+}
+
+template <typename outputPixelType>
+void D4DistanceTransform<outputPixelType>::processRow(const BinaryPixelType *imageRow) {
     int col;
 #define N1_COUNT  4
     static vect n1[N1_COUNT]   = {{-1, 1}, {0, 1}, {1, 1}, {0, 2}};
@@ -44,7 +64,7 @@ void D4DistanceTransform::processRow(const BinaryPixelType *imageRow) {
 	if (imageRow[col] == 0)
 	    dtLines[0][col + 2] = 0;
 	else {
-	    GrayscalePixelType val;
+	    outputPixelType val;
 	    int k;
 
 	    // Ensure that the final output value is kept within the _dMax limit
@@ -64,17 +84,21 @@ void D4DistanceTransform::processRow(const BinaryPixelType *imageRow) {
     rotate();
 }
 
-D4DistanceTransform::D4DistanceTransform(ImageConsumer<GrayscalePixelType>* consumer, GrayscalePixelType dMax) :
-    _dMax(dMax == 0 ? GRAYSCALE_MAX : dMax),
-    BaseDistanceTransform(consumer) { }
+template <typename outputPixelType>
+D4DistanceTransform<outputPixelType>::D4DistanceTransform(ImageConsumer<outputPixelType>* consumer, int dMax) :
+    _dMax(boundedDMax<outputPixelType>(dMax)),
+    BaseDistanceTransform<outputPixelType>(consumer) { }
 
-D4DistanceTransformUntranslator::D4DistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer, GrayscalePixelType dMax) :
+template <typename outputPixelType>
+D4DistanceTransformUntranslator<outputPixelType>::D4DistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer, int dMax) :
     super(consumer, 0),
-    _dMax(dMax == 0 ? GRAYSCALE_MAX : dMax) { }
+    _dMax(boundedDMax<outputPixelType>(dMax)) { }
 
-D4DistanceTransformUntranslator::~D4DistanceTransformUntranslator() { }
+template <typename outputPixelType>
+D4DistanceTransformUntranslator<outputPixelType>::~D4DistanceTransformUntranslator() { }
 
-void D4DistanceTransformUntranslator::beginOfImage(int cols, int rows) {
+template <typename outputPixelType>
+void D4DistanceTransformUntranslator<outputPixelType>::beginOfImage(int cols, int rows) {
     int imageDMax = _dMax;
     imageDMax = std::min(imageDMax, (cols + 1) / 2);
     imageDMax = std::min(imageDMax, (rows + 1) / 2);
@@ -83,7 +107,8 @@ void D4DistanceTransformUntranslator::beginOfImage(int cols, int rows) {
 
 // Called once for each row of the input image, plus one extra time
 // with null-valued translated DT to flush all DT values
-void D4DistanceTransformUntranslator::processRow(const GrayscalePixelType* inputRow) {
+template <typename outputPixelType>
+void D4DistanceTransformUntranslator<outputPixelType>::processRow(const outputPixelType* inputRow) {
     int dtmax = 1;  // Not 0 to avoid outputing the extra row
 
     super::processRow(inputRow);
@@ -95,7 +120,7 @@ void D4DistanceTransformUntranslator::processRow(const GrayscalePixelType* input
 
 	dtp = _tdtRows[1][col];
 	if (_tdtRows[0][col] == 0) {
-	    assert(_outputRows[(_curRow + _dtRowCount) % _dtRowCount][col] == (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[(_curRow + _dtRowCount) % _dtRowCount][col] == (outputPixelType) -1);
 	    _outputRows[(_curRow + _dtRowCount) % _dtRowCount][col] = 0;
 	}
 
@@ -110,7 +135,7 @@ void D4DistanceTransformUntranslator::processRow(const GrayscalePixelType* input
 
 	    dy = r - 1;
 	    assert(_curRow - 1 - dy >= 0);
-	    assert(_outputRows[(_curRow - 1 - dy) % _dtRowCount][col] == (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[(_curRow - 1 - dy) % _dtRowCount][col] == (outputPixelType) -1);
 	    _outputRows[(_curRow - 1 - dy) % _dtRowCount][col] = r;
 	}
     }
@@ -119,10 +144,16 @@ void D4DistanceTransformUntranslator::processRow(const GrayscalePixelType* input
 	_consumer->processRow(_outputRows[_outRow % _dtRowCount]);
 #ifndef NDEBUG
 	for (int col = 0; col < _cols; col++) {
-	    assert(_outputRows[_outRow % _dtRowCount][col] != (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[_outRow % _dtRowCount][col] != (outputPixelType) -1);
 	    _outputRows[_outRow % _dtRowCount][col] = -1;
 	}
 #endif
     }
 }
 
+template class D4Distance<Grayscale8PixelType>;
+template class D4Distance<Grayscale16PixelType>;
+template class D4DistanceTransform<Grayscale8PixelType>;
+template class D4DistanceTransform<Grayscale16PixelType>;
+template class D4DistanceTransformUntranslator<Grayscale8PixelType>;
+template class D4DistanceTransformUntranslator<Grayscale16PixelType>;
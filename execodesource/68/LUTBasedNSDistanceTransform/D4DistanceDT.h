@@ -36,29 +36,46 @@
  * D4Distance is a concrete factory for filters related to the city-block
  * distance: D4DistanceTransform and D4DistanceTransformUntranslator.
  */
-class D4Distance: public BaseDistance {
+template <typename outputPixelType>
+class D4Distance: public BaseDistance<outputPixelType> {
 public:
     /**
      * @param dMax maximal value of the distance transform. This value is
      * passed to the D4DistanceTransform and D4DistanceTransformUntranslator
      * constructors.
      */
-    D4Distance(GrayscalePixelType dMax = 0);
+    D4Distance(int dMax = 0);
     /**
      * @brief create a distance transform ImageFilter for the translated
      * @f$d_4@f$ distance.
      * @return an instance of D4DistanceTransform.
      */
-    BaseDistanceTransform* newTranslatedDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer) const;
+    BaseDistanceTransform<outputPixelType>* newTranslatedDistanceTransform(ImageConsumer<outputPixelType>* consumer) const;
     /**
      * @brief create an ImageFilter to recenter translated @f$d_4@f$
      * distance transforms.
      * @return an instance of D4DistanceTransformUntranslator.
      */
-    DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType>* newDistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer) const;
+    DistanceTransformUntranslator<outputPixelType, outputPixelType>* newDistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer) const;
+    /**
+     * @brief create an ImageFilter that extracts the centers of maximal
+     * disks from the regular distance transform.
+     * @return an instance of MedialAxisExtractor.
+     */
+    ImageFilter<outputPixelType, outputPixelType>* newMedialAxisExtractor(ImageConsumer<outputPixelType>* consumer) const;
+    /**
+     * @brief create an ImageFilter that computes the union of the disks
+     * given by their radii.
+     * @return an instance of ReverseDistanceTransform.
+     */
+    ImageFilter<outputPixelType, outputPixelType>* newReverseDistanceTransform(ImageConsumer<outputPixelType>* consumer) const;
+    /**
+     * @return 0: @f$d_4@f$ only uses neighborhood 1.
+     */
+    int countOf2(int r) const;
 
 protected:
-    const GrayscalePixelType _dMax;
+    const int _dMax;
 };
 
 /**
@@ -69,7 +86,8 @@ protected:
  * time by processRow(). The result image is written in the next consumer in
  * the filter chain.
  */
-class D4DistanceTransform: public BaseDistanceTransform {
+template <typename outputPixelType>
+class D4DistanceTransform: public BaseDistanceTransform<outputPixelType> {
 public:
     /**
      * @brief Construct a D4DistanceTransform.
@@ -77,9 +95,9 @@ public:
      * @param consumer the next consumer in the filter chain.
      * @param dMax maximal value of the distance transform. Output distance
      * values are saturated to this value. When \p dMax is 0, the distance
-     * is bounded by #GRAYSCALE_MAX.
+     * is bounded by the maximal value of \p outputPixelType.
      */
-    D4DistanceTransform(ImageConsumer<GrayscalePixelType>* consumer, GrayscalePixelType dMax = 0);
+    D4DistanceTransform(ImageConsumer<outputPixelType>* consumer, int dMax = 0);
 
     /**
      * @brief Process one row of image.
@@ -110,11 +128,15 @@ public:
     void processRow(const BinaryPixelType *imageRow);
 
 protected:
+    using BaseDistanceTransform<outputPixelType>::_consumer;
+    using BaseDistanceTransform<outputPixelType>::_cols;
+    using BaseDistanceTransform<outputPixelType>::dtLines;
+    using BaseDistanceTransform<outputPixelType>::rotate;
     /**
      * Upper bound of the distance transform value (output distance values
      * are saturated to this value).
      */
-    const GrayscalePixelType _dMax;
+    const outputPixelType _dMax;
 };
 
 /** @brief @f$d_4@f$ distance transform untranslator.
@@ -124,7 +146,8 @@ protected:
  * time by processRow(). The result image is written in the next consumer in
  * the filter chain.
  */
-class D4DistanceTransformUntranslator: public DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType> {
+template <typename outputPixelType>
+class D4DistanceTransformUntranslator: public DistanceTransformUntranslator<outputPixelType, outputPixelType> {
 public:
     /**
      * @brief Construct a D4DistanceTransformUntranslator.
@@ -132,27 +155,35 @@ public:
      * @param consumer the next consumer in the filter chain.
      * @param dMax maximal value of the distance transform. Input distance
      * values are assumed never to exceed this value. When \p dMax is 0, the
-     * distance is only bounded by #GRAYSCALE_MAX.
+     * distance is only bounded by the maximal value of \p outputPixelType.
      *
      * The algorithm latency (and the number of rows that have to be stored)
      * directly depends on the maximal value of the distance transform.
      * Forcing a lower value sets an upper bound on the latency and reduces
      * the allocated memory.
      */
-    D4DistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer, GrayscalePixelType dMax = 0);
+    D4DistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer, int dMax = 0);
     ~D4DistanceTransformUntranslator();
 
     void beginOfImage(int cols, int rows);
-    void processRow(const GrayscalePixelType* inputRow);
+    void processRow(const outputPixelType* inputRow);
 
 protected:
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_consumer;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_cols;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_curRow;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_outRow;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_dtRowCount;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_outputRows;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_tdtRows;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_checkAssignments;
     /**
      * Upper bound of the distance transform value (input distance values
      * are assumed never to exceed #_dMax).
      */
-    const GrayscalePixelType _dMax;
+    const outputPixelType _dMax;
 
 private:
-    typedef DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType> super;
+    typedef DistanceTransformUntranslator<outputPixelType, outputPixelType> super;
 };
 
@@ -23,19 +23,39 @@
 #include <algorithm>
 
 #include "D8DistanceDT.h"
+#include "MedialAxis.h"
 
-D8Distance::D8Distance(GrayscalePixelType dMax) :
+template <typename outputPixelType>
+D8Distance<outputPixelType>::D8Distance(int dMax) :
     _dMax(dMax) { }
 
-BaseDistanceTransform* D8Distance::newTranslatedDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer) const {
-    return new D8DistanceTransform(consumer, _dMax);
+template <typename outputPixelType>
+BaseDistanceTransform<outputPixelType>* D8Distance<outputPixelType>::newTranslatedDistanceTransform(ImageConsumer<outputPixelType>* consumer) const {
+    return new D8DistanceTransform<outputPixelType>(consumer, _dMax);
 }
 
-DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType>* D8Distance::newDistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer) const {
-    return new D8DistanceTransformUntranslator(consumer, _dMax);
+template <typename outputPixelType>
+DistanceTransformUntranslator<outputPixelType, outputPixelType>* D8Distance<outputPixelType>::newDistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer) const {
+    return new D8DistanceTransformUntranslator<outputPixelType>(consumer, _dMax);
 }
 
-void D8DistanceTransform::processRow(const BinaryPixelType *imageRow) {
+template <typename outputPixelType>
+ImageFilter<outputPixelType, outputPixelType>* D8Distance<outputPixelType>::newMedialAxisExtractor(ImageConsumer<outputPixelType>* consumer) const {
+    return new MedialAxisExtractor<outputPixelType>(consumer, this, _dMax);
+}
+
+template <typename outputPixelType>
+ImageFilter<outputPixelType, outputPixelType>* D8Distance<outputPixelType>::newReverseDistanceTransform(ImageConsumer<outputPixelType>* consumer) const {
+    return new ReverseDistanceTransform<outputPixelType>(consumer, this, _dMax);
+}
+
+template <typename outputPixelType>
+int D8Distance<outputPixelType>::countOf2(int r) const {
+    return r;
+}
+
+template <typename outputPixelType>
+void D8DistanceTransform<outputPixelType>::processRow(const BinaryPixelType *imageRow) {
     int col;
 #define N2_COUNT  8
     static vect n2[N2_COUNT]   = {{1, 0}, {2, 0}, {2, 1}, {1, 2}, {2, 2}, {0, 1}, {1, 1}, {0, 2}};
@@ -44,7 +64,7 @@ void D8DistanceTransform::processRow(const BinaryPixelType *imageRow) {
 	if (imageRow[col] == 0)
 	    dtLines[0][col + 2] = 0;
 	else {
-	    GrayscalePixelType val;
+	    outputPixelType val;
 	    int k;
 
 	    // Ensure that the final output value is kept within the _dMax limit
@@ -64,17 +84,21 @@ void D8DistanceTransform::processRow(const BinaryPixelType *imageRow) {
     rotate();
 }
 
-D8DistanceTransform::D8DistanceTransform(ImageConsumer<GrayscalePixelType>* consumer, GrayscalePixelType dMax) :
-    _dMax(dMax == 0 ? GRAYSCALE_MAX : dMax),
-    BaseDistanceTransform(consumer) { }
+template <typename outputPixelType>
+D8DistanceTransform<outputPixelType>::D8DistanceTransform(ImageConsumer<outputPixelType>* consumer, int dMax) :
+    _dMax(boundedDMax<outputPixelType>(dMax)),
+    BaseDistanceTransform<outputPixelType>(consumer) { }
 
-D8DistanceTransformUntranslator::D8DistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer, GrayscalePixelType dMax) :
+template <typename outputPixelType>
+D8DistanceTransformUntranslator<outputPixelType>::D8DistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer, int dMax) :
     super(consumer, 1),
-    _dMax(dMax == 0 ? GRAYSCALE_MAX : dMax) { }
+    _dMax(boundedDMax<outputPixelType>(dMax)) { }
 
-D8DistanceTransformUntranslator::~D8DistanceTransformUntranslator() { }
+template <typename outputPixelType>
+D8DistanceTransformUntranslator<outputPixelType>::~D8DistanceTransformUntranslator() { }
 
-void D8DistanceTransformUntranslator::beginOfImage(int cols, int rows) {
+template <typename outputPixelType>
+void D8DistanceTransformUntranslator<outputPixelType>::beginOfImage(int cols, int rows) {
     int imageDMax = _dMax;
     imageDMax = std::min(imageDMax, (cols + 1) / 2);
     imageDMax = std::min(imageDMax, (rows + 1) / 2);
@@ -83,7 +107,8 @@ void D8DistanceTransformUntranslator::beginOfImage(int cols, int rows) {
 
 // Called once for each row of the input image, plus one extra time
 // with null-valued translated DT to flush all DT values
-void D8DistanceTransformUntranslator::processRow(const GrayscalePixelType* inputRow) {
+template <typename outputPixelType>
+void D8DistanceTransformUntranslator<outputPixelType>::processRow(const outputPixelType* inputRow) {
     int dtmax = 1;  // Not 0 to avoid outputing the extra row
 
     super::processRow(inputRow);
@@ -95,7 +120,7 @@ void D8DistanceTransformUntranslator::processRow(const GrayscalePixelType* input
 
 	dtp = _tdtRows[1][col];
 	if (_tdtRows[0][col] == 0) {
-	    assert(_outputRows[(_curRow + _dtRowCount) % _dtRowCount][col] == (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[(_curRow + _dtRowCount) % _dtRowCount][col] == (outputPixelType) -1);
 	    _outputRows[(_curRow + _dtRowCount) % _dtRowCount][col] = 0;
 	}
 
@@ -111,7 +136,7 @@ void D8DistanceTransformUntranslator::processRow(const GrayscalePixelType* input
 
 	    dy = r - 1;
 	    assert(_curRow - 1 - dy >= 0);
-	    assert(_outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] == (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] == (outputPixelType) -1);
 	    _outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] = r;
 	    dx++;
 	}
@@ -121,10 +146,16 @@ void D8DistanceTransformUntranslator::processRow(const GrayscalePixelType* input
 	_consumer->processRow(_outputRows[_outRow % _dtRowCount]);
 #ifndef NDEBUG
 	for (int col = 0; col < _cols; col++) {
-	    assert(_outputRows[_outRow % _dtRowCount][col] != (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[_outRow % _dtRowCount][col] != (outputPixelType) -1);
 	    _outputRows[_outRow % _dtRowCount][col] = -1;
 	}
 #endif
     }
 }
 
+template class D8Distance<Grayscale8PixelType>;
+template class D8Distance<Grayscale16PixelType>;
+template class D8DistanceTransform<Grayscale8PixelType>;
+template class D8DistanceTransform<Grayscale16PixelType>;
+template class D8DistanceTransformUntranslator<Grayscale8PixelType>;
+template class D8DistanceTransformUntranslator<Grayscale16PixelType>;
@@ -53,6 +53,8 @@ void freerow(void *);
 template <typename inputPixelType>
 class ImageConsumer {
 public:
+    virtual ~ImageConsumer() {}
+
     /**
      * Called by a producer to provide a row of pixels to this image
      * consumer.
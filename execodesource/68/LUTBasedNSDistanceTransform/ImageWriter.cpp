@@ -34,7 +34,8 @@ bool checkFormat(char const *fromname, char const *format) {
 	   (fromname[l] == '\0' || fromname[l] == ':');
 }
 
-ImageConsumer<GrayscalePixelType> *createImageWriter(char const *filename, char const *format, bool lineBuffered) {
+template <typename outputPixelType>
+ImageConsumer<outputPixelType> *createImageWriter(char const *filename, char const *format, bool lineBuffered) {
     FILE *output = NULL;
 
     if (format == NULL) {
@@ -63,14 +64,19 @@ ImageConsumer<GrayscalePixelType> *createImageWriter(char const *filename, char
 	    format++;
     }
 
+    return createImageStreamWriter<outputPixelType>(output, format, lineBuffered);
+}
+
+template <typename outputPixelType>
+ImageConsumer<outputPixelType> *createImageStreamWriter(FILE *output, char const *format, bool lineBuffered) {
 #ifdef WITH_NETPBM
     if (checkFormat(format, "pgm")) {
-	return new PGMImageWriter(output, 1);
+	return new PGMImageWriter<outputPixelType>(output, 1);
     }
 #endif
 #ifdef WITH_PNG
     if (checkFormat(format, "png")) {
-	return new PNGImageWriter(output, lineBuffered);
+	return new PNGImageWriter<outputPixelType>(output, lineBuffered);
     }
 #endif
 
@@ -81,12 +87,18 @@ ImageConsumer<GrayscalePixelType> *createImageWriter(char const *filename, char
 
     // No format specified, use default
 #ifdef WITH_NETPBM
-    return new PGMImageWriter(output);
+    return new PGMImageWriter<outputPixelType>(output);
 #else
 #   ifdef WITH_PNG
-    return new PNGImageWriter(output);
+    return new PNGImageWriter<outputPixelType>(output);
 #   endif
 #endif
 
     return NULL;
 }
+
+template ImageConsumer<Grayscale8PixelType> *createImageWriter<Grayscale8PixelType>(char const *, char const *, bool);
+template ImageConsumer<Grayscale16PixelType> *createImageWriter<Grayscale16PixelType>(char const *, char const *, bool);
+
+template ImageConsumer<Grayscale8PixelType> *createImageStreamWriter<Grayscale8PixelType>(FILE *, char const *, bool);
+template ImageConsumer<Grayscale16PixelType> *createImageStreamWriter<Grayscale16PixelType>(FILE *, char const *, bool);
@@ -32,4 +32,16 @@
 #   include "PNGImageWriter.h"
 #endif
 
-ImageConsumer<GrayscalePixelType>* createImageWriter(char const *filename = NULL, char const *format = NULL, bool lineBuffered=false);
+/**
+ * Create an image writer of the given format for pixels of type
+ * \p outputPixelType (Grayscale8PixelType or Grayscale16PixelType).
+ */
+template <typename outputPixelType>
+ImageConsumer<outputPixelType>* createImageWriter(char const *filename = NULL, char const *format = NULL, bool lineBuffered=false);
+
+/**
+ * Create an image writer of the given format (pgm or png, NULL for the
+ * default one) on an open stream. The stream is not closed by the writer.
+ */
+template <typename outputPixelType>
+ImageConsumer<outputPixelType>* createImageStreamWriter(FILE *output, char const *format = NULL, bool lineBuffered=false);
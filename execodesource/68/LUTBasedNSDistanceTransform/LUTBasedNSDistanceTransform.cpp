@@ -63,95 +63,16 @@
 
 #include "ImageReader.h"
 
-#include "BaseDistanceDT.h"
-#include "D4DistanceDT.h"
-#include "D8DistanceDT.h"
-#include "RatioNSDistanceDT.h"
-#include "PeriodicNSDistanceDT.h"
+#include "NSDistanceTransform.h"
 
 #include "ImageWriter.h"
 
 void usage() __attribute__ ((noreturn));
 
-int parseRate(char* string, int *num, int *den) {
-    char *startptr = string;
-    char *endptr;
-
-    *num = strtol(startptr, &endptr, 0);
-    if (startptr == endptr) {
-	fprintf(stderr, "Invalid sequence \"%s\"\n", endptr);
-	return 0;
-    }
-    // Swallow space characters
-    while (isspace(endptr[0]))
-	endptr++;
-    if (*endptr != '/') {
-	fprintf(stderr, "Invalid sequence \"%s\"\n", endptr);
-	return 0;
-    }
-    startptr = endptr + 1;
-    *den = strtol(startptr, &endptr, 0);
-    if (startptr == endptr) {
-	fprintf(stderr, "Invalid sequence \"%s\"\n", endptr);
-	return 0;
-    }
-
-    return 1;
-}
-
-int parseSequence(char* string, int *period, int **points) {
-    char *startptr = string;
-    char *endptr;
-    int count = 0;
-
-    // 1st pass: dry run, count integers
-    do {
-	//printf("Now parsing \"%s\"\n", startptr);
-	int x = strtol(startptr, &endptr, 0);
-	// Swallow space characters
-	while (isspace(endptr[0]))
-	    endptr++;
-	if (startptr == endptr || x < 1 || x > 2) {
-	    //if (endptr[0] != '\0' && endptr[0] != ',' )
-	    {
-		fprintf(stderr, "Invalid sequence \"%s\"\n", endptr);
-		usage();
-	    }
-	}
-	//printf("%d [%d-%d[ ", x, startptr-string, endptr-string);
-	if (endptr[0] == ',')
-	    endptr++;
-	startptr = endptr;
-	count++;
-    } while (startptr[0] != '\0');
-    //printf("\n");
-
-    assert(points > 0);
-
-    *points = (int *)malloc(count * sizeof(int));
-    count = 0;
-
-    startptr = string;
-    do {
-	int x = strtol(startptr, &endptr, 0);
-	// Swallow space characters
-	while (isspace(endptr[0]))
-	    endptr++;
-	if (endptr[0] == ',')
-	    endptr++;
-	startptr = endptr;
-	(*points)[count++] = x;
-    } while (startptr[0] != '\0');
-
-    *period = count;
-
-    return 1;
-}
-
 void usage() {
     fprintf(stderr,
 	    //-----------------------------------------------------------------------------//
-	    "Usage: LUTBasedNSDistanceTransform [-f filename] [-c] (-4|-8|-r <num/den>|-s <sequence>) [-t (pgm|png)]\n"
+	    "Usage: LUTBasedNSDistanceTransform [-f filename] [-c|-a|-i] (-4|-8|-r <num/den>|-s <sequence>) [-t (pgm|png)] [-w (8|16)]\n"
 	    "\n"
 	    "LUTBasedNSDistanceTransform computes the 2D translated neighborhood-sequence\n"
 	    "distance transform of a binary image. It reads the input images from its\n"
@@ -167,10 +88,18 @@ void usage() {
 	    "                (with den >= num >= 0 and den > 0).\n"
 	    "  -c            Center the distance transform (the default is an asymmetric\n"
 	    "                distance transform).\n"
+	    "  -a            Output the medial axis: the centered distance transform values\n"
+	    "                of the centers of maximal disks, 0 elsewhere.\n"
+	    "  -i            Output the union of the disks of the medial axis (reverse\n"
+	    "                distance transform), 1 in the set, 0 elsewhere.\n"
 	    "  -m value      Set the maximal value of the distance.\n"
 	    "  -f filename   Read from file \"filename\" instead of stdin.\n"
 	    "  -l            Flush output after each produced row.\n"
 	    "  -t format     Select output image format (pgm or png).\n"
+	    "  -w width      Force the pixel width of the distance transform (8 or 16\n"
+	    "                bits). Distance values are saturated to the largest value of\n"
+	    "                this width. By default, 8 bits are used for images up to 510\n"
+	    "                pixels wide or high, 16 bits for larger ones.\n"
 	    "\n"
 	    "Examples:\n"
 	    "  Translated octagonal distance transform:\n"
@@ -185,22 +114,47 @@ void usage() {
 	    "  d8 distance transform:\n"
 	    "    \"./LUTBasedNSDistanceTransform -r 1/1 -c < image.pbm\" or\n"
 	    "    \"./LUTBasedNSDistanceTransform -s '2' -c < image.pbm\"\n"
+	    "  Octagonal medial axis:\n"
+	    "    \"./LUTBasedNSDistanceTransform -r 1/2 -a < image.pbm\"\n"
 	    //-----------------------------------------------------------------------------//
 	    );
     exit(-1);
 }
 
-typedef enum {
-    undefined,
-    d4,
-    d8,
-    ratioDefined,
-    sequenceDefined
-} DistanceType;
-
 #define PBM_FILE_FORMAT	1
 #define PNG_FILE_FORMAT	2
 
+/**
+ * @brief Build the filter chain of one pixel width, from the translated
+ * distance transform to the image writer.
+ *
+ * @param dist the distance, used by the filters while they exist.
+ * @return the first filter of the chain.
+ */
+template <typename outputPixelType>
+ImageConsumer<BinaryPixelType> *createChain(const BaseDistance<outputPixelType> *dist,
+					    const char *outputFormat, bool lineBuffered,
+					    int translateFlag, int medialAxisFlag, int reverseFlag) {
+    ImageConsumer<outputPixelType> *output = createImageWriter<outputPixelType>("-", outputFormat, lineBuffered);
+    if (output == NULL) {
+	fprintf(stderr, "Unable to create image output stream (wrong format?)\n");
+    }
+
+    // TODO: check that the image consumers are deleted
+    // The medial axis and the reverse distance transform follow the
+    // centered distance transform in the same pass
+    if (reverseFlag) {
+	output = dist->newReverseDistanceTransform(output);
+    }
+    if (medialAxisFlag || reverseFlag) {
+	output = dist->newMedialAxisExtractor(output);
+    }
+    if (translateFlag || medialAxisFlag || reverseFlag) {
+	output = dist->newDistanceTransformUntranslator(output);
+    }
+    return dist->newTranslatedDistanceTransform(output);
+}
+
 int main(int argc, char** argv) {
     //int row;
     FILE *input = stdin;
@@ -208,16 +162,20 @@ int main(int argc, char** argv) {
     DistanceType type = undefined;
     char *spec = NULL;
     int translateFlag = 0;
+    int medialAxisFlag = 0;
+    int reverseFlag = 0;
     char *myName = argv[0];
     char *outputFormat = NULL;
     bool lineBuffered = false;
     int dMax = 0;
-    BaseDistance *dist = NULL;
+    int width = 0;
+    BaseDistance<Grayscale8PixelType> *dist8 = NULL;
+    BaseDistance<Grayscale16PixelType> *dist16 = NULL;
 
     int ch;
 
     optind = 1;
-    while ((ch = getopt(argc, argv, "m:t:f:48r:s:cl")) != -1) {
+    while ((ch = getopt(argc, argv, "m:t:f:48r:s:claiw:")) != -1) {
 	switch (ch) {
 	    case '4':
 		if (type != undefined) {
@@ -252,21 +210,30 @@ int main(int argc, char** argv) {
 	    case 'l':
 		lineBuffered = true;
 		break;
-	    case 'm':
+	    case 'm': {
 		char *endPtr;
-		dMax = strtol(optarg, &endPtr, 10);
+		long value = strtol(optarg, &endPtr, 10);
 		if (*endPtr != '\0') {
 		    fprintf(stderr, "Unable to parse maximal value \"%s\"\n", optarg);
 		    exit(-1);
 		}
-		if (dMax < 0) {
+		if (value < 0) {
 		    fprintf(stderr, "The maximal distance value cannot be negative.\n");
 		    exit(-1);
 		}
-		if (dMax > GRAYSCALE_MAX) {
+		if (value > GRAYSCALE_MAX) {
 		    fprintf(stderr, "The maximal distance value cannot exceed %d.\n", GRAYSCALE_MAX);
 		    exit(-1);
 		}
+		dMax = value;
+		break;
+	    }
+	    case 'w':
+		width = atoi(optarg);
+		if (width != 8 && width != 16) {
+		    fprintf(stderr, "Invalid pixel width \"%s\" (8 or 16)\n", optarg);
+		    exit(-1);
+		}
 		break;
 	    case 't':
 		outputFormat = optarg;
@@ -274,6 +241,12 @@ int main(int argc, char** argv) {
 	    case 'c':
 		translateFlag = 1;
 		break;
+	    case 'a':
+		medialAxisFlag = 1;
+		break;
+	    case 'i':
+		reverseFlag = 1;
+		break;
 	    case 'f':
 		if ((input = fopen(optarg, "r")) == NULL) {
 		    fprintf(stderr, "%s (%s line %d): %s: %s\n", myName, __FILE__, __LINE__, optarg, strerror(errno));
@@ -297,78 +270,22 @@ int main(int argc, char** argv) {
 	exit(-1);
     }
 
-    switch (type) {
-	case d4:
-	    dist = new D4Distance(dMax);
-	    break;
-	case d8:
-	    dist = new D8Distance(dMax);
-	    break;
-	case ratioDefined: {
-	    int num, den;
-	    if (!parseRate(spec, &num, &den)) {
-		fprintf(stderr, "Unable to parse num/den \"%s\"\n", argv[0]);
-		exit(-1);
-	    }
-	    if (num < 0 || den < num || den <= 0) {
-		fprintf(stderr,
-			"Invalid ratio %d/%d\n"
-			"correct ratios num/den are such that den >= num >= 0 and den > 0\n",
-			num, den);
-		exit(-1);
-	    }
-	    if (num == 0) {
-		dist = new D4Distance(dMax);
-	    }
-	    else if (num == den) {
-		dist = new D8Distance(dMax);
-	    }
-	    else {
-		dist = new RatioNSDistance(num, den, dMax);
-	    }
-	}
-	    break;
-	case sequenceDefined: {
-	    int period = 0; int *sequence = NULL;
-
-	    if (!parseSequence(spec, &period, &sequence)) {
-		fprintf(stderr, "Unable to parse sequence \"%s\"\n", argv[0]);
-		exit(-1);
-	    }
-	    int countOfNeighbors[2] = {0, 0};
-	    int i;
-	    for (i = 0; i < period; i++) {
-		countOfNeighbors[sequence[i] - 1]++;
-	    }
-	    if (countOfNeighbors[0] == 0) {
-		// d8
-		dist = new D8Distance(dMax);
-	    }
-	    else if (countOfNeighbors[1] == 0) {
-		// d4
-		dist = new D4Distance(dMax);
-	    }
-	    else {
-		dist = new PeriodicNSDistance(period, sequence, dMax);
-	    }		
-	    free(sequence);
-	    sequence = NULL;
-	}
-	    break;
-    }
-
-    ImageConsumer<GrayscalePixelType> *output = createImageWriter("-", outputFormat, lineBuffered);
-    if (output == NULL) {
-	fprintf(stderr, "Unable to create image output stream (wrong format?)\n");
-    }
-
     //pm_init(myName, 0);
 
-    // TODO: check that the image consumers are deleted
-    if (translateFlag) {
-	output = dist->newDistanceTransformUntranslator(output);
+    // One filter chain per pixel width that may be selected
+    ImageConsumer<BinaryPixelType> *chain8 = NULL;
+    ImageConsumer<BinaryPixelType> *chain16 = NULL;
+    if (width == 0 || width == 8) {
+	if ((dist8 = createDistance<Grayscale8PixelType>(type, spec, dMax)) == NULL)
+	    exit(-1);
+	chain8 = createChain(dist8, outputFormat, lineBuffered, translateFlag, medialAxisFlag, reverseFlag);
+    }
+    if (width == 0 || width == 16) {
+	if ((dist16 = createDistance<Grayscale16PixelType>(type, spec, dMax)) == NULL)
+	    exit(-1);
+	chain16 = createChain(dist16, outputFormat, lineBuffered, translateFlag, medialAxisFlag, reverseFlag);
     }
-    BaseDistanceTransform *dt = dist->newTranslatedDistanceTransform(output);
+    ImageConsumer<BinaryPixelType> *dt = new PixelWidthSelector(chain8, chain16, dMax, width);
 
 #ifdef WITH_NETPBM
     if (inputFormat == 0) {
@@ -425,6 +342,9 @@ int main(int argc, char** argv) {
     if (dt != NULL) {
 	delete dt;
     }
+    // The filters may refer to the distances
+    delete dist8;
+    delete dist16;
 
     fclose(input);
     return 0;
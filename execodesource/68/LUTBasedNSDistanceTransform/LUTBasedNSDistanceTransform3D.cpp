@@ -0,0 +1,173 @@
+// This file is part of LUTBasedNSDistanceTransform.
+//
+// LUTBasedNSDistanceTransform is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// LUTBasedNSDistanceTransform is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// LUTBasedNSDistanceTransform.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+ * @file LUTBasedNSDistanceTransform3D.cpp
+ *
+ * @brief Command line tool for the streaming 3D neighborhood-sequence
+ * distance transform of raw volumes.
+ *
+ * This file is part of LUTBasedNSDistanceTransform.
+ */
+
+#include <assert.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/errno.h>
+
+#include "NSDistanceTransform.h"
+#include "NSDistanceTransform3D.h"
+
+void usage() __attribute__ ((noreturn));
+
+void usage() {
+    fprintf(stderr,
+	    //-----------------------------------------------------------------------------//
+	    "Usage: LUTBasedNSDistanceTransform3D -x cols -y rows -z slices -s <sequence> [-m value] [-f filename]\n"
+	    "\n"
+	    "LUTBasedNSDistanceTransform3D computes the 3D neighborhood-sequence distance\n"
+	    "transform of a binary volume. It reads the raw volume (one byte per voxel,\n"
+	    "0 for the background, slice after slice) from its standard input and writes\n"
+	    "the raw distance transform (unsigned 16-bit native integers) to its standard\n"
+	    "output. Slices are written as soon as they are final; only a number of\n"
+	    "slices proportional to the maximal distance is kept in memory.\n"
+	    "\n"
+	    "Options\n"
+	    "  -x cols       Width of the volume.\n"
+	    "  -y rows       Height of the volume.\n"
+	    "  -z slices     Depth of the volume.\n"
+	    "  -s sequence   One period of the sequence of neighborhoods given as a list of\n"
+	    "                1 (6-neighborhood), 2 (18-neighborhood) and 3 (26-neighborhood)\n"
+	    "                separated by \" \" or \",\".\n"
+	    "  -m value      Set the maximal value of the distance.\n"
+	    "  -f filename   Read from file \"filename\" instead of stdin.\n"
+	    "\n"
+	    "Example:\n"
+	    "    \"./LUTBasedNSDistanceTransform3D -x 256 -y 256 -z 400 -s '1 3' < ct.raw > dt.raw\"\n"
+	    //-----------------------------------------------------------------------------//
+	    );
+    exit(-1);
+}
+
+/**
+ * @brief VolumeConsumer that writes raw slices to a stream.
+ */
+class RawVolumeWriter: public VolumeConsumer<GrayscalePixelType> {
+public:
+    RawVolumeWriter(FILE *output) : _output(output), _sliceSize(0) {}
+
+    void beginOfVolume(int cols, int rows, int /*slices*/) {
+	_sliceSize = (size_t) cols * rows;
+    }
+    void processSlice(const GrayscalePixelType *inputSlice) {
+	if (fwrite(inputSlice, sizeof(GrayscalePixelType), _sliceSize, _output) != _sliceSize) {
+	    fprintf(stderr, "Unable to write slice: %s\n", strerror(errno));
+	    exit(-1);
+	}
+    }
+    void endOfVolume() {
+	fflush(_output);
+    }
+
+private:
+    FILE *_output;
+    size_t _sliceSize;
+};
+
+int parseDimension(const char *string) {
+    char *endPtr;
+    int value = strtol(string, &endPtr, 10);
+    if (*endPtr != '\0' || value <= 0) {
+	fprintf(stderr, "Invalid dimension \"%s\"\n", string);
+	exit(-1);
+    }
+    return value;
+}
+
+int main(int argc, char** argv) {
+    FILE *input = stdin;
+    char *myName = argv[0];
+    int cols = 0, rows = 0, slices = 0;
+    char *spec = NULL;
+    int dMax = 0;
+
+    int ch;
+
+    while ((ch = getopt(argc, argv, "x:y:z:s:m:f:")) != -1) {
+	switch (ch) {
+	    case 'x':
+		cols = parseDimension(optarg);
+		break;
+	    case 'y':
+		rows = parseDimension(optarg);
+		break;
+	    case 'z':
+		slices = parseDimension(optarg);
+		break;
+	    case 's':
+		spec = optarg;
+		break;
+	    case 'm':
+		char *endPtr;
+		dMax = strtol(optarg, &endPtr, 10);
+		if (*endPtr != '\0' || dMax < 0 || dMax > GRAYSCALE_MAX) {
+		    fprintf(stderr, "Invalid maximal value \"%s\"\n", optarg);
+		    exit(-1);
+		}
+		break;
+	    case 'f':
+		if ((input = fopen(optarg, "r")) == NULL) {
+		    fprintf(stderr, "%s (%s line %d): %s: %s\n", myName, __FILE__, __LINE__, optarg, strerror(errno));
+		    exit(-1);
+		}
+		break;
+ 	    default:
+		usage();
+	}
+    }
+    argc -= optind;
+
+    if (argc != 0 || cols == 0 || rows == 0 || slices == 0 || spec == NULL)
+	usage();
+
+    int period = 0; int *sequence = NULL;
+    if (!parseSequence(spec, &period, &sequence, 3)) {
+	fprintf(stderr, "Unable to parse sequence \"%s\"\n", spec);
+	exit(-1);
+    }
+
+    NSDistanceTransform3D dt(new RawVolumeWriter(stdout), period, sequence, dMax);
+    free(sequence);
+
+    size_t sliceSize = (size_t) cols * rows;
+    BinaryPixelType *slice = (BinaryPixelType *) malloc(sliceSize * sizeof(BinaryPixelType));
+    assert(slice);
+
+    dt.beginOfVolume(cols, rows, slices);
+    for (int z = 0; z < slices; z++) {
+	if (fread(slice, sizeof(BinaryPixelType), sliceSize, input) != sliceSize) {
+	    fprintf(stderr, "Unexpected end of volume at slice %d\n", z);
+	    exit(-1);
+	}
+	dt.processSlice(slice);
+    }
+    dt.endOfVolume();
+
+    free(slice);
+    fclose(input);
+    return 0;
+}
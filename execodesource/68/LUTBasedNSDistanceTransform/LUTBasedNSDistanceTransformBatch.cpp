@@ -0,0 +1,301 @@
+// This file is part of LUTBasedNSDistanceTransform.
+//
+// LUTBasedNSDistanceTransform is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// LUTBasedNSDistanceTransform is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// LUTBasedNSDistanceTransform.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+ * @file LUTBasedNSDistanceTransformBatch.cpp
+ *
+ * @brief Distance transforms of a set of image files computed in a single
+ * process with NSDistanceTransform.
+ *
+ * This file is part of LUTBasedNSDistanceTransform.
+ */
+
+#include <assert.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/errno.h>
+
+#include <string>
+#include <vector>
+
+#include "ImageReader.h"
+
+#include "NSDistanceTransform.h"
+
+#include "ImageWriter.h"
+
+void usage() __attribute__ ((noreturn));
+
+void usage() {
+    fprintf(stderr,
+	    //-----------------------------------------------------------------------------//
+	    "Usage: LUTBasedNSDistanceTransformBatch [-c] (-4|-8|-r <num/den>|-s <sequence>) [-t (pgm|png)] [-w (8|16)] [file ...]\n"
+	    "\n"
+	    "LUTBasedNSDistanceTransformBatch computes the 2D neighborhood-sequence distance\n"
+	    "transform of each binary image file given on the command line (or read one\n"
+	    "per line from its standard input if none is given) and writes the result of\n"
+	    "\"file\" to \"file.dt.pgm\" or \"file.dt.png\". The look up tables of the\n"
+	    "distance and the buffers are shared by all images.\n"
+	    "\n"
+	    "Options\n"
+	    "  -4            Use the city block distance.\n"
+	    "  -8            Use the chessboard distance.\n"
+	    "  -s sequence   One period of the sequence of neighborhoods given as a list of 1\n"
+	    "                and 2 separated by \" \" or \",\".\n"
+	    "  -r num/den    Ratio of neighborhood 2 given as the rational number num/den\n"
+	    "                (with den >= num >= 0 and den > 0).\n"
+	    "  -c            Center the distance transform.\n"
+	    "  -m value      Set the maximal value of the distance.\n"
+	    "  -t format     Select output image format (pgm or png).\n"
+	    "  -w width      Force the pixel width of the distance transform (8 or 16\n"
+	    "                bits). Distance values are saturated to the largest value of\n"
+	    "                this width. By default, 8 bits are used for images up to 510\n"
+	    "                pixels wide or high, 16 bits for larger ones.\n"
+	    //-----------------------------------------------------------------------------//
+	    );
+    exit(-1);
+}
+
+/**
+ * @brief ImageConsumer that keeps a copy of the image it receives.
+ */
+class ImageCollector: public ImageConsumer<BinaryPixelType> {
+public:
+    ImageCollector(std::vector<BinaryPixelType> &pixels, int &cols, int &rows) :
+    _pixels(pixels), _cols(cols), _rows(rows) {
+    }
+
+    void beginOfImage(int cols, int rows) {
+	_cols = cols;
+	_rows = rows;
+	_pixels.clear();
+	_pixels.reserve((size_t) cols * rows);
+    }
+
+    void processRow(const BinaryPixelType* inputRow) {
+	_pixels.insert(_pixels.end(), inputRow, inputRow + _cols);
+    }
+
+    void endOfImage() {
+	assert(_pixels.size() == (size_t) _cols * _rows);
+    }
+
+private:
+    std::vector<BinaryPixelType> &_pixels;
+    int &_cols;
+    int &_rows;
+};
+
+/**
+ * @brief Read the first image of a pbm or png file.
+ * @return 1 on success, 0 otherwise.
+ */
+int readImage(FILE *input, std::vector<BinaryPixelType> &pixels, int &cols, int &rows) {
+    cols = rows = 0;
+
+#ifdef WITH_NETPBM
+    char c = fgetc(input);
+    ungetc(c, input);
+
+    if (c == 'P') {
+	PBMImageReader producer(new ImageCollector(pixels, cols, rows), input);
+	producer.produceAllRows();
+	return 1;
+    }
+#endif
+
+#ifdef WITH_PNG
+    unsigned char signature[8];
+
+    if (fread(signature, 1, 8, input) == 8 && png_check_sig(signature, 8)) {
+	PNGImageReader producer(new ImageCollector(pixels, cols, rows), input);
+	producer.produceAllRows(8);
+	return 1;
+    }
+#endif
+
+    return 0;
+}
+
+/**
+ * @brief Write a distance transform to a file.
+ * @return 1 on success, 0 otherwise.
+ */
+template <typename outputPixelType>
+int writeImage(const char *filename, const char *format,
+	       const outputPixelType *pixels, int cols, int rows) {
+    FILE *output = fopen(filename, "w");
+    if (output == NULL)
+	return 0;
+
+    ImageConsumer<outputPixelType> *writer = createImageStreamWriter<outputPixelType>(output, format);
+    if (writer == NULL) {
+	fclose(output);
+	return 0;
+    }
+    writer->beginOfImage(cols, rows);
+    for (int row = 0; row < rows; row++) {
+	writer->processRow(pixels + (size_t) row * cols);
+    }
+    writer->endOfImage();
+    delete writer;
+
+    return fclose(output) == 0;
+}
+
+/**
+ * @brief Compute the distance transform of an image with pixels of type
+ * \p outputPixelType and write it to a file.
+ * @return 1 on success, 0 otherwise.
+ */
+template <typename outputPixelType>
+int transformImage(NSDistanceTransform<outputPixelType> &dt, std::vector<outputPixelType> &result,
+		   const std::vector<BinaryPixelType> &image, int cols, int rows,
+		   const char *filename, const char *format) {
+    if (result.size() < image.size())
+	result.resize(image.size());
+    dt.transform(&image[0], cols, rows, &result[0]);
+
+    return writeImage(filename, format, &result[0], cols, rows);
+}
+
+int main(int argc, char** argv) {
+    DistanceType type = undefined;
+    char *spec = NULL;
+    int translateFlag = 0;
+    char *myName = argv[0];
+    const char *outputFormat = NULL;
+    int dMax = 0;
+    int width = 0;
+
+    int ch;
+
+    while ((ch = getopt(argc, argv, "m:t:48r:s:cw:")) != -1) {
+	switch (ch) {
+	    case '4':
+	    case '8':
+	    case 'r':
+	    case 's':
+		if (type != undefined) {
+		    fprintf(stderr, "Distance specified more than once\n");
+		    exit(-1);
+		}
+		type = ch == '4' ? d4 : ch == '8' ? d8 : ch == 'r' ? ratioDefined : sequenceDefined;
+		spec = optarg;
+		break;
+	    case 'm': {
+		char *endPtr;
+		long value = strtol(optarg, &endPtr, 10);
+		if (*endPtr != '\0' || value < 0 || value > GRAYSCALE_MAX) {
+		    fprintf(stderr, "Invalid maximal value \"%s\"\n", optarg);
+		    exit(-1);
+		}
+		dMax = value;
+		break;
+	    }
+	    case 'w':
+		width = atoi(optarg);
+		if (width != 8 && width != 16) {
+		    fprintf(stderr, "Invalid pixel width \"%s\" (8 or 16)\n", optarg);
+		    exit(-1);
+		}
+		break;
+	    case 't':
+		outputFormat = optarg;
+		break;
+	    case 'c':
+		translateFlag = 1;
+		break;
+ 	    default:
+		usage();
+	}
+    }
+    argc -= optind;
+    argv += optind;
+
+    if (type == undefined) {
+	fprintf(stderr, "Distance not specified\n");
+	exit(-1);
+    }
+
+    BaseDistance<Grayscale8PixelType> *dist8 = createDistance<Grayscale8PixelType>(type, spec, dMax);
+    if (dist8 == NULL) {
+	exit(-1);
+    }
+    BaseDistance<Grayscale16PixelType> *dist16 = createDistance<Grayscale16PixelType>(type, spec, dMax);
+
+    if (outputFormat == NULL) {
+#ifdef WITH_NETPBM
+	outputFormat = "pgm";
+#else
+	outputFormat = "png";
+#endif
+    }
+
+    // One distance transform per pixel width, selected for each image
+    NSDistanceTransform<Grayscale8PixelType> dt8(dist8, translateFlag);
+    NSDistanceTransform<Grayscale16PixelType> dt16(dist16, translateFlag);
+    std::vector<BinaryPixelType> image;
+    std::vector<Grayscale8PixelType> result8;
+    std::vector<Grayscale16PixelType> result16;
+    int errors = 0;
+
+    for (int i = 0; ; i++) {
+	std::string filename;
+	if (argc > 0) {
+	    if (i == argc)
+		break;
+	    filename = argv[i];
+	}
+	else {
+	    char line[4096];
+	    if (fgets(line, sizeof(line), stdin) == NULL)
+		break;
+	    line[strcspn(line, "\r\n")] = '\0';
+	    if (line[0] == '\0')
+		continue;
+	    filename = line;
+	}
+
+	FILE *input = fopen(filename.c_str(), "r");
+	if (input == NULL) {
+	    fprintf(stderr, "%s: %s: %s\n", myName, filename.c_str(), strerror(errno));
+	    errors++;
+	    continue;
+	}
+	int cols, rows;
+	int ok = readImage(input, image, cols, rows);
+	fclose(input);
+	if (!ok) {
+	    fprintf(stderr, "%s: %s: input image format not recognized\n", myName, filename.c_str());
+	    errors++;
+	    continue;
+	}
+
+	std::string outputName = filename + ".dt." + outputFormat;
+	int imageWidth = width != 0 ? width : pixelWidthFor(cols, rows, dMax);
+	int written;
+	if (imageWidth == 8)
+	    written = transformImage(dt8, result8, image, cols, rows, outputName.c_str(), outputFormat);
+	else
+	    written = transformImage(dt16, result16, image, cols, rows, outputName.c_str(), outputFormat);
+	if (!written) {
+	    fprintf(stderr, "%s: %s: unable to write image\n", myName, outputName.c_str());
+	    errors++;
+	}
+    }
+
+    return errors == 0 ? 0 : 1;
+}
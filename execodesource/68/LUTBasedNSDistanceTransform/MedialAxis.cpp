@@ -0,0 +1,275 @@
+// This file is part of LUTBasedNSDistanceTransform.
+//
+// LUTBasedNSDistanceTransform is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// LUTBasedNSDistanceTransform is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// LUTBasedNSDistanceTransform.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "MedialAxis.h"
+
+/**
+ * Largest distance value of an image: no point is farther than half the
+ * smallest dimension from the background outside the image.
+ */
+static int imageDMax(int dMax, int cols, int rows) {
+    int imageDMax = dMax;
+    imageDMax = std::min(imageDMax, (cols + 1) / 2);
+    imageDMax = std::min(imageDMax, (rows + 1) / 2);
+    return imageDMax;
+}
+
+template <typename pixelType>
+MedialAxisExtractor<pixelType>::MedialAxisExtractor(ImageConsumer<pixelType>* consumer, const BaseDistance<pixelType> *d, int dMax) :
+    super(consumer),
+    _d(d),
+    _dMax(boundedDMax<pixelType>(dMax)),
+    _cols(0),
+    _curRow(0),
+    _allocatedCols(0),
+    _outputRow(NULL),
+    _lutSize(0),
+    _diagonalCost(NULL) {
+    _dtRows[0] = NULL;
+    _dtRows[1] = NULL;
+    _dtRows[2] = NULL;
+}
+
+template <typename pixelType>
+MedialAxisExtractor<pixelType>::~MedialAxisExtractor() {
+    for (int i = 0; i < 3; i++) {
+	free(_dtRows[i]);
+    }
+    free(_outputRow);
+    free(_diagonalCost);
+}
+
+template <typename pixelType>
+void MedialAxisExtractor<pixelType>::beginOfImage(int cols, int rows) {
+    int lutSize = imageDMax(_dMax, cols, rows) + 1;
+
+    // Buffers and look up table are kept from one image to the next one and
+    // only grown when needed.
+    if (cols > _allocatedCols) {
+	for (int i = 0; i < 3; i++) {
+	    free(_dtRows[i]);
+	    _dtRows[i] = (pixelType *) malloc((cols + 2) * sizeof(pixelType));
+	    assert(_dtRows[i]);
+	}
+	free(_outputRow);
+	_outputRow = (pixelType *) malloc(cols * sizeof(pixelType));
+	assert(_outputRow);
+	_allocatedCols = cols;
+    }
+    if (lutSize > _lutSize) {
+	_diagonalCost = (int *) realloc(_diagonalCost, lutSize * sizeof(int));
+	assert(_diagonalCost);
+	_diagonalCost[0] = 1;
+	for (int r = std::max(1, _lutSize); r < lutSize; r++) {
+	    // The disk grows with neighborhood B(r) from radius r to r + 1
+	    bool n2 = _d->countOf2(r) != _d->countOf2(r - 1);
+	    _diagonalCost[r] = n2 ? r + 1 : r + 2;
+	}
+	_lutSize = lutSize;
+    }
+    for (int i = 0; i < 3; i++) {
+	memset(_dtRows[i], 0, (cols + 2) * sizeof(pixelType));
+    }
+    _cols = cols;
+    _curRow = 0;
+
+    super::beginOfImage(cols, rows);
+}
+
+template <typename pixelType>
+void MedialAxisExtractor<pixelType>::processRow(const pixelType* inputRow) {
+    pixelType *t = _dtRows[0];
+    _dtRows[0] = _dtRows[1];
+    _dtRows[1] = _dtRows[2];
+    _dtRows[2] = t;
+    if (inputRow == NULL)
+	memset(_dtRows[2] + 1, 0, _cols * sizeof(pixelType));
+    else
+	memcpy(_dtRows[2] + 1, inputRow, _cols * sizeof(pixelType));
+
+    // The first call only fills the row after the current one
+    if (_curRow++ == 0)
+	return;
+
+    const pixelType *prev = _dtRows[0] + 1;
+    const pixelType *cur = _dtRows[1] + 1;
+    const pixelType *next = _dtRows[2] + 1;
+    for (int col = 0; col < _cols; col++) {
+	int r = cur[col];
+	if (r == 0) {
+	    _outputRow[col] = 0;
+	    continue;
+	}
+	assert(r < _lutSize);
+	int c1 = r + 1;
+	int c2 = _diagonalCost[r];
+	bool included =
+	    cur[col - 1] >= c1 || cur[col + 1] >= c1 ||
+	    prev[col] >= c1 || next[col] >= c1 ||
+	    prev[col - 1] >= c2 || prev[col + 1] >= c2 ||
+	    next[col - 1] >= c2 || next[col + 1] >= c2;
+	_outputRow[col] = included ? 0 : r;
+    }
+    _consumer->processRow(_outputRow);
+}
+
+template <typename pixelType>
+void MedialAxisExtractor<pixelType>::endOfImage() {
+    // Flush the last row, followed by the background
+    if (_curRow > 0)
+	this->processRow(NULL);
+    _cols = 0;
+    _curRow = 0;
+
+    super::endOfImage();
+}
+
+template <typename pixelType>
+ReverseDistanceTransform<pixelType>::ReverseDistanceTransform(ImageConsumer<pixelType>* consumer, const BaseDistance<pixelType> *d, int dMax) :
+    super(consumer),
+    _d(d),
+    _dMax(boundedDMax<pixelType>(dMax)),
+    _cols(0),
+    _rows(0),
+    _curRow(0),
+    _outRow(0),
+    _imageDMax(0),
+    _rowCount(0),
+    _allocatedCols(0),
+    _allocatedRows(0),
+    _runEnds(NULL),
+    _outputRow(NULL),
+    _lutSize(0),
+    _countOf2(NULL) {
+}
+
+template <typename pixelType>
+ReverseDistanceTransform<pixelType>::~ReverseDistanceTransform() {
+    for (int row = 0; row < _allocatedRows; row++) {
+	free(_runEnds[row]);
+    }
+    free(_runEnds);
+    free(_outputRow);
+    free(_countOf2);
+}
+
+template <typename pixelType>
+void ReverseDistanceTransform<pixelType>::beginOfImage(int cols, int rows) {
+    _imageDMax = std::max(1, imageDMax(_dMax, cols, rows));
+    _rowCount = 2 * _imageDMax - 1;
+
+    if (cols > _allocatedCols || _rowCount > _allocatedRows) {
+	for (int row = 0; row < _allocatedRows; row++) {
+	    free(_runEnds[row]);
+	}
+	free(_runEnds);
+	free(_outputRow);
+
+	_allocatedCols = std::max(cols, _allocatedCols);
+	_allocatedRows = std::max(_rowCount, _allocatedRows);
+	_runEnds = (int **) malloc(_allocatedRows * sizeof(int *));
+	assert(_runEnds);
+	for (int row = 0; row < _allocatedRows; row++) {
+	    _runEnds[row] = (int *) malloc(_allocatedCols * sizeof(int));
+	    assert(_runEnds[row]);
+	}
+	_outputRow = (pixelType *) malloc(_allocatedCols * sizeof(pixelType));
+	assert(_outputRow);
+    }
+    if (_imageDMax + 1 > _lutSize) {
+	_countOf2 = (int *) realloc(_countOf2, (_imageDMax + 1) * sizeof(int));
+	assert(_countOf2);
+	for (int r = _lutSize; r <= _imageDMax; r++) {
+	    _countOf2[r] = _d->countOf2(r);
+	}
+	_lutSize = _imageDMax + 1;
+    }
+    for (int row = 0; row < _rowCount; row++) {
+	memset(_runEnds[row], 0, cols * sizeof(int));
+    }
+    _cols = cols;
+    _rows = rows;
+    _curRow = 0;
+    _outRow = 0;
+
+    super::beginOfImage(cols, rows);
+}
+
+template <typename pixelType>
+void ReverseDistanceTransform<pixelType>::processRow(const pixelType* inputRow) {
+    for (int col = 0; col < _cols; col++) {
+	int r = inputRow[col];
+	if (r == 0)
+	    continue;
+	assert(r <= _imageDMax);
+
+	// Half height and half width of the octagon, half width of its
+	// rows of maximal width
+	int h = r - 1;
+	int a = r - 1 + _countOf2[r - 1];
+	int rowMin = std::max(_curRow - h, 0);
+	int rowMax = std::min(_curRow + h, _rows - 1);
+	for (int row = rowMin; row <= rowMax; row++) {
+	    int w = std::min(h, a - abs(row - _curRow));
+	    int start = std::max(col - w, 0);
+	    int end = std::min(col + w + 1, _cols);
+	    int *runEnds = _runEnds[row % _rowCount];
+	    runEnds[start] = std::max(runEnds[start], end);
+	}
+    }
+    _curRow++;
+
+    // Disks centered on the next rows do not reach the rows above
+    // _curRow - _imageDMax + 1
+    while (_outRow <= _curRow - _imageDMax)
+	outputRow();
+}
+
+template <typename pixelType>
+void ReverseDistanceTransform<pixelType>::outputRow() {
+    int *runEnds = _runEnds[_outRow % _rowCount];
+    int end = 0;
+    for (int col = 0; col < _cols; col++) {
+	end = std::max(end, runEnds[col]);
+	runEnds[col] = 0;
+	_outputRow[col] = col < end ? 1 : 0;
+    }
+    _consumer->processRow(_outputRow);
+    _outRow++;
+}
+
+template <typename pixelType>
+void ReverseDistanceTransform<pixelType>::endOfImage() {
+    while (_outRow < _rows)
+	outputRow();
+    _cols = 0;
+    _rows = 0;
+    _curRow = 0;
+    _outRow = 0;
+
+    super::endOfImage();
+}
+
+template class MedialAxisExtractor<Grayscale8PixelType>;
+template class MedialAxisExtractor<Grayscale16PixelType>;
+
+template class ReverseDistanceTransform<Grayscale8PixelType>;
+template class ReverseDistanceTransform<Grayscale16PixelType>;
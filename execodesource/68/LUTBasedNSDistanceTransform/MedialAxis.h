@@ -0,0 +1,190 @@
+// This file is part of LUTBasedNSDistanceTransform.
+//
+// LUTBasedNSDistanceTransform is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// LUTBasedNSDistanceTransform is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// LUTBasedNSDistanceTransform.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+ * @file MedialAxis.h
+ *
+ * @brief Streaming medial axis extraction and reverse distance transform of
+ * 2D neighborhood-sequence distances.
+ *
+ * Both filters are chained after the regular (centered) distance transform,
+ * in the same row-streaming pass: MedialAxisExtractor keeps three rows of
+ * the distance transform and ReverseDistanceTransform keeps a number of
+ * rows proportional to the maximal distance value.
+ *
+ * The disk of radius @f$r@f$ (the points at a distance lower than @f$r@f$
+ * of its center) is the Minkowski sum of the neighborhoods
+ * @f$\mathcal{N}_{B(1)},\ldots,\mathcal{N}_{B(r-1)}@f$. It is the octagon
+ * @f$\{(x,y):\max(|x|,|y|)\leq r-1,|x|+|y|\leq r-1+\mathbf2_B(r-1)\}@f$
+ * where @f$\mathbf2_B(n)@f$, the number of occurrences of 2 among the
+ * first @f$n@f$ terms of the sequence, is given by BaseDistance::countOf2.
+ *
+ * This file is part of LUTBasedNSDistanceTransform.
+ */
+
+#ifndef MEDIAL_AXIS_H
+#define MEDIAL_AXIS_H
+
+#include "BaseDistanceDT.h"
+
+/**
+ * @brief Medial axis of a neighborhood-sequence distance transform.
+ *
+ * MedialAxisExtractor is an ImageFilter that receives the regular
+ * (centered) distance transform one row at a time and writes to the next
+ * consumer the centers of maximal disks: their distance value is kept and
+ * all other pixels are set to 0. The result row is produced one input row
+ * late.
+ */
+template <typename pixelType>
+class MedialAxisExtractor: public ImageFilter<pixelType, pixelType> {
+public:
+    /**
+     * @brief Construct a MedialAxisExtractor.
+     *
+     * @param consumer the next consumer in the filter chain.
+     * @param d the distance of the input distance transform. It is used
+     * while the filter exists.
+     * @param dMax maximal value of the distance transform. Input distance
+     * values are assumed never to exceed this value. When \p dMax is 0, the
+     * distance is only bounded by the maximal value of \p pixelType.
+     */
+    MedialAxisExtractor(ImageConsumer<pixelType>* consumer, const BaseDistance<pixelType> *d, int dMax = 0);
+    ~MedialAxisExtractor();
+
+    void beginOfImage(int cols, int rows);
+
+    /**
+     * @brief Process one row of the distance transform.
+     *
+     * The disk of radius @f$DT_X(p)@f$ centered on @f$p@f$ is included in
+     * the disk centered on one of its 8-neighbors @f$p+\vec v@f$ if and
+     * only if @f$DT_X(p+\vec v)\geq\check C_{\vec v}(DT_X(p))@f$, with:
+     * @f{equation}{
+     *   \check C_{\vec v}(r)=\begin{cases}
+     *     r+1&\text{if }\vec v\in\mathcal{N}_1\text{ or }B(r)=2\\
+     *     r+2&\text{otherwise}
+     *   \end{cases}\;.
+     * @f}
+     * A point of the set is a center of maximal disk when no neighbor
+     * satisfies this condition. The values of @f$\check C_{\vec v}@f$ for
+     * diagonal vectors are kept in a look up table.
+     */
+    void processRow(const pixelType* inputRow);
+    void endOfImage();
+
+protected:
+    using ImageFilter<pixelType, pixelType>::_consumer;
+
+    /** Distance */
+    const BaseDistance<pixelType> *_d;
+    /**
+     * Upper bound of the distance transform value (input distance values
+     * are assumed never to exceed #_dMax).
+     */
+    const pixelType _dMax;
+    int _cols;
+    int _curRow;
+    /** Number of columns of the allocated rows. */
+    int _allocatedCols;
+    /**
+     * Previous, current and next rows of the distance transform, with
+     * one null pixel on each side.
+     */
+    pixelType *_dtRows[3];
+    pixelType *_outputRow;
+    /** Size of #_diagonalCost. */
+    int _lutSize;
+    /** Cost @f$\check C_{\vec v}(r)@f$ of the diagonal vectors. */
+    int *_diagonalCost;
+
+private:
+    typedef ImageFilter<pixelType, pixelType> super;
+};
+
+/**
+ * @brief Reverse distance transform of a neighborhood-sequence distance.
+ *
+ * ReverseDistanceTransform is an ImageFilter that receives, one row at a
+ * time, the radii of a set of disks (a medial axis, or a whole distance
+ * transform) and writes to the next consumer the union of the disks: 1 for
+ * the points covered by a disk, 0 elsewhere. Fed with the output of
+ * MedialAxisExtractor, it reconstructs the input set of the distance
+ * transform.
+ *
+ * Each disk is drawn as one horizontal run per row and the runs are kept in
+ * a circular buffer of @f$2d_{max}-1@f$ rows: a row is written to the next
+ * consumer as soon as no disk centered on a later row can reach it.
+ */
+template <typename pixelType>
+class ReverseDistanceTransform: public ImageFilter<pixelType, pixelType> {
+public:
+    /**
+     * @brief Construct a ReverseDistanceTransform.
+     *
+     * @param consumer the next consumer in the filter chain.
+     * @param d the distance of the disks. It is used while the filter
+     * exists.
+     * @param dMax maximal value of the disk radii. Input radii are assumed
+     * never to exceed this value. When \p dMax is 0, the radii are only
+     * bounded by the maximal value of \p pixelType.
+     *
+     * As for the untranslators, the latency and the number of stored rows
+     * directly depend on the maximal radius.
+     */
+    ReverseDistanceTransform(ImageConsumer<pixelType>* consumer, const BaseDistance<pixelType> *d, int dMax = 0);
+    ~ReverseDistanceTransform();
+
+    void beginOfImage(int cols, int rows);
+    void processRow(const pixelType* inputRow);
+    void endOfImage();
+
+protected:
+    using ImageFilter<pixelType, pixelType>::_consumer;
+
+    /** Write the next complete row to the consumer. */
+    void outputRow();
+
+    /** Distance */
+    const BaseDistance<pixelType> *_d;
+    /** Upper bound of the disk radii. */
+    const pixelType _dMax;
+    int _cols;
+    int _rows;
+    int _curRow;
+    int _outRow;
+    /** Maximal radius of the current image. */
+    int _imageDMax;
+    /** Number of rows of the circular buffer (@f$2d_{max}-1@f$). */
+    int _rowCount;
+    /** Number of columns and rows of the allocated buffers. */
+    int _allocatedCols;
+    int _allocatedRows;
+    /**
+     * For each buffered row and each column, the end (excluded) of the
+     * longest run starting at this column, or 0.
+     */
+    int **_runEnds;
+    pixelType *_outputRow;
+    /** Size of #_countOf2. */
+    int _lutSize;
+    /** @f$\mathbf2_B(r)@f$ for @f$0\leq r<@f$ #_lutSize. */
+    int *_countOf2;
+
+private:
+    typedef ImageFilter<pixelType, pixelType> super;
+};
+
+#endif
@@ -0,0 +1,209 @@
+// This file is part of LUTBasedNSDistanceTransform.
+//
+// LUTBasedNSDistanceTransform is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// LUTBasedNSDistanceTransform is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// LUTBasedNSDistanceTransform.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+ * @file MedialAxisTest.cpp
+ *
+ * Compares the streaming medial axis with a brute force search of the
+ * centers of maximal disks, and checks that the streaming reverse distance
+ * transform of the medial axis (and of the whole distance transform)
+ * reconstructs the input image.
+ *
+ * This file is part of LUTBasedNSDistanceTransform.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "NSDistanceTransform.h"
+#include "RationalBeattySequence.h"
+
+/**
+ * Neighborhood-sequence distance from the origin to a 2D point: the
+ * smallest k such that the largest absolute coordinate does not exceed k
+ * and the sum of the absolute coordinates does not exceed the sum of B(i)
+ * for i in 1..k.
+ */
+int nsDistance(int x, int y, int period, const int *B) {
+    x = abs(x);
+    y = abs(y);
+    int k = 0;
+    int sum = 0;
+    while (std::max(x, y) > k || x + y > sum) {
+	sum += B[k % period];
+	k++;
+    }
+    return k;
+}
+
+/**
+ * Runs an image through a filter chain and returns the output image.
+ */
+std::vector<GrayscalePixelType> run(BaseDistanceTransform<GrayscalePixelType> *dt,
+				    BufferImageWriter<GrayscalePixelType> *writer,
+				    const std::vector<BinaryPixelType> &image, int cols, int rows) {
+    std::vector<GrayscalePixelType> result(cols * rows);
+    writer->setBuffer(&result[0]);
+    dt->beginOfImage(cols, rows);
+    for (int row = 0; row < rows; row++)
+	dt->processRow(&image[row * cols]);
+    dt->endOfImage();
+    return result;
+}
+
+/**
+ * Brute force medial axis: a point of the set is a center of maximal disk
+ * if its disk is not included in the disk of another point.
+ */
+std::vector<GrayscalePixelType> bruteForceMedialAxis(const std::vector<GrayscalePixelType> &dt,
+						     int cols, int rows, int period, const int *B) {
+    std::vector<GrayscalePixelType> result(dt);
+    for (int y = 0; y < rows; y++)
+	for (int x = 0; x < cols; x++) {
+	    int r = dt[y * cols + x];
+	    if (r == 0)
+		continue;
+	    for (int qy = 0; qy < rows && result[y * cols + x] != 0; qy++)
+		for (int qx = 0; qx < cols && result[y * cols + x] != 0; qx++) {
+		    int s = dt[qy * cols + qx];
+		    if (s <= r)
+			continue;
+		    bool included = true;
+		    for (int dy = 1 - r; dy < r && included; dy++)
+			for (int dx = 1 - r; dx < r && included; dx++) {
+			    if (nsDistance(dx, dy, period, B) < r &&
+				nsDistance(x + dx - qx, y + dy - qy, period, B) >= s)
+				included = false;
+			}
+		    if (included)
+			result[y * cols + x] = 0;
+		}
+	}
+    return result;
+}
+
+std::vector<BinaryPixelType> randomImage(int size, int backgroundPercent) {
+    std::vector<BinaryPixelType> image(size);
+    for (int i = 0; i < size; i++)
+	image[i] = rand() % 100 < backgroundPercent ? 0 : 1;
+    return image;
+}
+
+int testDistance(DistanceType type, const char *spec, int period, const int *B) {
+    int errors = 0;
+
+    printf("Distance %s:", spec);
+    for (int i = 0; i < period; i++)
+	printf(" %d", B[i]);
+    printf("\n");
+
+    for (int dMax = 0; dMax <= 3; dMax += 3) {
+	BaseDistance<GrayscalePixelType> *dist = createDistance<GrayscalePixelType>(type, spec, dMax);
+	assert(dist);
+
+	// Distance transform, medial axis, reconstruction from the medial
+	// axis and from the distance transform. Each chain processes several
+	// images.
+	BufferImageWriter<GrayscalePixelType> *dtWriter = new BufferImageWriter<GrayscalePixelType>();
+	BufferImageWriter<GrayscalePixelType> *maWriter = new BufferImageWriter<GrayscalePixelType>();
+	BufferImageWriter<GrayscalePixelType> *reWriter = new BufferImageWriter<GrayscalePixelType>();
+	BufferImageWriter<GrayscalePixelType> *rdtWriter = new BufferImageWriter<GrayscalePixelType>();
+	BaseDistanceTransform<GrayscalePixelType> *dtChain = dist->newTranslatedDistanceTransform(
+	    dist->newDistanceTransformUntranslator(dtWriter));
+	BaseDistanceTransform<GrayscalePixelType> *maChain = dist->newTranslatedDistanceTransform(
+	    dist->newDistanceTransformUntranslator(
+		dist->newMedialAxisExtractor(maWriter)));
+	BaseDistanceTransform<GrayscalePixelType> *reChain = dist->newTranslatedDistanceTransform(
+	    dist->newDistanceTransformUntranslator(
+		dist->newMedialAxisExtractor(
+		    dist->newReverseDistanceTransform(reWriter))));
+	BaseDistanceTransform<GrayscalePixelType> *rdtChain = dist->newTranslatedDistanceTransform(
+	    dist->newDistanceTransformUntranslator(
+		dist->newReverseDistanceTransform(rdtWriter)));
+
+	const int sizes[][2] = {{23, 17}, {40, 31}, {7, 1}, {1, 9}, {16, 16}};
+	const int backgroundPercents[] = {1, 3, 10, 2, 0};
+	for (int i = 0; i < 5; i++) {
+	    int cols = sizes[i][0], rows = sizes[i][1];
+	    std::vector<BinaryPixelType> image = randomImage(cols * rows, backgroundPercents[i]);
+	    std::vector<GrayscalePixelType> dt = run(dtChain, dtWriter, image, cols, rows);
+	    std::vector<GrayscalePixelType> ma = run(maChain, maWriter, image, cols, rows);
+	    std::vector<GrayscalePixelType> re = run(reChain, reWriter, image, cols, rows);
+	    std::vector<GrayscalePixelType> rdt = run(rdtChain, rdtWriter, image, cols, rows);
+	    std::vector<GrayscalePixelType> expected = bruteForceMedialAxis(dt, cols, rows, period, B);
+
+	    int maErrors = 0, reErrors = 0, maCount = 0;
+	    for (int k = 0; k < cols * rows; k++) {
+		if (ma[k] != expected[k])
+		    maErrors++;
+		if (re[k] != image[k] || rdt[k] != image[k])
+		    reErrors++;
+		if (ma[k] != 0)
+		    maCount++;
+	    }
+	    printf("%2dx%2d, %2d%% background, dMax %d: %3d centers, %d medial axis errors, %d reconstruction errors\n",
+		   cols, rows, backgroundPercents[i], dMax, maCount, maErrors, reErrors);
+	    errors += maErrors + reErrors;
+	}
+
+	delete dtChain;
+	delete maChain;
+	delete reChain;
+	delete rdtChain;
+	delete dist;
+    }
+    return errors;
+}
+
+/**
+ * Checks a ratio-based distance against the periodic sequence made of its
+ * den first terms.
+ */
+int testRatio(const char *spec, int num, int den) {
+    RationalBeattySeq mbf2(num, den, 0);
+    std::vector<int> B(den);
+    for (int n = 1; n <= den; n++)
+	B[n - 1] = 1 + mbf2(n) - mbf2(n - 1);
+    return testDistance(ratioDefined, spec, den, &B[0]);
+}
+
+int main() {
+    int errors = 0;
+
+    int seq1[] = {1};
+    int seq2[] = {2};
+    int seq12[] = {1, 2};
+    int seq112[] = {1, 1, 2};
+    int seq1222[] = {1, 2, 2, 2};
+    int seq11212[] = {1, 1, 2, 1, 2};
+    errors += testDistance(d4, "d4", 1, seq1);
+    errors += testDistance(d8, "d8", 1, seq2);
+    errors += testDistance(sequenceDefined, "1 2", 2, seq12);
+    errors += testDistance(sequenceDefined, "1 1 2", 3, seq112);
+    errors += testDistance(sequenceDefined, "1 2 2 2", 4, seq1222);
+    errors += testDistance(sequenceDefined, "1 1 2 1 2", 5, seq11212);
+    errors += testRatio("1/3", 1, 3);
+    errors += testRatio("2/5", 2, 5);
+    errors += testRatio("3/4", 3, 4);
+
+    printf("%d errors\n", errors);
+    assert(errors == 0);
+
+    return errors == 0 ? 0 : 1;
+}
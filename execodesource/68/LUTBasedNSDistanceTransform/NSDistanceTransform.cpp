@@ -0,0 +1,276 @@
+// This file is part of LUTBasedNSDistanceTransform.
+//
+// LUTBasedNSDistanceTransform is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// LUTBasedNSDistanceTransform is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// LUTBasedNSDistanceTransform.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <assert.h>
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "NSDistanceTransform.h"
+#include "D4DistanceDT.h"
+#include "D8DistanceDT.h"
+#include "RatioNSDistanceDT.h"
+#include "PeriodicNSDistanceDT.h"
+
+int parseRate(const char* string, int *num, int *den) {
+    const char *startptr = string;
+    char *endptr;
+
+    *num = strtol(startptr, &endptr, 0);
+    if (startptr == endptr) {
+	fprintf(stderr, "Invalid sequence \"%s\"\n", endptr);
+	return 0;
+    }
+    // Swallow space characters
+    while (isspace(endptr[0]))
+	endptr++;
+    if (*endptr != '/') {
+	fprintf(stderr, "Invalid sequence \"%s\"\n", endptr);
+	return 0;
+    }
+    startptr = endptr + 1;
+    *den = strtol(startptr, &endptr, 0);
+    if (startptr == endptr) {
+	fprintf(stderr, "Invalid sequence \"%s\"\n", endptr);
+	return 0;
+    }
+
+    return 1;
+}
+
+int parseSequence(const char* string, int *period, int **points, int maxNeighborhood) {
+    const char *startptr = string;
+    char *endptr;
+    int count = 0;
+
+    // 1st pass: dry run, count integers
+    do {
+	int x = strtol(startptr, &endptr, 0);
+	// Swallow space characters
+	while (isspace(endptr[0]))
+	    endptr++;
+	if (startptr == endptr || x < 1 || x > maxNeighborhood) {
+	    fprintf(stderr, "Invalid sequence \"%s\"\n", endptr);
+	    return 0;
+	}
+	if (endptr[0] == ',')
+	    endptr++;
+	startptr = endptr;
+	count++;
+    } while (startptr[0] != '\0');
+
+    assert(count > 0);
+
+    *points = (int *)malloc(count * sizeof(int));
+    count = 0;
+
+    startptr = string;
+    do {
+	int x = strtol(startptr, &endptr, 0);
+	// Swallow space characters
+	while (isspace(endptr[0]))
+	    endptr++;
+	if (endptr[0] == ',')
+	    endptr++;
+	startptr = endptr;
+	(*points)[count++] = x;
+    } while (startptr[0] != '\0');
+
+    *period = count;
+
+    return 1;
+}
+
+template <typename outputPixelType>
+BaseDistance<outputPixelType> *createDistance(DistanceType type, const char *spec, int dMax) {
+    switch (type) {
+	case d4:
+	    return new D4Distance<outputPixelType>(dMax);
+	case d8:
+	    return new D8Distance<outputPixelType>(dMax);
+	case ratioDefined: {
+	    int num, den;
+	    if (!parseRate(spec, &num, &den)) {
+		fprintf(stderr, "Unable to parse num/den \"%s\"\n", spec);
+		return NULL;
+	    }
+	    if (num < 0 || den < num || den <= 0) {
+		fprintf(stderr,
+			"Invalid ratio %d/%d\n"
+			"correct ratios num/den are such that den >= num >= 0 and den > 0\n",
+			num, den);
+		return NULL;
+	    }
+	    if (num == 0) {
+		return new D4Distance<outputPixelType>(dMax);
+	    }
+	    else if (num == den) {
+		return new D8Distance<outputPixelType>(dMax);
+	    }
+	    return new RatioNSDistance<outputPixelType>(num, den, dMax);
+	}
+	case sequenceDefined: {
+	    int period = 0; int *sequence = NULL;
+	    BaseDistance<outputPixelType> *dist;
+
+	    if (!parseSequence(spec, &period, &sequence)) {
+		fprintf(stderr, "Unable to parse sequence \"%s\"\n", spec);
+		return NULL;
+	    }
+	    int countOfNeighbors[2] = {0, 0};
+	    for (int i = 0; i < period; i++) {
+		countOfNeighbors[sequence[i] - 1]++;
+	    }
+	    if (countOfNeighbors[0] == 0) {
+		dist = new D8Distance<outputPixelType>(dMax);
+	    }
+	    else if (countOfNeighbors[1] == 0) {
+		dist = new D4Distance<outputPixelType>(dMax);
+	    }
+	    else {
+		dist = new PeriodicNSDistance<outputPixelType>(period, sequence, dMax);
+	    }
+	    free(sequence);
+	    return dist;
+	}
+	default:
+	    fprintf(stderr, "Distance not specified\n");
+	    return NULL;
+    }
+}
+
+int pixelWidthFor(int cols, int rows, int dMax) {
+    int imageDMax = (std::min(cols, rows) + 1) / 2;
+    if (dMax != 0)
+	imageDMax = std::min(imageDMax, dMax);
+    return imageDMax <= grayscaleMax<Grayscale8PixelType>() ? 8 : 16;
+}
+
+template <typename outputPixelType>
+BufferImageWriter<outputPixelType>::BufferImageWriter() :
+_buffer(NULL),
+_stride(0),
+_cols(0),
+_rows(0),
+_curRow(0) {
+}
+
+template <typename outputPixelType>
+void BufferImageWriter<outputPixelType>::setBuffer(outputPixelType *buffer, int stride) {
+    _buffer = buffer;
+    _stride = stride;
+}
+
+template <typename outputPixelType>
+void BufferImageWriter<outputPixelType>::beginOfImage(int cols, int rows) {
+    assert(_buffer != NULL);
+    _cols = cols;
+    _rows = rows;
+    _curRow = 0;
+    if (_stride == 0)
+	_stride = cols;
+}
+
+template <typename outputPixelType>
+void BufferImageWriter<outputPixelType>::processRow(const outputPixelType* inputRow) {
+    assert(_curRow < _rows);
+    memcpy(_buffer + (size_t) _curRow * _stride, inputRow, _cols * sizeof(outputPixelType));
+    _curRow++;
+}
+
+template <typename outputPixelType>
+void BufferImageWriter<outputPixelType>::endOfImage() {
+    assert(_curRow == _rows);
+    _buffer = NULL;
+    _stride = 0;
+}
+
+template <typename outputPixelType>
+NSDistanceTransform<outputPixelType>::NSDistanceTransform(BaseDistance<outputPixelType> *distance, bool centered) :
+_distance(distance),
+_writer(new BufferImageWriter<outputPixelType>()) {
+    assert(_distance != NULL);
+    ImageConsumer<outputPixelType> *output = _writer;
+    if (centered) {
+	output = _distance->newDistanceTransformUntranslator(output);
+    }
+    _dt = _distance->newTranslatedDistanceTransform(output);
+}
+
+template <typename outputPixelType>
+NSDistanceTransform<outputPixelType>::~NSDistanceTransform() {
+    // The filters may refer to the distance
+    delete _dt;
+    delete _distance;
+}
+
+template <typename outputPixelType>
+void NSDistanceTransform<outputPixelType>::transform(const BinaryPixelType *image, int cols, int rows,
+						     outputPixelType *result,
+						     int imageStride, int resultStride) {
+    if (imageStride == 0)
+	imageStride = cols;
+    _writer->setBuffer(result, resultStride);
+    _dt->beginOfImage(cols, rows);
+    for (int row = 0; row < rows; row++) {
+	_dt->processRow(image + (size_t) row * imageStride);
+    }
+    _dt->endOfImage();
+}
+
+PixelWidthSelector::PixelWidthSelector(ImageConsumer<BinaryPixelType> *chain8,
+				       ImageConsumer<BinaryPixelType> *chain16,
+				       int dMax, int width) :
+_chain8(chain8),
+_chain16(chain16),
+_dMax(dMax),
+_forcedWidth(width),
+_width(0),
+_chain(NULL) {
+    assert(width == 0 || width == 8 || width == 16);
+}
+
+PixelWidthSelector::~PixelWidthSelector() {
+    delete _chain8;
+    delete _chain16;
+}
+
+void PixelWidthSelector::beginOfImage(int cols, int rows) {
+    assert(_chain == NULL);
+    _width = _forcedWidth != 0 ? _forcedWidth : pixelWidthFor(cols, rows, _dMax);
+    _chain = _width == 8 ? _chain8 : _chain16;
+    assert(_chain != NULL);
+    _chain->beginOfImage(cols, rows);
+}
+
+void PixelWidthSelector::processRow(const BinaryPixelType* inputRow) {
+    _chain->processRow(inputRow);
+}
+
+void PixelWidthSelector::endOfImage() {
+    _chain->endOfImage();
+    _chain = NULL;
+}
+
+template BaseDistance<Grayscale8PixelType> *createDistance<Grayscale8PixelType>(DistanceType, const char *, int);
+template BaseDistance<Grayscale16PixelType> *createDistance<Grayscale16PixelType>(DistanceType, const char *, int);
+
+template class BufferImageWriter<Grayscale8PixelType>;
+template class BufferImageWriter<Grayscale16PixelType>;
+
+template class NSDistanceTransform<Grayscale8PixelType>;
+template class NSDistanceTransform<Grayscale16PixelType>;
@@ -0,0 +1,225 @@
+// This file is part of LUTBasedNSDistanceTransform.
+//
+// LUTBasedNSDistanceTransform is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// LUTBasedNSDistanceTransform is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// LUTBasedNSDistanceTransform.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+ * @file NSDistanceTransform.h
+ *
+ * @brief In-process interface to the neighborhood-sequence distance
+ * transforms: distance specifications and transformation of images held
+ * in memory.
+ *
+ * This file is part of LUTBasedNSDistanceTransform.
+ */
+
+#ifndef NS_DISTANCE_TRANSFORM_H
+#define NS_DISTANCE_TRANSFORM_H
+
+#include "BaseDistanceDT.h"
+
+typedef enum {
+    undefined,
+    d4,
+    d8,
+    ratioDefined,
+    sequenceDefined
+} DistanceType;
+
+/**
+ * @brief Parse a ratio of neighborhoods given as "num/den".
+ * @return 1 on success, 0 otherwise.
+ */
+int parseRate(const char* string, int *num, int *den);
+
+/**
+ * @brief Parse one period of a sequence of neighborhoods (1 and 2, or 1 to
+ * \p maxNeighborhood, separated by spaces or commas).
+ *
+ * @param period (returns) the length of the period.
+ * @param points (returns) the sequence, allocated with malloc().
+ * @param maxNeighborhood the largest neighborhood (2 in 2D, 3 in 3D).
+ * @return 1 on success, 0 otherwise.
+ */
+int parseSequence(const char* string, int *period, int **points, int maxNeighborhood = 2);
+
+/**
+ * @brief Create the distance specified as by the command line options -4,
+ * -8, -r num/den and -s sequence.
+ *
+ * Ratios 0/den and den/den and sequences made of a single neighborhood
+ * give the simple distances @f$d_4@f$ and @f$d_8@f$. Errors are reported
+ * on stderr.
+ *
+ * @param type the kind of specification.
+ * @param spec the ratio or the sequence (ignored for d4 and d8).
+ * @param dMax maximal value of the distance transform (0 for no bound).
+ * Distance values are also bounded by the maximal value of
+ * \p outputPixelType.
+ * @return the distance (to be deleted by the caller) or NULL if the
+ * specification is invalid.
+ */
+template <typename outputPixelType>
+BaseDistance<outputPixelType> *createDistance(DistanceType type, const char *spec, int dMax = 0);
+
+/**
+ * @brief Smallest pixel width able to hold a distance transform.
+ *
+ * Horizontal and vertical steps cost 1 with all the 2D neighborhood-sequence
+ * distances, so no distance value (translated or not) exceeds half the
+ * smallest dimension of the image, whatever the distance: 8-bit pixels hold
+ * the distance values of images up to 510 pixels wide or high.
+ *
+ * @param cols the image width.
+ * @param rows the image height.
+ * @param dMax maximal value of the distance transform (0 for no bound).
+ * @return 8 or 16, the number of bits of Grayscale8PixelType or
+ * Grayscale16PixelType. 16-bit values are saturated to 65535.
+ */
+int pixelWidthFor(int cols, int rows, int dMax = 0);
+
+/**
+ * @brief ImageConsumer that writes the rows it receives into a buffer
+ * provided by the caller.
+ */
+template <typename outputPixelType>
+class BufferImageWriter: public ImageConsumer<outputPixelType> {
+public:
+    BufferImageWriter();
+
+    /**
+     * @brief Set the buffer of the next image.
+     * @param buffer the first pixel of the first row.
+     * @param stride the distance, in pixels, between two rows (0 for the
+     * image width).
+     */
+    void setBuffer(outputPixelType *buffer, int stride = 0);
+
+    void beginOfImage(int cols, int rows);
+    void processRow(const outputPixelType* inputRow);
+    void endOfImage();
+
+protected:
+    outputPixelType *_buffer;
+    int _stride;
+    int _cols;
+    int _rows;
+    int _curRow;
+};
+
+/**
+ * @brief Distance transform of binary images held in memory.
+ *
+ * NSDistanceTransform builds the filter chain of a distance (translated
+ * distance transform, optional untranslator) once and runs every image
+ * through it: the look up tables of the distance are computed once and the
+ * row buffers of the filters are reused from one image to the next one. The
+ * rows of the input image are read in place and each result row is copied
+ * once, from the last filter into the caller's buffer.
+ *
+ * The result pixels are of type \p outputPixelType (Grayscale8PixelType or
+ * Grayscale16PixelType).
+ *
+ * @code
+ * NSDistanceTransform<> dt(createDistance<GrayscalePixelType>(ratioDefined, "1/2"), true);
+ * for (...) {
+ *     dt.transform(mask, cols, rows, result);
+ * }
+ * @endcode
+ */
+template <typename outputPixelType = GrayscalePixelType>
+class NSDistanceTransform {
+public:
+    /**
+     * @param distance the distance, deleted with the object.
+     * @param centered compute the regular (centered) distance transform
+     * instead of the translated one.
+     */
+    NSDistanceTransform(BaseDistance<outputPixelType> *distance, bool centered);
+    ~NSDistanceTransform();
+
+    /**
+     * @brief Compute the distance transform of a binary image.
+     *
+     * @param image the first pixel of the binary image (pixels equal to 0
+     * are out of the set, other ones in the set).
+     * @param cols the image width.
+     * @param rows the image height.
+     * @param result the first pixel of the result image, of the same size.
+     * @param imageStride the distance, in pixels, between two rows of
+     * \p image (0 for \p cols).
+     * @param resultStride the distance, in pixels, between two rows of
+     * \p result (0 for \p cols).
+     */
+    void transform(const BinaryPixelType *image, int cols, int rows,
+		   outputPixelType *result,
+		   int imageStride = 0, int resultStride = 0);
+
+private:
+    BaseDistance<outputPixelType> *_distance;
+    /** Last filter of the chain, owned by the chain. */
+    BufferImageWriter<outputPixelType> *_writer;
+    /** First filter of the chain. */
+    BaseDistanceTransform<outputPixelType> *_dt;
+
+    NSDistanceTransform(const NSDistanceTransform &);
+    NSDistanceTransform &operator=(const NSDistanceTransform &);
+};
+
+/**
+ * @brief Pixel width selection of the distance transform.
+ *
+ * PixelWidthSelector is an ImageConsumer of binary images that forwards
+ * each image to one of two filter chains computing the same distance
+ * transform with 8- or 16-bit pixels. Unless the width is forced, the
+ * narrowest chain able to hold the distance values of the image (given by
+ * pixelWidthFor()) is selected in beginOfImage(): images up to 510 pixels
+ * wide or high move and store half the bytes of the 16-bit chain.
+ */
+class PixelWidthSelector: public ImageConsumer<BinaryPixelType> {
+public:
+    /**
+     * @param chain8 the 8-bit filter chain, or NULL if never selected.
+     * @param chain16 the 16-bit filter chain, or NULL if never selected.
+     * The chains are deleted with the object.
+     * @param dMax maximal value of the distance transform (0 for no bound).
+     * @param width forced pixel width (8 or 16), or 0 to select it for each
+     * image.
+     */
+    PixelWidthSelector(ImageConsumer<BinaryPixelType> *chain8,
+		       ImageConsumer<BinaryPixelType> *chain16,
+		       int dMax = 0, int width = 0);
+    ~PixelWidthSelector();
+
+    void beginOfImage(int cols, int rows);
+    void processRow(const BinaryPixelType* inputRow);
+    void endOfImage();
+
+    /** @return the pixel width of the current (or last) image. */
+    int width() const { return _width; }
+
+protected:
+    ImageConsumer<BinaryPixelType> *_chain8;
+    ImageConsumer<BinaryPixelType> *_chain16;
+    const int _dMax;
+    const int _forcedWidth;
+    int _width;
+    /** Chain of the current image. */
+    ImageConsumer<BinaryPixelType> *_chain;
+
+private:
+    PixelWidthSelector(const PixelWidthSelector &);
+    PixelWidthSelector &operator=(const PixelWidthSelector &);
+};
+
+#endif
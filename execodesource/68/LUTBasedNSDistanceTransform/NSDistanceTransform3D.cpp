@@ -0,0 +1,253 @@
+// This file is part of LUTBasedNSDistanceTransform.
+//
+// LUTBasedNSDistanceTransform is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// LUTBasedNSDistanceTransform is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// LUTBasedNSDistanceTransform.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+
+#include "NSDistanceTransform3D.h"
+
+NSDistanceTransform3D::NSDistanceTransform3D(VolumeConsumer<GrayscalePixelType>* consumer, int period, const int *Bvalues, GrayscalePixelType dMax) :
+    VolumeFilter<BinaryPixelType, GrayscalePixelType>(consumer),
+    _period(period),
+    _B((int *) malloc(period * sizeof(int))),
+    _dMax(dMax == 0 ? GRAYSCALE_MAX : dMax),
+    _inited(false),
+    _cols(0),
+    _rows(0),
+    _slices(0),
+    _stageCount(0),
+    _outputCount(0),
+    _sliceSize(0),
+    _allocatedSliceSize(0),
+    _allocatedStages(0),
+    _slots(NULL),
+    _unknownCounts(NULL),
+    _received(NULL),
+    _outputSlice(NULL) {
+
+    assert(period > 0);
+    assert(_B);
+    for (int i = 0; i < period; i++) {
+	assert(Bvalues[i] >= 1 && Bvalues[i] <= 3);
+	_B[i] = Bvalues[i];
+    }
+}
+
+NSDistanceTransform3D::~NSDistanceTransform3D() {
+    for (int i = 0; _slots != NULL && i < 3 * _allocatedStages + 1; i++) {
+	free(_slots[i]);
+    }
+    free(_slots);
+    free(_unknownCounts);
+    free(_received);
+    free(_outputSlice);
+    free(_B);
+}
+
+void NSDistanceTransform3D::beginOfVolume(int cols, int rows, int slices) {
+    assert(!_inited);
+    assert(cols > 0 && rows > 0 && slices > 0);
+
+    // Points outside the volume are in the background, no distance value
+    // exceeds half the smallest dimension.
+    int stageCount = (std::min(std::min(cols, rows), slices) + 1) / 2;
+    stageCount = std::min(stageCount, (int) _dMax);
+
+    _cols = cols;
+    _rows = rows;
+    _slices = slices;
+    _stageCount = stageCount;
+    _outputCount = 0;
+    _sliceSize = (size_t) (cols + 2) * (rows + 2);
+
+    // The slices are kept from one volume to the next one and only grown
+    // when a volume needs more or larger slices than the previous ones.
+    if (_sliceSize > _allocatedSliceSize || stageCount > _allocatedStages) {
+	for (int i = 0; _slots != NULL && i < 3 * _allocatedStages + 1; i++) {
+	    free(_slots[i]);
+	}
+	free(_slots);
+	free(_unknownCounts);
+	free(_received);
+	free(_outputSlice);
+
+	_allocatedSliceSize = std::max(_sliceSize, _allocatedSliceSize);
+	_allocatedStages = std::max(stageCount, _allocatedStages);
+	_slots = (GrayscalePixelType **) malloc((3 * _allocatedStages + 1) * sizeof(GrayscalePixelType *));
+	assert(_slots);
+	for (int i = 0; i < 3 * _allocatedStages + 1; i++) {
+	    _slots[i] = (GrayscalePixelType *) malloc(_allocatedSliceSize * sizeof(GrayscalePixelType));
+	    assert(_slots[i]);
+	}
+	_unknownCounts = (int *) malloc((3 * _allocatedStages + 1) * sizeof(int));
+	assert(_unknownCounts);
+	_received = (int *) malloc(_allocatedStages * sizeof(int));
+	assert(_received);
+	_outputSlice = (GrayscalePixelType *) malloc(_allocatedSliceSize * sizeof(GrayscalePixelType));
+	assert(_outputSlice);
+    }
+
+    // The margins of every slot stay in the background, the current slot of
+    // each stage is the background slice before the volume.
+    for (int i = 0; i < 3 * stageCount + 1; i++) {
+	memset(_slots[i], 0, _sliceSize * sizeof(GrayscalePixelType));
+	_unknownCounts[i] = 0;
+    }
+    for (int stage = 0; stage < stageCount; stage++) {
+	_received[stage] = 0;
+    }
+
+    // Neighbors in the previous (slot 0), current (1) and next (2) slices
+    for (int n = 0; n < 3; n++) {
+	_neighborCount[n] = 0;
+	for (int dz = -1; dz <= 1; dz++) {
+	    for (int dy = -1; dy <= 1; dy++) {
+		for (int dx = -1; dx <= 1; dx++) {
+		    int norm = abs(dx) + abs(dy) + abs(dz);
+		    if (norm == 0 || norm > n + 1)
+			continue;
+		    _neighborSlot[n][_neighborCount[n]] = dz + 1;
+		    _neighborOffset[n][_neighborCount[n]] = (ptrdiff_t) dy * (cols + 2) + dx;
+		    _neighborCount[n]++;
+		}
+	    }
+	}
+    }
+    assert(_neighborCount[0] == 6);
+    assert(_neighborCount[1] == 18);
+    assert(_neighborCount[2] == 26);
+
+    _consumer->beginOfVolume(cols, rows, slices);
+
+    _inited = true;
+}
+
+void NSDistanceTransform3D::processSlice(const BinaryPixelType *inputSlice) {
+    assert(_inited);
+
+    GrayscalePixelType *next = _slots[2];
+    int unknownCount = 0;
+    for (int row = 0; row < _rows; row++) {
+	const BinaryPixelType *inputRow = inputSlice + (size_t) row * _cols;
+	GrayscalePixelType *nextRow = next + (size_t) (row + 1) * (_cols + 2) + 1;
+	for (int col = 0; col < _cols; col++) {
+	    if (inputRow[col] == 0) {
+		nextRow[col] = 0;
+	    }
+	    else {
+		nextRow[col] = unknown;
+		unknownCount++;
+	    }
+	}
+    }
+    _unknownCounts[2] = unknownCount;
+
+    pushSlice(0);
+}
+
+void NSDistanceTransform3D::endOfVolume() {
+    // Flush the stages with the background slice after the volume
+    for (int stage = 0; stage < _stageCount; stage++) {
+	memset(_slots[3 * stage + 2], 0, _sliceSize * sizeof(GrayscalePixelType));
+	_unknownCounts[3 * stage + 2] = 0;
+	pushSlice(stage);
+    }
+    assert(_outputCount == _slices);
+
+    _inited = false;
+    _consumer->endOfVolume();
+}
+
+void NSDistanceTransform3D::pushSlice(int stage) {
+    for (; stage < _stageCount; stage++) {
+	GrayscalePixelType **slots = _slots + 3 * stage;
+	int *unknownCounts = _unknownCounts + 3 * stage;
+	// The last stage writes to the extra slot after its own ones
+	int output = 3 * stage + 5;
+	if (stage == _stageCount - 1)
+	    output = 3 * stage + 3;
+
+	bool ready = _received[stage]++ > 0;
+	if (ready) {
+	    if (unknownCounts[1] == 0) {
+		memcpy(_slots[output], slots[1], _sliceSize * sizeof(GrayscalePixelType));
+		_unknownCounts[output] = 0;
+	    }
+	    else {
+		_unknownCounts[output] = dilate(stage, slots, _slots[output]);
+	    }
+	}
+
+	// Rotate previous, current and next slices
+	GrayscalePixelType *t = slots[0];
+	slots[0] = slots[1];
+	slots[1] = slots[2];
+	slots[2] = t;
+	int c = unknownCounts[0];
+	unknownCounts[0] = unknownCounts[1];
+	unknownCounts[1] = unknownCounts[2];
+	unknownCounts[2] = c;
+
+	if (!ready)
+	    return;
+    }
+
+    // Voxels still unknown are farther than the bound
+    const GrayscalePixelType *last = _slots[3 * _stageCount];
+    for (int row = 0; row < _rows; row++) {
+	const GrayscalePixelType *lastRow = last + (size_t) (row + 1) * (_cols + 2) + 1;
+	GrayscalePixelType *outputRow = _outputSlice + (size_t) row * _cols;
+	for (int col = 0; col < _cols; col++) {
+	    outputRow[col] = std::min(lastRow[col], _dMax);
+	}
+    }
+    _consumer->processSlice(_outputSlice);
+    _outputCount++;
+}
+
+int NSDistanceTransform3D::dilate(int stage, GrayscalePixelType *const *slots, GrayscalePixelType *output) const {
+    const int n = _B[stage % _period] - 1;
+    const GrayscalePixelType value = stage + 1;
+    const int neighborCount = _neighborCount[n];
+    const GrayscalePixelType *neighbors[26];
+    int unknownCount = 0;
+
+    for (int row = 1; row <= _rows; row++) {
+	size_t start = (size_t) row * (_cols + 2) + 1;
+	const GrayscalePixelType *cur = slots[1] + start;
+	GrayscalePixelType *out = output + start;
+	for (int k = 0; k < neighborCount; k++) {
+	    neighbors[k] = slots[_neighborSlot[n][k]] + start + _neighborOffset[n][k];
+	}
+	for (int col = 0; col < _cols; col++) {
+	    GrayscalePixelType dt = cur[col];
+	    if (dt == unknown) {
+		for (int k = 0; k < neighborCount; k++) {
+		    if (neighbors[k][col] != unknown) {
+			dt = value;
+			break;
+		    }
+		}
+		if (dt == unknown)
+		    unknownCount++;
+	    }
+	    out[col] = dt;
+	}
+    }
+    return unknownCount;
+}
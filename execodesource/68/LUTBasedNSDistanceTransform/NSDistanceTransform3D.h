@@ -0,0 +1,144 @@
+// This file is part of LUTBasedNSDistanceTransform.
+//
+// LUTBasedNSDistanceTransform is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// LUTBasedNSDistanceTransform is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// LUTBasedNSDistanceTransform.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+ * @file NSDistanceTransform3D.h
+ *
+ * @brief Streaming distance transform of 3D neighborhood-sequence distances.
+ *
+ * This file is part of LUTBasedNSDistanceTransform.
+ */
+
+#ifndef NS_DISTANCE_TRANSFORM_3D_H
+#define NS_DISTANCE_TRANSFORM_3D_H
+
+#include <stddef.h>
+
+#include "VolumeFilter.h"
+
+/**
+ * @brief 3D neighborhood-sequence distance transform.
+ *
+ * NSDistanceTransform3D is a VolumeFilter that computes the (centered)
+ * distance transform of a 3D neighborhood-sequence distance. The sequence
+ * is periodic, made of neighborhoods 1 (6-neighborhood), 2
+ * (18-neighborhood) and 3 (26-neighborhood). As in 2D, the points outside
+ * the volume belong to the background.
+ *
+ * The set of points at distance at most @f$k@f$ from the background
+ * @f$\bar X@f$ is the dilation of the set at distance at most @f$k-1@f$ by
+ * the @f$k@f$-th neighborhood of the sequence:
+ * @f{equation}{
+ *   \{p, DT_X(p)\le k\}=\{p, DT_X(p)\le k-1\}\oplus\big(\mathcal N_{B(k)}\cup\{0\}\big)\;.
+ * @f}
+ * The filter chains one dilation stage per distance value. Stage @f$k@f$
+ * only needs the previous, current and next slices of its input to
+ * produce a slice, so it keeps three slices and delays the volume by one
+ * slice. A centered result slice is final, and sent to the next consumer,
+ * as soon as it leaves the last stage, @f$d_{max}@f$ slices after the
+ * corresponding input slice. The memory used is
+ * @f$3 d_{max}@f$ slices, where @f$d_{max}@f$ is bounded by the maximal
+ * distance value and half the smallest dimension of the volume.
+ *
+ * The distance transform values are clamped to the upper bound #_dMax.
+ */
+class NSDistanceTransform3D: public VolumeFilter<BinaryPixelType, GrayscalePixelType> {
+public:
+    /**
+     * @brief Construct a NSDistanceTransform3D.
+     *
+     * @param consumer the next consumer in the filter chain.
+     * @param period length of Bvalues.
+     * @param Bvalues a period of the neighborhood sequence (values 1, 2 and
+     * 3).
+     * @param dMax maximal value of the distance transform. Output distance
+     * values are saturated to this value. When \p dMax is 0, the distance
+     * is bounded by #GRAYSCALE_MAX.
+     */
+    NSDistanceTransform3D(VolumeConsumer<GrayscalePixelType>* consumer, int period, const int *Bvalues, GrayscalePixelType dMax = 0);
+    ~NSDistanceTransform3D();
+
+    void beginOfVolume(int cols, int rows, int slices);
+    /**
+     * @brief Process one slice of a binary volume (voxels equal to 0 are
+     * out of the set, other ones in the set).
+     */
+    void processSlice(const BinaryPixelType *inputSlice);
+    void endOfVolume();
+
+    /**
+     * @return the number of dilation stages (and the delay in slices) used
+     * for the current volume.
+     */
+    int stageCount() const { return _stageCount; }
+
+protected:
+    /**
+     * Value of the voxels not reached yet by the dilations.
+     */
+    static const GrayscalePixelType unknown = (GrayscalePixelType) GRAYSCALE_MAX;
+
+    /**
+     * Push the slice stored in the next slot of \p stage through the
+     * stages, as far as possible.
+     */
+    void pushSlice(int stage);
+    /**
+     * Compute one output slice of \p stage from its previous, current and
+     * next input slices.
+     * @return the number of voxels still unknown in the output slice.
+     */
+    int dilate(int stage, GrayscalePixelType *const *slots, GrayscalePixelType *output) const;
+
+    const int _period;
+    int *_B;
+    /**
+     * Upper bound of the distance transform value (output distance values
+     * are saturated to this value).
+     */
+    const GrayscalePixelType _dMax;
+
+    bool _inited;
+    int _cols;
+    int _rows;
+    int _slices;
+    /** Number of dilation stages of the current volume. */
+    int _stageCount;
+    /** Number of slices sent to the next consumer. */
+    int _outputCount;
+    /** Size of a slice with its one voxel margin. */
+    size_t _sliceSize;
+    /** Size of the allocated slices and number of stages they serve. */
+    size_t _allocatedSliceSize;
+    int _allocatedStages;
+
+    /**
+     * Slots of the stages: previous, current and next input slice of each
+     * stage, followed by the output of the last stage.
+     */
+    GrayscalePixelType **_slots;
+    /** Number of unknown voxels in each slot. */
+    int *_unknownCounts;
+    /** Number of slices received by each stage. */
+    int *_received;
+    GrayscalePixelType *_outputSlice;
+
+    /** Offsets of the neighbors of the neighborhoods 1, 2 and 3. */
+    int _neighborCount[3];
+    int _neighborSlot[3][26];
+    ptrdiff_t _neighborOffset[3][26];
+};
+
+#endif
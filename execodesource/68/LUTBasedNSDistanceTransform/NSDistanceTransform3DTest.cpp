@@ -0,0 +1,224 @@
+// This file is part of LUTBasedNSDistanceTransform.
+//
+// LUTBasedNSDistanceTransform is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// LUTBasedNSDistanceTransform is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// LUTBasedNSDistanceTransform.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+ * @file NSDistanceTransform3DTest.cpp
+ *
+ * Compares the 2D and 3D streaming distance transforms with a brute force
+ * computation of the neighborhood-sequence distance to the background.
+ *
+ * This file is part of LUTBasedNSDistanceTransform.
+ */
+
+#include <assert.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "NSDistanceTransform.h"
+#include "NSDistanceTransform3D.h"
+#include "PeriodicNSDistanceDT.h"
+
+/**
+ * Neighborhood-sequence distance from the origin to a point of dimension
+ * \p n: the smallest k such that, for the l largest absolute coordinates,
+ * their sum does not exceed the sum of min(B(i), l) for i in 1..k.
+ */
+int nsDistance(int n, const int *point, int period, const int *B) {
+    int x[3];
+    for (int i = 0; i < n; i++)
+	x[i] = abs(point[i]);
+    std::sort(x, x + n);
+    std::reverse(x, x + n);
+
+    int k = 0;
+    int sums[3] = {0, 0, 0};
+    for (;;) {
+	bool reached = true;
+	int partial = 0;
+	for (int l = 0; l < n; l++) {
+	    partial += x[l];
+	    if (partial > sums[l])
+		reached = false;
+	}
+	if (reached)
+	    return k;
+	for (int l = 0; l < n; l++)
+	    sums[l] += std::min(B[k % period], l + 1);
+	k++;
+    }
+}
+
+/**
+ * Brute force distance transform of a volume (slices = 1 for a 2D image,
+ * then \p n = 2). The points outside the volume are in the background: one
+ * margin of background voxels is enough since the distance grows with the
+ * absolute value of each coordinate.
+ */
+std::vector<int> bruteForce(int n, const std::vector<BinaryPixelType> &volume,
+			    int cols, int rows, int slices,
+			    int period, const int *B, int dMax) {
+    std::vector<int> result(volume.size());
+    int zMin = n == 3 ? -1 : 0;
+    int zMax = n == 3 ? slices : 0;
+
+    for (int z = 0; z < slices; z++)
+	for (int y = 0; y < rows; y++)
+	    for (int x = 0; x < cols; x++) {
+		int best = INT_MAX;
+		for (int qz = zMin; qz <= zMax; qz++)
+		    for (int qy = -1; qy <= rows; qy++)
+			for (int qx = -1; qx <= cols; qx++) {
+			    bool inside = qx >= 0 && qx < cols && qy >= 0 && qy < rows && qz >= 0 && qz < slices;
+			    if (inside && volume[((size_t) qz * rows + qy) * cols + qx] != 0)
+				continue;
+			    int v[3] = {x - qx, y - qy, z - qz};
+			    best = std::min(best, nsDistance(n, v, period, B));
+			}
+		result[((size_t) z * rows + y) * cols + x] = std::min(best, dMax);
+	    }
+    return result;
+}
+
+/**
+ * VolumeConsumer that keeps a copy of the volume it receives.
+ */
+class VolumeCollector: public VolumeConsumer<GrayscalePixelType> {
+public:
+    VolumeCollector(std::vector<GrayscalePixelType> &voxels) : _voxels(voxels), _sliceSize(0) {}
+
+    void beginOfVolume(int cols, int rows, int /*slices*/) {
+	_voxels.clear();
+	_sliceSize = (size_t) cols * rows;
+    }
+    void processSlice(const GrayscalePixelType *inputSlice) {
+	_voxels.insert(_voxels.end(), inputSlice, inputSlice + _sliceSize);
+    }
+    void endOfVolume() {}
+
+private:
+    std::vector<GrayscalePixelType> &_voxels;
+    size_t _sliceSize;
+};
+
+std::vector<BinaryPixelType> randomVolume(int size, int backgroundPercent) {
+    std::vector<BinaryPixelType> volume(size);
+    for (int i = 0; i < size; i++)
+	volume[i] = rand() % 100 < backgroundPercent ? 0 : 1;
+    return volume;
+}
+
+int test3D(NSDistanceTransform3D &dt, std::vector<GrayscalePixelType> &voxels,
+	   int cols, int rows, int slices, int backgroundPercent,
+	   int period, const int *B, int dMax) {
+    std::vector<BinaryPixelType> volume = randomVolume(cols * rows * slices, backgroundPercent);
+
+    dt.beginOfVolume(cols, rows, slices);
+    for (int z = 0; z < slices; z++)
+	dt.processSlice(&volume[(size_t) z * rows * cols]);
+    dt.endOfVolume();
+
+    std::vector<int> expected = bruteForce(3, volume, cols, rows, slices, period, B, dMax == 0 ? GRAYSCALE_MAX : dMax);
+    int errors = 0;
+    for (size_t i = 0; i < expected.size(); i++) {
+	if (voxels[i] != expected[i])
+	    errors++;
+    }
+    printf("3D %2dx%2dx%2d, %2d%% background, dMax %d, %d stages: %d errors\n",
+	   cols, rows, slices, backgroundPercent, dMax, dt.stageCount(), errors);
+    return errors;
+}
+
+int testSequence3D(int period, const int *B) {
+    int errors = 0;
+
+    printf("Sequence:");
+    for (int i = 0; i < period; i++)
+	printf(" %d", B[i]);
+    printf("\n");
+
+    for (int dMax = 0; dMax <= 2; dMax += 2) {
+	std::vector<GrayscalePixelType> voxels;
+	// The same filter processes several volumes
+	NSDistanceTransform3D dt(new VolumeCollector(voxels), period, B, dMax);
+	errors += test3D(dt, voxels, 9, 8, 7, 3, period, B, dMax);
+	errors += test3D(dt, voxels, 16, 13, 15, 1, period, B, dMax);
+	errors += test3D(dt, voxels, 5, 6, 1, 10, period, B, dMax);
+	errors += test3D(dt, voxels, 12, 12, 12, 0, period, B, dMax);
+	errors += test3D(dt, voxels, 20, 3, 11, 20, period, B, dMax);
+    }
+    return errors;
+}
+
+/**
+ * Checks the brute force distance against the 2D streaming transform.
+ */
+int testSequence2D(int period, const int *B) {
+    const int cols = 23, rows = 17;
+    int errors = 0;
+
+    for (int backgroundPercent = 0; backgroundPercent <= 4; backgroundPercent += 2) {
+	std::vector<BinaryPixelType> image = randomVolume(cols * rows, backgroundPercent);
+	std::vector<GrayscalePixelType> result(cols * rows);
+	int *sequence = (int *) malloc(period * sizeof(int));
+	std::copy(B, B + period, sequence);
+	NSDistanceTransform<> dt(new PeriodicNSDistance<GrayscalePixelType>(period, sequence), true);
+	free(sequence);
+	dt.transform(&image[0], cols, rows, &result[0]);
+
+	std::vector<int> expected = bruteForce(2, image, cols, rows, 1, period, B, GRAYSCALE_MAX);
+	int imageErrors = 0;
+	for (size_t i = 0; i < expected.size(); i++) {
+	    if (result[i] != expected[i])
+		imageErrors++;
+	}
+	printf("2D %dx%d, %d%% background: %d errors\n", cols, rows, backgroundPercent, imageErrors);
+	errors += imageErrors;
+    }
+    return errors;
+}
+
+int main() {
+    int errors = 0;
+
+    int seq12[] = {1, 2};
+    int seq112[] = {1, 1, 2};
+    int seq1222[] = {1, 2, 2, 2};
+    errors += testSequence2D(2, seq12);
+    errors += testSequence2D(3, seq112);
+    errors += testSequence2D(4, seq1222);
+
+    int seq1[] = {1};
+    int seq2[] = {2};
+    int seq3[] = {3};
+    int seq13[] = {1, 3};
+    int seq123[] = {1, 2, 3};
+    int seq3112[] = {3, 1, 1, 2};
+    errors += testSequence3D(1, seq1);
+    errors += testSequence3D(1, seq2);
+    errors += testSequence3D(1, seq3);
+    errors += testSequence3D(2, seq12);
+    errors += testSequence3D(2, seq13);
+    errors += testSequence3D(3, seq123);
+    errors += testSequence3D(4, seq3112);
+
+    printf("%d errors\n", errors);
+    assert(errors == 0);
+
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,119 @@
+// This file is part of LUTBasedNSDistanceTransform.
+//
+// LUTBasedNSDistanceTransform is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// LUTBasedNSDistanceTransform is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// LUTBasedNSDistanceTransform.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+ * @file NSDistanceTransformBenchmark.cpp
+ *
+ * Times the 2D distance transform with 8- and 16-bit pixels on large random
+ * images, and checks that both widths give the same distance values
+ * (saturated to 255 for 8-bit pixels).
+ *
+ * Usage: NSDistanceTransformBenchmark [cols rows [repetitions]]
+ *
+ * This file is part of LUTBasedNSDistanceTransform.
+ */
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "NSDistanceTransform.h"
+
+/**
+ * Random binary image whose background points are spread with a density of
+ * one per \p spacing x \p spacing pixels.
+ */
+std::vector<BinaryPixelType> randomImage(int cols, int rows, int spacing) {
+    std::vector<BinaryPixelType> image((size_t) cols * rows, 1);
+    size_t count = (size_t) cols * rows / ((size_t) spacing * spacing);
+    for (size_t i = 0; i < count; i++)
+	image[(size_t) (rand() % rows) * cols + rand() % cols] = 0;
+    return image;
+}
+
+/**
+ * Computes the centered distance transform of \p image \p repetitions times
+ * with pixels of type \p outputPixelType.
+ * @return the time of one transform, in milliseconds.
+ */
+template <typename outputPixelType>
+double timeTransform(DistanceType type, const char *spec,
+		     const std::vector<BinaryPixelType> &image, int cols, int rows,
+		     int repetitions, std::vector<outputPixelType> &result) {
+    NSDistanceTransform<outputPixelType> dt(createDistance<outputPixelType>(type, spec), true);
+    result.resize(image.size());
+    // The first transform allocates the buffers
+    dt.transform(&image[0], cols, rows, &result[0]);
+    clock_t start = clock();
+    for (int i = 0; i < repetitions; i++)
+	dt.transform(&image[0], cols, rows, &result[0]);
+    return 1000.0 * (clock() - start) / CLOCKS_PER_SEC / repetitions;
+}
+
+int benchmark(DistanceType type, const char *spec, int cols, int rows, int spacing, int repetitions) {
+    std::vector<BinaryPixelType> image = randomImage(cols, rows, spacing);
+    std::vector<Grayscale8PixelType> result8;
+    std::vector<Grayscale16PixelType> result16;
+
+    double time8 = timeTransform(type, spec, image, cols, rows, repetitions, result8);
+    double time16 = timeTransform(type, spec, image, cols, rows, repetitions, result16);
+
+    int errors = 0;
+    int maxValue = 0;
+    for (size_t i = 0; i < image.size(); i++) {
+	maxValue = std::max(maxValue, (int) result16[i]);
+	if (result8[i] != std::min((int) result16[i], grayscaleMax<Grayscale8PixelType>()))
+	    errors++;
+    }
+
+    printf("%-8s %5dx%-5d spacing %4d, max %5d, auto %2d bits: 8 bits %7.2f ms, 16 bits %7.2f ms, %d errors\n",
+	   spec, cols, rows, spacing, maxValue, pixelWidthFor(cols, rows),
+	   time8, time16, errors);
+    return errors;
+}
+
+int main(int argc, char** argv) {
+    int cols = 2048, rows = 2048, repetitions = 5;
+    if (argc >= 3) {
+	cols = atoi(argv[1]);
+	rows = atoi(argv[2]);
+    }
+    if (argc >= 4)
+	repetitions = atoi(argv[3]);
+    if (cols <= 0 || rows <= 0 || repetitions <= 0) {
+	fprintf(stderr, "Usage: NSDistanceTransformBenchmark [cols rows [repetitions]]\n");
+	return 1;
+    }
+
+    int errors = 0;
+    // Distance values fit in 8 bits with dense background points and
+    // exceed 255 with sparse ones
+    const int spacings[] = {16, 512};
+    for (int i = 0; i < 2; i++) {
+	errors += benchmark(d4, "d4", cols, rows, spacings[i], repetitions);
+	errors += benchmark(d8, "d8", cols, rows, spacings[i], repetitions);
+	errors += benchmark(ratioDefined, "1/2", cols, rows, spacings[i], repetitions);
+	errors += benchmark(sequenceDefined, "1 1 2", cols, rows, spacings[i], repetitions);
+    }
+
+    printf("%d errors\n", errors);
+    assert(errors == 0);
+
+    return errors == 0 ? 0 : 1;
+}
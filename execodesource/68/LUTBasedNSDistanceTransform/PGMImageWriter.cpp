@@ -20,7 +20,8 @@
 #include "PGMImageWriter.h"
 #include <string.h>
 
-PGMImageWriter::PGMImageWriter(FILE* output, int format) :
+template <typename outputPixelType>
+PGMImageWriter<outputPixelType>::PGMImageWriter(FILE* output, int format) :
 _cols(0),
 _format(format),
 _output(output) {
@@ -31,14 +32,15 @@ _output(output) {
     _outpam.plainformat = 1;
 }
 
+template <typename outputPixelType>
 void
-PGMImageWriter::beginOfImage(int cols, int rows) {
+PGMImageWriter<outputPixelType>::beginOfImage(int cols, int rows) {
     _cols = cols;
     _outpam.height	         = rows;
     _outpam.width	         = cols;
     _outpam.depth            = 1;
-    _outpam.maxval           = 255;
-    _outpam.bytes_per_sample = 1;
+    _outpam.maxval           = sizeof(outputPixelType) == 1 ? 255 : 65535;
+    _outpam.bytes_per_sample = sizeof(outputPixelType) == 1 ? 1 : 2;
     strncpy(_outpam.tuple_type, PAM_PGM_TUPLETYPE, sizeof(_outpam.tuple_type));
     // EDIT BK 12/12 existe pas dans la version ipol (marche sans on dirait
     //_outpam.allocation_depth = sizeof(GrayscalePixelType);
@@ -50,18 +52,22 @@ PGMImageWriter::beginOfImage(int cols, int rows) {
     //pgm_writepgminit(_output, cols, rows, 255, _format);
 }
 
+template <typename outputPixelType>
 void
-PGMImageWriter::endOfImage() {
+PGMImageWriter<outputPixelType>::endOfImage() {
     pnm_freepamrow(_tuplerow);
     _tuplerow = NULL;
 }
 
+template <typename outputPixelType>
 void
-PGMImageWriter::processRow(const GrayscalePixelType* inputRow) {
-    // FIXME: type mismatch, change to pgm
+PGMImageWriter<outputPixelType>::processRow(const outputPixelType* inputRow) {
     for (int column = 0; column < _outpam.width; ++column) {
 	_tuplerow[column][0] = inputRow[column];
     }
     pnm_writepamrow(&_outpam, _tuplerow);
     //pgm_writepgmrow(_output, inputRow, _cols, 255, _format);
 }
+
+template class PGMImageWriter<Grayscale8PixelType>;
+template class PGMImageWriter<Grayscale16PixelType>;
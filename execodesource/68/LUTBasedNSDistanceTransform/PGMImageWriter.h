@@ -27,12 +27,17 @@ extern "C" {
 
 #include "ImageFilter.h"
 
-class PGMImageWriter : public ImageConsumer<GrayscalePixelType> {
+/**
+ * Writes 8-bit pixels as PGM images of maxval 255 and 16-bit pixels as PGM
+ * images of maxval 65535.
+ */
+template <typename outputPixelType>
+class PGMImageWriter : public ImageConsumer<outputPixelType> {
 public:
     PGMImageWriter(FILE* output, int format = 0);
 
     void beginOfImage(int cols, int rows);
-    void processRow(const GrayscalePixelType* inputRow);
+    void processRow(const outputPixelType* inputRow);
     void endOfImage();
 
 protected:
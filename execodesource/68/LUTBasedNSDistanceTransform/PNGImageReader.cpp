@@ -112,4 +112,5 @@ void PNGImageReader::produceAllRows(size_t readBytes) {
     free(_inputRow);
     _inputRow = NULL;
     png_read_end(_png_ptr, NULL);
+    png_destroy_read_struct(&_png_ptr, &_info_ptr, (png_infopp)NULL);
 }
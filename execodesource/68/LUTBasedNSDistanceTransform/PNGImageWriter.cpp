@@ -24,12 +24,16 @@
 
 #include "PNGImageWriter.h"
 
-PNGImageWriter::PNGImageWriter(FILE* output, bool lineBuffered) :
+template <typename outputPixelType>
+PNGImageWriter<outputPixelType>::PNGImageWriter(FILE* output, bool lineBuffered) :
 _output(output),
 _lineBuffered(lineBuffered) {
 }
 
-void PNGImageWriter::beginOfImage(int cols, int rows) {
+template <typename outputPixelType>
+void PNGImageWriter<outputPixelType>::beginOfImage(int cols, int rows) {
+    const int bitDepth = sizeof(outputPixelType) == 1 ? 8 : 16;
+
     _png_ptr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
 
     _info_ptr = png_create_info_struct(_png_ptr);
@@ -42,7 +46,7 @@ void PNGImageWriter::beginOfImage(int cols, int rows) {
 		 _info_ptr,
 		 cols,
 		 rows,
-		 16,
+		 bitDepth,
 		 PNG_COLOR_TYPE_GRAY,
 		 PNG_INTERLACE_NONE,
 		 NULL/*PNG_COMPRESSION_TYPE_DEFAULT*/,
@@ -53,7 +57,7 @@ void PNGImageWriter::beginOfImage(int cols, int rows) {
     png_set_filter(_png_ptr, 0 /* method */, PNG_NO_FILTERS);
 
     png_color_8 sig_bit;
-    sig_bit.gray  = 16;
+    sig_bit.gray  = bitDepth;
     sig_bit.red   = 0;
     sig_bit.green = 0;
     sig_bit.blue  = 0;
@@ -82,7 +86,8 @@ void PNGImageWriter::beginOfImage(int cols, int rows) {
     png_write_info(_png_ptr, _info_ptr);
 }
 
-void PNGImageWriter::processRow(const GrayscalePixelType* inputRow) {
+template <typename outputPixelType>
+void PNGImageWriter<outputPixelType>::processRow(const outputPixelType* inputRow) {
     if (setjmp(png_jmpbuf(_png_ptr))) {
 	png_destroy_write_struct(&_png_ptr, &_info_ptr);
 	fprintf(stderr, "Error during PNGImageWriter::processRow\n");
@@ -93,7 +98,11 @@ void PNGImageWriter::processRow(const GrayscalePixelType* inputRow) {
     //png_write_flush(_png_ptr);
 }
 
-void PNGImageWriter::endOfImage() {
+template <typename outputPixelType>
+void PNGImageWriter<outputPixelType>::endOfImage() {
     png_write_end(_png_ptr, _info_ptr);
     png_destroy_write_struct(&_png_ptr, &_info_ptr);
 }
+
+template class PNGImageWriter<Grayscale8PixelType>;
+template class PNGImageWriter<Grayscale16PixelType>;
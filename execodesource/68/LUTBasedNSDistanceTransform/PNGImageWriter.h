@@ -25,7 +25,12 @@
 #include "ImageFilter.h"
 #include <png.h>
 
-class PNGImageWriter : public ImageConsumer<GrayscalePixelType> {
+/**
+ * Writes 8-bit pixels as 8-bit PNG images and 16-bit pixels as 16-bit PNG
+ * images.
+ */
+template <typename outputPixelType>
+class PNGImageWriter : public ImageConsumer<outputPixelType> {
 public:
     PNGImageWriter(FILE* output, bool lineBuffered = false);
 
@@ -33,7 +38,7 @@ public:
 
     void endOfImage();
 
-    void processRow(const GrayscalePixelType* inputRow);
+    void processRow(const outputPixelType* inputRow);
 
 protected:
     png_structp _png_ptr;
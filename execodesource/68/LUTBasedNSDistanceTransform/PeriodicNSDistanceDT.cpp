@@ -23,21 +23,26 @@
 #include <algorithm>
 
 #include "PeriodicNSDistanceDT.h"
+#include "MedialAxis.h"
 #include "CumulativeSequence.h"
 
-int PeriodicNSDistance::countOf2(int r) const {
+template <typename outputPixelType>
+int PeriodicNSDistance<outputPixelType>::countOf2(int r) const {
     return mathbf2d[r % period] + (((r + period - 1) / period) - 1) * mathbf2d[0];
 }
 
-inline GrayscalePixelType PeriodicNSDistance::next1(int r) const {
+template <typename outputPixelType>
+inline int PeriodicNSDistance<outputPixelType>::next1(int r) const {
     return r + c1[r % period];
 }
 
-inline GrayscalePixelType PeriodicNSDistance::next2(int r) const {
+template <typename outputPixelType>
+inline int PeriodicNSDistance<outputPixelType>::next2(int r) const {
     return r + c2[r % period];
 }
 
-PeriodicNSDistance::PeriodicNSDistance(int period, int *Bvalues, GrayscalePixelType dMax) :
+template <typename outputPixelType>
+PeriodicNSDistance<outputPixelType>::PeriodicNSDistance(int period, int *Bvalues, int dMax) :
     _dMax(dMax),
     period(period) {
 
@@ -99,19 +104,33 @@ PeriodicNSDistance::PeriodicNSDistance(int period, int *Bvalues, GrayscalePixelT
     CumulativeOfPeriodicSequenceFree(mathbf2_Binv);
 }
 
-PeriodicNSDistance::~PeriodicNSDistance() {
+template <typename outputPixelType>
+PeriodicNSDistance<outputPixelType>::~PeriodicNSDistance() {
     free(c1);
 }
 
-BaseDistanceTransform* PeriodicNSDistance::newTranslatedDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer) const {
-    return new PeriodicNSDistanceTransform(consumer, this, _dMax);
+template <typename outputPixelType>
+BaseDistanceTransform<outputPixelType>* PeriodicNSDistance<outputPixelType>::newTranslatedDistanceTransform(ImageConsumer<outputPixelType>* consumer) const {
+    return new PeriodicNSDistanceTransform<outputPixelType>(consumer, this, _dMax);
 }
 
-DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType>* PeriodicNSDistance::newDistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer) const {
-    return new PeriodicNSDistanceTransformUntranslator(consumer, this, _dMax);
+template <typename outputPixelType>
+DistanceTransformUntranslator<outputPixelType, outputPixelType>* PeriodicNSDistance<outputPixelType>::newDistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer) const {
+    return new PeriodicNSDistanceTransformUntranslator<outputPixelType>(consumer, this, _dMax);
 }
 
-void PeriodicNSDistanceTransform::processRow(const BinaryPixelType *imageRow) {
+template <typename outputPixelType>
+ImageFilter<outputPixelType, outputPixelType>* PeriodicNSDistance<outputPixelType>::newMedialAxisExtractor(ImageConsumer<outputPixelType>* consumer) const {
+    return new MedialAxisExtractor<outputPixelType>(consumer, this, _dMax);
+}
+
+template <typename outputPixelType>
+ImageFilter<outputPixelType, outputPixelType>* PeriodicNSDistance<outputPixelType>::newReverseDistanceTransform(ImageConsumer<outputPixelType>* consumer) const {
+    return new ReverseDistanceTransform<outputPixelType>(consumer, this, _dMax);
+}
+
+template <typename outputPixelType>
+void PeriodicNSDistanceTransform<outputPixelType>::processRow(const BinaryPixelType *imageRow) {
     int col;
 #define N1_SETMINUS_N2_COUNT  1
 #define N2_SETMINUS_N1_COUNT  5
@@ -124,11 +143,11 @@ void PeriodicNSDistanceTransform::processRow(const BinaryPixelType *imageRow) {
 	if (imageRow[col] == 0)
 	    dtLines[0][col + 2] = 0;
 	else {
-	    GrayscalePixelType val;
-	    GrayscalePixelType dt;
+	    outputPixelType val;
+	    outputPixelType dt;
 	    int k;
 
-	    val = GRAYSCALE_MAX;
+	    val = grayscaleMax<outputPixelType>();
 	    for (k = 0; k < N1_SETMINUS_N2_COUNT; k++) {
 		assert(n1[k].y >= 0);
 		assert(n1[k].y <= 2);
@@ -136,9 +155,9 @@ void PeriodicNSDistanceTransform::processRow(const BinaryPixelType *imageRow) {
 		assert(col + 2 - n1[k].x < _cols + 3);
 		val = std::min(val, dtLines[n1[k].y][col + 2 - n1[k].x]);
 	    }
-	    dt = std::min(_dMax, _d->next1(val));
+	    dt = std::min((int) _dMax, _d->next1(val));
 
-	    val = GRAYSCALE_MAX;
+	    val = grayscaleMax<outputPixelType>();
 	    for (k = 0; k < N2_SETMINUS_N1_COUNT; k++) {
 		assert(n2[k].y >= 0);
 		assert(n2[k].y <= 2);
@@ -146,9 +165,9 @@ void PeriodicNSDistanceTransform::processRow(const BinaryPixelType *imageRow) {
 		assert(col + 2 - n2[k].x < _cols + 3);
 		val = std::min(val, dtLines[n2[k].y][col + 2 - n2[k].x]);
 	    }
-	    dt = std::min(dt, _d->next2(val));
+	    dt = std::min((int) dt, _d->next2(val));
 
-	    val = GRAYSCALE_MAX;
+	    val = grayscaleMax<outputPixelType>();
 	    for (k = 0; k < N1_CAP_N2_COUNT; k++) {
 		assert(n12[k].y >= 0);
 		assert(n12[k].y <= 2);
@@ -156,7 +175,7 @@ void PeriodicNSDistanceTransform::processRow(const BinaryPixelType *imageRow) {
 		assert(col + 2 - n12[k].x < _cols + 3);
 		val = std::min(val, dtLines[n12[k].y][col + 2 - n12[k].x]);
 	    }
-	    dt = std::min((int) dt, val + 1);
+	    dt = std::min((int) dt, (int) val + 1);
 
 	    dtLines[0][col + 2] = dt;
 	}
@@ -165,25 +184,30 @@ void PeriodicNSDistanceTransform::processRow(const BinaryPixelType *imageRow) {
     rotate();
 }
 
-PeriodicNSDistanceTransform::PeriodicNSDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer, const PeriodicNSDistance *d, GrayscalePixelType dMax) :
-    BaseDistanceTransform(consumer),
-    _dMax(dMax == 0 ? GRAYSCALE_MAX : dMax),
+template <typename outputPixelType>
+PeriodicNSDistanceTransform<outputPixelType>::PeriodicNSDistanceTransform(ImageConsumer<outputPixelType>* consumer, const PeriodicNSDistance<outputPixelType> *d, int dMax) :
+    BaseDistanceTransform<outputPixelType>(consumer),
+    _dMax(boundedDMax<outputPixelType>(dMax)),
     _d(d) {
 }
 
-PeriodicNSDistanceTransform::~PeriodicNSDistanceTransform() {
+template <typename outputPixelType>
+PeriodicNSDistanceTransform<outputPixelType>::~PeriodicNSDistanceTransform() {
 }
 							 
-PeriodicNSDistanceTransformUntranslator::PeriodicNSDistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer, const PeriodicNSDistance *d, GrayscalePixelType dMax) :
+template <typename outputPixelType>
+PeriodicNSDistanceTransformUntranslator<outputPixelType>::PeriodicNSDistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer, const PeriodicNSDistance<outputPixelType> *d, int dMax) :
     super(consumer, marginRight),
-    _dMax(dMax == 0 ? GRAYSCALE_MAX : dMax),
+    _dMax(boundedDMax<outputPixelType>(dMax)),
     _d(d) {
 }
 
-PeriodicNSDistanceTransformUntranslator::~PeriodicNSDistanceTransformUntranslator() {
+template <typename outputPixelType>
+PeriodicNSDistanceTransformUntranslator<outputPixelType>::~PeriodicNSDistanceTransformUntranslator() {
 }
 
-void PeriodicNSDistanceTransformUntranslator::beginOfImage(int cols, int rows) {
+template <typename outputPixelType>
+void PeriodicNSDistanceTransformUntranslator<outputPixelType>::beginOfImage(int cols, int rows) {
     int imageDMax = _dMax;
     imageDMax = std::min(imageDMax, (cols + 1) / 2);
     imageDMax = std::min(imageDMax, (rows + 1) / 2);
@@ -192,7 +216,8 @@ void PeriodicNSDistanceTransformUntranslator::beginOfImage(int cols, int rows) {
 
 // Called once for each row of the input image, plus one extra time
 // with null-valued translated DT to flush all DT values
-void PeriodicNSDistanceTransformUntranslator::processRow(const GrayscalePixelType* inputRow) {
+template <typename outputPixelType>
+void PeriodicNSDistanceTransformUntranslator<outputPixelType>::processRow(const outputPixelType* inputRow) {
     int dtmax = 1;  // Not 0 to avoid outputing the extra row
 
     super::processRow(inputRow);
@@ -203,7 +228,7 @@ void PeriodicNSDistanceTransformUntranslator::processRow(const GrayscalePixelTyp
 
 	dtp = _tdtRows[1][col];
 	if (_tdtRows[0][col] == 0) {
-	    assert(_outputRows[(_curRow + _dtRowCount) % _dtRowCount][col] == (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[(_curRow + _dtRowCount) % _dtRowCount][col] == (outputPixelType) -1);
 	    _outputRows[(_curRow + _dtRowCount) % _dtRowCount][col] = 0;
 	}
 
@@ -216,7 +241,7 @@ void PeriodicNSDistanceTransformUntranslator::processRow(const GrayscalePixelTyp
 	     r = _d->next1(r)) {
 
 	    int dy = r - 1;
-	    assert(_outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] == (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] == (outputPixelType) -1);
 	    _outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] = r;
 	    dx += _d->next1(r) - r - 1;
 	}
@@ -228,7 +253,7 @@ void PeriodicNSDistanceTransformUntranslator::processRow(const GrayscalePixelTyp
 	     r = _d->next2(r)) {
 
 	    int dy = r - 1;
-	    assert(_outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] == (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] == (outputPixelType) -1);
 	    _outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] = r;
 	    dx++;
 	}
@@ -238,9 +263,16 @@ void PeriodicNSDistanceTransformUntranslator::processRow(const GrayscalePixelTyp
 	_consumer->processRow(_outputRows[_outRow % _dtRowCount]);
 #ifndef NDEBUG
 	for (int col = 0; col < _cols; col++) {
-	    assert(_outputRows[_outRow % _dtRowCount][col] != (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[_outRow % _dtRowCount][col] != (outputPixelType) -1);
 	    _outputRows[_outRow % _dtRowCount][col] = -1;
 	}
 #endif
     }
 }
+
+template class PeriodicNSDistance<Grayscale8PixelType>;
+template class PeriodicNSDistance<Grayscale16PixelType>;
+template class PeriodicNSDistanceTransform<Grayscale8PixelType>;
+template class PeriodicNSDistanceTransform<Grayscale16PixelType>;
+template class PeriodicNSDistanceTransformUntranslator<Grayscale8PixelType>;
+template class PeriodicNSDistanceTransformUntranslator<Grayscale16PixelType>;
@@ -37,7 +37,8 @@
  * neighborhood-sequence distances defined by a periodic sequence:
  * PeriodicNSDistanceTransform and PeriodicNSDistanceTransformUntranslator.
  */
-class PeriodicNSDistance: public BaseDistance {
+template <typename outputPixelType>
+class PeriodicNSDistance: public BaseDistance<outputPixelType> {
 public:
     /**
      * Construct a filter factory for a neighborhood-sequence distance
@@ -59,20 +60,32 @@ public:
      * as \em 8-neighborhood). The octagonal distance can be constructed
      * with \p period = 2 and \p Bvalues = {1,2}.
      */
-    PeriodicNSDistance(int period, int *Bvalues, GrayscalePixelType dMax = 0);
+    PeriodicNSDistance(int period, int *Bvalues, int dMax = 0);
     ~PeriodicNSDistance();
     /**
      * @brief create a distance transform ImageFilter for a translated
      * neighborhood-sequence distance.
      * @return an instance of PeriodicNSDistanceTransform.
      */
-    BaseDistanceTransform* newTranslatedDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer) const;
+    BaseDistanceTransform<outputPixelType>* newTranslatedDistanceTransform(ImageConsumer<outputPixelType>* consumer) const;
     /**
      * @brief create an ImageFilter to recenter the translated distance
      * transform of a neighborhood-sequence distance.
      * @return an instance of PeriodicNSDistanceTransformUntranslator.
      */
-    DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType>* newDistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer) const;
+    DistanceTransformUntranslator<outputPixelType, outputPixelType>* newDistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer) const;
+    /**
+     * @brief create an ImageFilter that extracts the centers of maximal
+     * disks from the regular distance transform.
+     * @return an instance of MedialAxisExtractor.
+     */
+    ImageFilter<outputPixelType, outputPixelType>* newMedialAxisExtractor(ImageConsumer<outputPixelType>* consumer) const;
+    /**
+     * @brief create an ImageFilter that computes the union of the disks
+     * given by their radii.
+     * @return an instance of ReverseDistanceTransform.
+     */
+    ImageFilter<outputPixelType, outputPixelType>* newReverseDistanceTransform(ImageConsumer<outputPixelType>* consumer) const;
 
     /**
      * @return number of occurrences of 2 in the sequence between indices 1
@@ -85,17 +98,17 @@ public:
      * neighborhood 1 only (@f$\vec v\in\mathcal{N}'_1\text{ and }\vec
      * v\not\in\mathcal{N}'_2@f$).
      */
-    GrayscalePixelType next1(int r) const;
+    int next1(int r) const;
     /**
      * @return index of the next occurrence of 2 in the sequence. It is also
      * the absolute cost of displacement with a vector in translated
      * neighborhood 2 only (@f$\vec v\not\in\mathcal{N}'_1\text{ and }\vec
      * v\in\mathcal{N}'_2@f$).
      */
-    GrayscalePixelType next2(int r) const;
+    int next2(int r) const;
 protected:
     const int period;
-    const GrayscalePixelType _dMax;
+    const int _dMax;
     /**
      * Stores the relative costs of displacement with a vector in translated
      * neighborhood 1 only (@f$\vec v\in\mathcal{N}'_1\text{ and }\vec
@@ -128,7 +141,8 @@ protected:
  * distance. The input image is provided one row at a time by processRow().
  * The result image is written in the next consumer in the filter chain.
  */
-class PeriodicNSDistanceTransform : public BaseDistanceTransform {
+template <typename outputPixelType>
+class PeriodicNSDistanceTransform: public BaseDistanceTransform<outputPixelType> {
 public:
     /**
      * @brief Construct a PeriodicNSDistanceTransform
@@ -136,9 +150,9 @@ public:
      * @param d a PeriodicNSDistance
      * @param dMax maximal value of the distance transform. Output distance
      * values are saturated to this value. When \p dMax is 0, the distance
-     * is bounded by #GRAYSCALE_MAX.
+     * is bounded by the maximal value of \p outputPixelType.
      */
-    PeriodicNSDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer, const PeriodicNSDistance *d, GrayscalePixelType dMax = 0);
+    PeriodicNSDistanceTransform(ImageConsumer<outputPixelType>* consumer, const PeriodicNSDistance<outputPixelType> *d, int dMax = 0);
     ~PeriodicNSDistanceTransform();
 
     /**
@@ -179,13 +193,17 @@ public:
     void processRow(const BinaryPixelType *imageRow);
 
 protected:
+    using BaseDistanceTransform<outputPixelType>::_consumer;
+    using BaseDistanceTransform<outputPixelType>::_cols;
+    using BaseDistanceTransform<outputPixelType>::dtLines;
+    using BaseDistanceTransform<outputPixelType>::rotate;
     /**
      * Upper bound of the distance transform value (output distance values
      * are saturated to this value).
      */
-    const GrayscalePixelType _dMax;
+    const outputPixelType _dMax;
     /** Distance */
-    const PeriodicNSDistance *_d;
+    const PeriodicNSDistance<outputPixelType> *_d;
 };
 
 /** @brief Periodic neighborhood-sequence distance transform untranslator.
@@ -195,7 +213,8 @@ protected:
  * distance. The input image is provided one row at a time by processRow().
  * The result image is written in the next consumer in the filter chain.
  */
-class PeriodicNSDistanceTransformUntranslator: public DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType> {
+template <typename outputPixelType>
+class PeriodicNSDistanceTransformUntranslator: public DistanceTransformUntranslator<outputPixelType, outputPixelType> {
 public:
     /**
      * @brief Construct a PeriodicNSDistanceTransformUntranslator.
@@ -204,30 +223,38 @@ public:
      * @param d a periodic neighborhood-sequence distance.
      * @param dMax maximal value of the distance transform. Input distance
      * values are assumed never to exceed this value. When \p dMax is 0, the
-     * distance is only bounded by #GRAYSCALE_MAX.
+     * distance is only bounded by the maximal value of \p outputPixelType.
      *
      * The algorithm latency (and the number of rows that have to be stored)
      * directly depends on the maximal value of the distance transform.
      * Forcing a lower value sets an upper bound on the latency and reduces
      * the allocated memory.
      */
-    PeriodicNSDistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer, const PeriodicNSDistance *d, GrayscalePixelType dMax = 0);
+    PeriodicNSDistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer, const PeriodicNSDistance<outputPixelType> *d, int dMax = 0);
     ~PeriodicNSDistanceTransformUntranslator();
 
     void beginOfImage(int cols, int rows);
-    void processRow(const GrayscalePixelType* inputRow);
+    void processRow(const outputPixelType* inputRow);
 
 protected:
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_consumer;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_cols;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_curRow;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_outRow;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_dtRowCount;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_outputRows;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_tdtRows;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_checkAssignments;
     /**
      * Upper bound of the distance transform value (input distance values
      * are assumed never to exceed #_dMax).
      */
-    const GrayscalePixelType _dMax;
+    const outputPixelType _dMax;
     /** Distance */
-    const PeriodicNSDistance *_d;
+    const PeriodicNSDistance<outputPixelType> *_d;
 
 private:
     static const int marginRight = 1;
-    typedef DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType> super;
+    typedef DistanceTransformUntranslator<outputPixelType, outputPixelType> super;
 };
 
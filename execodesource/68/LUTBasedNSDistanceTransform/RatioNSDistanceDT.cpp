@@ -23,6 +23,7 @@
 #include <algorithm>
 
 #include "RatioNSDistanceDT.h"
+#include "MedialAxis.h"
 
 #ifndef NDEBUG
 #define RBS(num, den, dir, n) (((n) * (num) - (dir) + (den)) / (den) - 1)
@@ -35,7 +36,8 @@
 #define C2(num, den, n) (MATHBF2i(num, den, MATHBF2(num, den, n) + 1) + 1)
 #endif
 
-RatioNSDistance::RatioNSDistance(int num, int den, GrayscalePixelType dMax) :
+template <typename outputPixelType>
+RatioNSDistance<outputPixelType>::RatioNSDistance(int num, int den, int dMax) :
 _dMax(dMax),
 num(num), den(den),
 mbf1(RationalBeattySeq((den - num), den, den - 1)),
@@ -57,15 +59,33 @@ mbf2i(RationalBeattySeq(num, den, 0).invert()) {
 #endif
 }
 
-BaseDistanceTransform* RatioNSDistance::newTranslatedDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer) const {
-    return new RatioNSDistanceTransform(consumer, num, den, _dMax);
+template <typename outputPixelType>
+BaseDistanceTransform<outputPixelType>* RatioNSDistance<outputPixelType>::newTranslatedDistanceTransform(ImageConsumer<outputPixelType>* consumer) const {
+    return new RatioNSDistanceTransform<outputPixelType>(consumer, num, den, _dMax);
 }
 
-DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType>* RatioNSDistance::newDistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer) const {
-    return new RatioNSDistanceTransformUntranslator(consumer, num, den, _dMax);
+template <typename outputPixelType>
+DistanceTransformUntranslator<outputPixelType, outputPixelType>* RatioNSDistance<outputPixelType>::newDistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer) const {
+    return new RatioNSDistanceTransformUntranslator<outputPixelType>(consumer, num, den, _dMax);
 }
 
-void RatioNSDistanceTransform::processRow(const BinaryPixelType *imageRow) {
+template <typename outputPixelType>
+ImageFilter<outputPixelType, outputPixelType>* RatioNSDistance<outputPixelType>::newMedialAxisExtractor(ImageConsumer<outputPixelType>* consumer) const {
+    return new MedialAxisExtractor<outputPixelType>(consumer, this, _dMax);
+}
+
+template <typename outputPixelType>
+ImageFilter<outputPixelType, outputPixelType>* RatioNSDistance<outputPixelType>::newReverseDistanceTransform(ImageConsumer<outputPixelType>* consumer) const {
+    return new ReverseDistanceTransform<outputPixelType>(consumer, this, _dMax);
+}
+
+template <typename outputPixelType>
+int RatioNSDistance<outputPixelType>::countOf2(int r) const {
+    return mbf2(r);
+}
+
+template <typename outputPixelType>
+void RatioNSDistanceTransform<outputPixelType>::processRow(const BinaryPixelType *imageRow) {
     int col;
 #define N1_SETMINUS_N2_COUNT  1
 #define N2_SETMINUS_N1_COUNT  5
@@ -78,11 +98,11 @@ void RatioNSDistanceTransform::processRow(const BinaryPixelType *imageRow) {
 	if (imageRow[col] == 0)
 	    dtLines[0][col + 2] = 0;
 	else {
-	    GrayscalePixelType val;
-	    GrayscalePixelType dt;
+	    outputPixelType val;
+	    outputPixelType dt;
 	    int k;
 
-	    val = GRAYSCALE_MAX;
+	    val = grayscaleMax<outputPixelType>();
 	    for (k = 0; k < N1_SETMINUS_N2_COUNT; k++) {
 		assert(n1[k].y >= 0);
 		assert(n1[k].y <= 2);
@@ -93,7 +113,7 @@ void RatioNSDistanceTransform::processRow(const BinaryPixelType *imageRow) {
 	    assert(C1(d.num, d.den, (int) val) == d.mbf1i(d.mbf1(val)+1)+1);
 	    dt = std::min((int)_dMax, d.mbf1i(d.mbf1(val)+1)+1);
 
-	    val = GRAYSCALE_MAX;
+	    val = grayscaleMax<outputPixelType>();
 	    for (k = 0; k < N2_SETMINUS_N1_COUNT; k++) {
 		assert(n2[k].y >= 0);
 		assert(n2[k].y <= 2);
@@ -104,7 +124,7 @@ void RatioNSDistanceTransform::processRow(const BinaryPixelType *imageRow) {
 	    assert(C2(d.num, d.den, (int) val) == d.mbf2i(d.mbf2(val)+1)+1);
 	    dt = std::min((int) dt, d.mbf2i(d.mbf2(val)+1)+1);
 
-	    val = GRAYSCALE_MAX;
+	    val = grayscaleMax<outputPixelType>();
 	    for (k = 0; k < N1_CAP_N2_COUNT; k++) {
 		assert(n12[k].y >= 0);
 		assert(n12[k].y <= 2);
@@ -112,7 +132,7 @@ void RatioNSDistanceTransform::processRow(const BinaryPixelType *imageRow) {
 		assert(col + 2 - n12[k].x < _cols + 3);
 		val = std::min(val, dtLines[n12[k].y][col + 2 - n12[k].x]);
 	    }
-	    dt = std::min((int) dt, val + 1);
+	    dt = std::min((int) dt, (int) val + 1);
 
 	    dtLines[0][col + 2] = dt;
 	}
@@ -121,22 +141,26 @@ void RatioNSDistanceTransform::processRow(const BinaryPixelType *imageRow) {
     rotate();
 }
 
-RatioNSDistanceTransform::RatioNSDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer, int num, int den, GrayscalePixelType dMax) :
-    BaseDistanceTransform(consumer),
-    _dMax(dMax == 0 ? GRAYSCALE_MAX : dMax),    
+template <typename outputPixelType>
+RatioNSDistanceTransform<outputPixelType>::RatioNSDistanceTransform(ImageConsumer<outputPixelType>* consumer, int num, int den, int dMax) :
+    BaseDistanceTransform<outputPixelType>(consumer),
+    _dMax(boundedDMax<outputPixelType>(dMax)),    
     d(num, den) {
 }
 
-RatioNSDistanceTransformUntranslator::RatioNSDistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer, int num, int den, GrayscalePixelType dMax) :
+template <typename outputPixelType>
+RatioNSDistanceTransformUntranslator<outputPixelType>::RatioNSDistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer, int num, int den, int dMax) :
 super(consumer, marginRight),
-    _dMax(dMax == 0 ? GRAYSCALE_MAX : dMax),
+    _dMax(boundedDMax<outputPixelType>(dMax)),
     d(num, den) {
 }
 
-RatioNSDistanceTransformUntranslator::~RatioNSDistanceTransformUntranslator() {
+template <typename outputPixelType>
+RatioNSDistanceTransformUntranslator<outputPixelType>::~RatioNSDistanceTransformUntranslator() {
 }
 
-void RatioNSDistanceTransformUntranslator::beginOfImage(int cols, int rows) {
+template <typename outputPixelType>
+void RatioNSDistanceTransformUntranslator<outputPixelType>::beginOfImage(int cols, int rows) {
     int imageDMax = _dMax;
     imageDMax = std::min(imageDMax, (cols + 1) / 2);
     imageDMax = std::min(imageDMax, (rows + 1) / 2);
@@ -145,7 +169,8 @@ void RatioNSDistanceTransformUntranslator::beginOfImage(int cols, int rows) {
 
 // untranslate is called once for each row of the input image, plus one extra time
 // with null-valued translated DT to flush all DT values
-void RatioNSDistanceTransformUntranslator::processRow(const GrayscalePixelType* inputRow) {
+template <typename outputPixelType>
+void RatioNSDistanceTransformUntranslator<outputPixelType>::processRow(const outputPixelType* inputRow) {
     int dtmax = 1;  // Not 0 to avoid outputing the extra row
 
     super::processRow(inputRow);
@@ -156,7 +181,7 @@ void RatioNSDistanceTransformUntranslator::processRow(const GrayscalePixelType*
 
 	dtp = _tdtRows[1][col];
 	if (_tdtRows[0][col] == 0) {
-	    assert(_outputRows[(_curRow + _dtRowCount) % _dtRowCount][col] == (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[(_curRow + _dtRowCount) % _dtRowCount][col] == (outputPixelType) -1);
 	    _outputRows[(_curRow + _dtRowCount) % _dtRowCount][col] = 0;
 	}
 
@@ -175,7 +200,7 @@ void RatioNSDistanceTransformUntranslator::processRow(const GrayscalePixelType*
 	    int dy = r - 1;
 	    assert (dx == d.mbf2(r-1));
 	    assert(_curRow - 1 - dy >= 0);
-	    assert(_outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] == (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] == (outputPixelType) -1);
 	    _outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] = r;
 	    //printf("%d ", r);
 	    // Let s be the next radius where neighborhood 1 is used
@@ -205,7 +230,7 @@ void RatioNSDistanceTransformUntranslator::processRow(const GrayscalePixelType*
 	    assert(dx == MATHBF2(d.num, d.den, r - 1));
 
 	    assert(_curRow - 1 - dy >= 0);
-	    assert(_outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] == (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] == (outputPixelType) -1);
 	    _outputRows[(_curRow - 1 - dy) % _dtRowCount][col - dx] = r;
 	    //printf("%d ", r);
 	    // Next time we use neighborhood 2, dx is increased by one
@@ -221,9 +246,16 @@ void RatioNSDistanceTransformUntranslator::processRow(const GrayscalePixelType*
 	_consumer->processRow(_outputRows[_outRow % _dtRowCount]);
 #ifndef NDEBUG
 	for (int col = 0; col < _cols; col++) {
-	    assert(_outputRows[_outRow % _dtRowCount][col] != (GrayscalePixelType) -1);
+	    assert(!_checkAssignments || _outputRows[_outRow % _dtRowCount][col] != (outputPixelType) -1);
 	    _outputRows[_outRow % _dtRowCount][col] = -1;
 	}
 #endif
     }
 }
+
+template class RatioNSDistance<Grayscale8PixelType>;
+template class RatioNSDistance<Grayscale16PixelType>;
+template class RatioNSDistanceTransform<Grayscale8PixelType>;
+template class RatioNSDistanceTransform<Grayscale16PixelType>;
+template class RatioNSDistanceTransformUntranslator<Grayscale8PixelType>;
+template class RatioNSDistanceTransformUntranslator<Grayscale16PixelType>;
@@ -38,7 +38,8 @@
  * neighborhood-sequence distances defined by a ratio of neighborhoods:
  * RatioNSDistanceTransform and RatioNSDistanceTransformUntranslator.
  */
-class RatioNSDistance: public BaseDistance {
+template <typename outputPixelType>
+class RatioNSDistance: public BaseDistance<outputPixelType> {
 public:
     /**
      * @param num numerator
@@ -57,22 +58,39 @@ public:
      * as \em 8-neighborhood). The octagonal distance can be constructed
      * with \p num = 1 and \p den = 2.
      */
-    RatioNSDistance(int num, int den, GrayscalePixelType dMax = 0);
+    RatioNSDistance(int num, int den, int dMax = 0);
     /**
      * @brief create a distance transform ImageFilter for a translated
      * neighborhood-sequence distance.
      * @return an instance of RatioNSDistanceTransform.
      */
-    BaseDistanceTransform* newTranslatedDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer) const;
+    BaseDistanceTransform<outputPixelType>* newTranslatedDistanceTransform(ImageConsumer<outputPixelType>* consumer) const;
     /**
      * @brief create an ImageFilter to recenter the translated distance
      * transform of a neighborhood-sequence distance.
      * @return an instance of RatioNSDistanceTransformUntranslator.
      */
-    DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType>* newDistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer) const;
+    DistanceTransformUntranslator<outputPixelType, outputPixelType>* newDistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer) const;
+    /**
+     * @brief create an ImageFilter that extracts the centers of maximal
+     * disks from the regular distance transform.
+     * @return an instance of MedialAxisExtractor.
+     */
+    ImageFilter<outputPixelType, outputPixelType>* newMedialAxisExtractor(ImageConsumer<outputPixelType>* consumer) const;
+    /**
+     * @brief create an ImageFilter that computes the union of the disks
+     * given by their radii.
+     * @return an instance of ReverseDistanceTransform.
+     */
+    ImageFilter<outputPixelType, outputPixelType>* newReverseDistanceTransform(ImageConsumer<outputPixelType>* consumer) const;
+    /**
+     * @return number of occurrences of 2 in the sequence between indices 1
+     * and \p r, given by #mbf2.
+     */
+    int countOf2(int r) const;
 
 protected:
-    GrayscalePixelType _dMax;
+    int _dMax;
     int num;
     int den;
     /**
@@ -96,8 +114,8 @@ protected:
      */
     RationalBeattySeq mbf2i;
 
-  friend class RatioNSDistanceTransform;    
-  friend class RatioNSDistanceTransformUntranslator;    
+  template <typename> friend class RatioNSDistanceTransform;
+  template <typename> friend class RatioNSDistanceTransformUntranslator;
 };
 
 /**
@@ -108,7 +126,8 @@ protected:
  * input image is provided one row at a time by processRow().  The result image
  * is written in the next consumer in the filter chain.
  */
-class RatioNSDistanceTransform : public BaseDistanceTransform {
+template <typename outputPixelType>
+class RatioNSDistanceTransform: public BaseDistanceTransform<outputPixelType> {
 public:
     /**
      * @brief Construct a RatioNSDistanceTransform
@@ -118,9 +137,9 @@ public:
      * of occurrences of the value 2 in the sequence.
      * @param dMax maximal value of the distance transform. Output distance
      * values are saturated to this value. When \p dMax is 0, the distance
-     * is bounded by #GRAYSCALE_MAX.
+     * is bounded by the maximal value of \p outputPixelType.
      */
-    RatioNSDistanceTransform(ImageConsumer<GrayscalePixelType>* consumer, int num, int den, GrayscalePixelType dMax = 0);
+    RatioNSDistanceTransform(ImageConsumer<outputPixelType>* consumer, int num, int den, int dMax = 0);
 
     /**
      * @brief Process one row of image.
@@ -161,13 +180,17 @@ public:
     void processRow(const BinaryPixelType *imageRow);
 
 protected:
+    using BaseDistanceTransform<outputPixelType>::_consumer;
+    using BaseDistanceTransform<outputPixelType>::_cols;
+    using BaseDistanceTransform<outputPixelType>::dtLines;
+    using BaseDistanceTransform<outputPixelType>::rotate;
     /**
      * Upper bound of the distance transform value (output distance values
      * are saturated to this value).
      */
-    GrayscalePixelType _dMax;
+    outputPixelType _dMax;
     /** Distance */
-    const RatioNSDistance d;
+    const RatioNSDistance<outputPixelType> d;
 };
 
 /**
@@ -178,7 +201,8 @@ protected:
  * input image is provided one row at a time by processRow().  The result
  * image is written in the next consumer in the filter chain.
  */
-class RatioNSDistanceTransformUntranslator: public DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType> {
+template <typename outputPixelType>
+class RatioNSDistanceTransformUntranslator: public DistanceTransformUntranslator<outputPixelType, outputPixelType> {
 public:
     /**
      * @brief Construct a RatioNSDistanceTransformUntranslator.
@@ -189,30 +213,38 @@ public:
      * of occurrences of the value 2 in the sequence.
      * @param dMax maximal value of the distance transform. Input distance
      * values are assumed never to exceed this value. When \p dMax is 0, the
-     * distance is only bounded by #GRAYSCALE_MAX.
+     * distance is only bounded by the maximal value of \p outputPixelType.
      *
      * The algorithm latency (and the number of rows that have to be stored)
      * directly depends on the maximal value of the distance transform.
      * Forcing a lower value sets an upper bound on the latency and reduces
      * the allocated memory.
      */
-    RatioNSDistanceTransformUntranslator(ImageConsumer<GrayscalePixelType>* consumer, int num, int den, GrayscalePixelType dMax = 0);
+    RatioNSDistanceTransformUntranslator(ImageConsumer<outputPixelType>* consumer, int num, int den, int dMax = 0);
     ~RatioNSDistanceTransformUntranslator();
 
     void beginOfImage(int cols, int rows);
-    void processRow(const GrayscalePixelType* inputRow);
+    void processRow(const outputPixelType* inputRow);
 
 protected:
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_consumer;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_cols;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_curRow;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_outRow;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_dtRowCount;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_outputRows;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_tdtRows;
+    using DistanceTransformUntranslator<outputPixelType, outputPixelType>::_checkAssignments;
     /**
      * Upper bound of the distance transform value (input distance values
      * are assumed never to exceed #_dMax).
      */
-    GrayscalePixelType _dMax;
+    outputPixelType _dMax;
     /** Distance */
-    const RatioNSDistance d;
+    const RatioNSDistance<outputPixelType> d;
 
 private:
     static const int marginRight = 1;
-    typedef DistanceTransformUntranslator<GrayscalePixelType, GrayscalePixelType> super;
+    typedef DistanceTransformUntranslator<outputPixelType, outputPixelType> super;
 };
 
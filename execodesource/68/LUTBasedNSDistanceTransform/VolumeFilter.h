@@ -0,0 +1,94 @@
+// This file is part of LUTBasedNSDistanceTransform.
+//
+// LUTBasedNSDistanceTransform is free software: you can redistribute it and/or
+// modify it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or (at your
+// option) any later version.
+//
+// LUTBasedNSDistanceTransform is distributed in the hope that it will be
+// useful, but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General
+// Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// LUTBasedNSDistanceTransform.  If not, see <http://www.gnu.org/licenses/>.
+
+/**
+ * @file VolumeFilter.h
+ *
+ * Interface to VolumeFilter class
+ *
+ * A volume filter receives volumes one slice at a time, processes it, and
+ * forwards the result to the following filter (or volume consumer). It is
+ * the 3D counterpart of ImageFilter.
+ *
+ * This file is part of LUTBasedNSDistanceTransform.
+ */
+
+#ifndef VOLUME_FILTER_H
+#define VOLUME_FILTER_H
+
+#include <stdlib.h>
+
+#include "LUTBasedNSDistanceTransformConfig.h"
+
+/**
+ * A VolumeConsumer accepts voxels one slice at a time. A slice is stored
+ * row after row, cols * rows voxels. A call to beginOfVolume() prepares the
+ * VolumeConsumer to receive a volume, it is followed by as many calls to
+ * processSlice() as the number of slices in the volume and a final call to
+ * endOfVolume().
+ */
+template <typename inputPixelType>
+class VolumeConsumer {
+public:
+    virtual ~VolumeConsumer() {}
+
+    /**
+     * Called by a producer to provide a slice of voxels to this volume
+     * consumer.
+     *
+     * @param inputSlice the slice of input voxels.
+     */
+    virtual void processSlice(const inputPixelType* inputSlice) = 0;
+    /**
+     * Prepare the consumer for a volume.
+     *
+     * @param cols the volume width.
+     * @param rows the volume height.
+     * @param slices the volume depth.
+     */
+    virtual void beginOfVolume(int cols, int rows, int slices) = 0;
+    /**
+     * End the processing of a volume.
+     *
+     * Called by the producer when a volume is fully transmitted. After
+     * endOfVolume() is called, beginOfVolume() may be called again to start
+     * the processing of a new volume.
+     */
+    virtual void endOfVolume() = 0;
+};
+
+/**
+ * A VolumeFilter is both a volume consumer and a producer.
+ * It redirects calls to beginOfVolume(), processSlice() and endOfVolume() to
+ * the next VolumeConsumer (optionally modifying the content of the volume).
+ */
+template <typename inputPixelType, typename outputPixelType>
+class VolumeFilter: public VolumeConsumer<inputPixelType> {
+public:
+    VolumeFilter(VolumeConsumer<outputPixelType>* consumer) : _consumer(consumer) {
+	if (_consumer == NULL) {
+	    exit(1);
+	}
+    }
+    virtual ~VolumeFilter() { delete _consumer; }
+
+    void beginOfVolume(int cols, int rows, int slices) {_consumer->beginOfVolume(cols, rows, slices);}
+    void endOfVolume() {_consumer->endOfVolume();}
+protected:
+    /** Next VolumeConsumer in the filter chain. */
+    VolumeConsumer<outputPixelType>* _consumer;
+};
+
+#endif
@@ -20,6 +20,7 @@ OPTION(WITH_ITK "With Insight Toolkit ITK." OFF)
 OPTION(WITH_CAIRO "With CairoGraphics." OFF)
 OPTION(WITH_COIN3D-SOQT "With COIN3D & SOQT for 3D visualization (Qt required)." OFF)
 OPTION(WITH_OPENMP "With OpenMP (compiler multithread programming) features." OFF)
+OPTION(WITH_PTHREAD "With POSIX threads if found (built-in thread pool used when OpenMP is not available)." ON)
 
 
 IF(WITH_C11)
@@ -78,6 +79,13 @@ ELSE(WITH_OPENMP)
 message(STATUS "      WITH_OPENMP       false")
 ENDIF(WITH_OPENMP)
 
+IF(WITH_PTHREAD)
+SET (LIST_OPTION ${LIST_OPTION} [pthread]\ )
+message(STATUS "      WITH_PTHREAD      true")
+ELSE(WITH_PTHREAD)
+message(STATUS "      WITH_PTHREAD      false")
+ENDIF(WITH_PTHREAD)
+
 message(STATUS "")
 message(STATUS "Checking the dependencies: ")
 
@@ -345,4 +353,21 @@ IF(WITH_OPENMP)
   ENDIF(OPENMP_FOUND)
 ENDIF(WITH_OPENMP)
 
+# -----------------------------------------------------------------------------
+# Look for POSIX threads
+# (They are not compulsory: without them, the thread pool runs serially).
+# -----------------------------------------------------------------------------
+SET(PTHREAD_FOUND_DGTAL 0)
+IF(WITH_PTHREAD)
+  FIND_PACKAGE(Threads)
+  IF(CMAKE_USE_PTHREADS_INIT)
+    SET(PTHREAD_FOUND_DGTAL 1)
+    SET(DGtalLibDependencies ${DGtalLibDependencies} ${CMAKE_THREAD_LIBS_INIT})
+    ADD_DEFINITIONS("-DWITH_PTHREAD ")
+    message(STATUS "POSIX threads found.")
+  ELSE(CMAKE_USE_PTHREADS_INIT)
+    message(STATUS "POSIX threads not found: tasks of WorkStealingScheduler are run serially.")
+  ENDIF(CMAKE_USE_PTHREADS_INIT)
+ENDIF(WITH_PTHREAD)
+
 message(STATUS "-------------------------------------------------------------------------------")
@@ -28,6 +28,7 @@
 #include <iostream>
 
 #include "DGtal/base/Common.h"
+#include "DGtal/base/Profiler.h"
 
 #include "DGtal/helpers/StdDefs.h"
 
@@ -95,6 +96,7 @@ int main( int argc, char** argv )
 
   args.addOption("-backgroundImageXFIG", "-backgroundImageXFIG <filename> <width> <height> : display image as background in XFIG format", "imageBG.png", "256","256"  );
   args.addOption("-scale", "-scale <value> 1: normal; >1 : larger ; <1 lower resolutions  ) (default 1.0) ", "1.0");
+  args.addOption("-profile", "-profile <file>: write a JSON report of the time and memory used by each step.", "profile.json");
   
   bool parseOK=  args.readArguments( argc, argv );
   
@@ -105,7 +107,9 @@ int main( int argc, char** argv )
       return 1;
   } 
 
-
+  if(args.check("-profile")){
+    profiler.enable(args.getOption("-profile")->getValue(0), "displayContours");
+  }
   
   double lineWidth =  args.getOption("-lineWidth")->getFloatValue(0);
   double scale = args.getOption("-scale")->getIntValue(0);
@@ -139,7 +143,11 @@ int main( int argc, char** argv )
  
   if(args.check("-fc")){
     std::string fileName = args.getOption("-fc")->getValue(0);
+    profiler.beginPhase("load");
     std::vector< FreemanChain<int> > vectFc =  PointListReader< Z2i::Point>:: getFreemanChainsFromFile<int> (fileName); 
+    profiler.count("contours", vectFc.size());
+    profiler.endPhase();
+    Profiler::Phase phase(profiler, "rendering");
     //aBoard <<  SetMode( vectFc.at(0).className(), "InterGrid" );
     aBoard << CustomStyle( vectFc.at(0).className(), 
 			   new CustomColors( Color::Red  ,  (filled ? (Color::Black) : (Color::None))  ) );    
@@ -158,8 +166,11 @@ int main( int argc, char** argv )
     std::vector<LibBoard::Point> contourPt;
     if(args.check("-sdp")){
       std::string fileName = args.getOption("-sdp")->getValue(0);
+      profiler.beginPhase("load");
       std::vector< Z2i::Point >  contour = 
 	PointListReader< Z2i::Point >::getPointsFromFile(fileName); 
+      profiler.count("points", contour.size());
+      profiler.endPhase();
       for(unsigned int j=0; j<contour.size(); j++){
 	LibBoard::Point pt((double)(contour.at(j)[0]),
 			   (invertYaxis? (double)(-contour.at(j)[1]+contour.at(0)[1]):(double)(contour.at(j)[1])));
@@ -172,8 +183,11 @@ int main( int argc, char** argv )
     
     if(args.check("-sfp")){
       std::string fileName = args.getOption("-sfp")->getValue(0);
+      profiler.beginPhase("load");
       std::vector< PointVector<2,double>  >  contour = 
 	PointListReader<  PointVector<2,double>  >::getPointsFromFile(fileName); 
+      profiler.count("points", contour.size());
+      profiler.endPhase();
       for(unsigned int j=0; j<contour.size(); j++){
 	LibBoard::Point pt((double)(contour.at(j)[0]),
 			   (invertYaxis? (double)(-contour.at(j)[1]+contour.at(0)[1]):(double)(contour.at(j)[1])));
@@ -183,6 +197,7 @@ int main( int argc, char** argv )
 	}
       }
     }
+    Profiler::Phase phase(profiler, "rendering");
     aBoard.setPenColor(Color::Red);
     aBoard.setLineStyle (LibBoard::Shape::SolidStyle );
     aBoard.setLineWidth (lineWidth);
@@ -197,6 +212,7 @@ int main( int argc, char** argv )
 
  
   
+  profiler.beginPhase("output");
   if (args.check("-outputSVG")){
     std::string outputFileName= args.getOption("-outputSVG")->getValue(0);
     aBoard.saveSVG(outputFileName.c_str());
@@ -228,5 +244,6 @@ int main( int argc, char** argv )
 	      std::string outputFileName= "output.eps";
 	      aBoard.saveEPS(outputFileName.c_str());
 	    }
+  profiler.endPhase();
   
 }
@@ -26,6 +26,7 @@
 
 #include <iostream>
 #include "DGtal/base/Common.h"
+#include "DGtal/base/Profiler.h"
 #include "DGtal/images/imagesSetsUtils/SetFromImage.h"
 
 #include "DGtal/images/ImageSelector.h"
@@ -57,6 +58,7 @@ int main( int argc, char** argv )
   args.addOption("-exportSRC", "-exportSRC <filename> export the source set of voxels", "src.off"); 
   args.addOption("-threshold", "-threshold <min> <max> (default: min = 128, max 255  ", "128", "255");
   args.addOption( "-badj", "-badj <0/1>: 0 is interior bel adjacency, 1 is exterior (def. is 0).", "0" );
+  args.addOption("-profile", "-profile <file>: write a JSON report of the time and memory used by each step.", "profile.json");
 
   if ( ( argc <= 1 ) ||  ! args.readArguments( argc, argv ) ) 
     {
@@ -74,14 +76,24 @@ int main( int argc, char** argv )
   int minThreshold = args.getOption("-threshold")->getIntValue(0);
   int maxThreshold = args.getOption("-threshold")->getIntValue(1);
   bool badj = (args.getOption("-badj")->getIntValue(0))!=1;
-  
+  if(args.check("-profile")){
+    profiler.enable(args.getOption("-profile")->getValue(0), "extract3D");
+  }
   
   typedef ImageSelector < Domain, int>::Type Image;
   typedef IntervalThresholder<Image::Value> Binarizer; 
+  profiler.beginPhase("load");
   Image image =   VolReader<Image>::importVol(imageFileName);
+  profiler.count("voxels", image.domain().size());
+  profiler.endPhase();
 
   Binarizer b(minThreshold, maxThreshold); 
   PointFunctorPredicate<Image,Binarizer> predicate(image, b); 
+  profiler.beginPhase("binarization");
+  Z3i::DigitalSet objectSet(image.domain());
+  SetFromImage<Z3i::DigitalSet>::append<Image>(objectSet, image, predicate);
+  profiler.count("voxels", objectSet.size());
+  profiler.endPhase();
  
  
   //A KhalimskySpace is constructed from the domain boundary points.
@@ -95,7 +107,12 @@ int main( int argc, char** argv )
   vector<vector<SCell> > vectConnectedSCell;
  
  
-  Surfaces<KSpace>::extractAllConnectedSCell(vectConnectedSCell,K, sAdj, predicate, false);
+  profiler.beginPhase("tracking");
+  Surfaces<KSpace>::extractAllConnectedSCell(vectConnectedSCell,K, sAdj, objectSet, false);
+  profiler.count("components", vectConnectedSCell.size());
+  profiler.endPhase();
+
+  profiler.beginPhase("rendering");
 
   Display3D exportSurfel;
  
@@ -120,15 +137,17 @@ int main( int argc, char** argv )
     }    
   }
 
-  Z3i::DigitalSet imageSet(image.domain());
-  SetFromImage<Z3i::DigitalSet>::append<Image>(imageSet, image, minThreshold, maxThreshold);
-  
-  
+  profiler.endPhase();
+
+
   exportSurfel << CustomColors3D(Color(250, 0,0),Color(250, 200,200, 200));
   //exportSurfel << imageSet;  
+  Profiler::Phase phase(profiler, "output");
   exportSurfel >> outputFileName;
 
   if(args.check("-exportSRC")){
+    Z3i::DigitalSet imageSet(image.domain());
+    SetFromImage<Z3i::DigitalSet>::append<Image>(imageSet, image, minThreshold, maxThreshold);
     Display3D exportSRC;
     exportSRC << imageSet;
     exportSRC >> srcFileName;
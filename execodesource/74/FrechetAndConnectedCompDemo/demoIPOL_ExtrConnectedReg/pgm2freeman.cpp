@@ -25,12 +25,14 @@
  */
 
 
+#include "DGtal/base/Profiler.h"
 #include "DGtal/io/colormaps/GrayscaleColorMap.h"
 #include "DGtal/io/readers/PNMReader.h"
 #include "DGtal/images/ImageContainerBySTLVector.h"
 #include "DGtal/images/ImageSelector.h"
 
 #include "DGtal/geometry/curves/FreemanChain.h"
+#include "DGtal/geometry/curves/PackedFreemanChain.h"
 #include "DGtal/geometry/helpers/ContourHelper.h"
 #include "DGtal/topology/helpers/Surfaces.h"
 
@@ -106,12 +108,13 @@ struct compContours {
 } myCompContour;
 
 
-void saveAllContoursAsFc(std::vector< std::vector< Z2i::Point >  >  vectContoursBdryPointels, unsigned int minSize){
+void saveAllContoursAsFc(const std::vector< std::vector< Z2i::Point >  > & vectContoursBdryPointels, unsigned int minSize){
+  PackedFreemanChain<Z2i::Integer> fc;
   for(unsigned int k=0; k<vectContoursBdryPointels.size(); k++){
     if(vectContoursBdryPointels.at(k).size()>minSize){
-      FreemanChain<Z2i::Integer> fc (vectContoursBdryPointels.at(k));    
-      std::cout << fc.x0 << " " << fc.y0   << " " << fc.chain << std::endl; 
-	  
+      fc.readFromPointsRange(vectContoursBdryPointels.at(k).begin(), vectContoursBdryPointels.at(k).end());
+      fc.write(std::cout);
+      profiler.count("written contours");
     }
   }
 }
@@ -207,6 +210,7 @@ int main( int argc, char** argv )
   args.addBooleanOption("-outputSDP", "-outputSDP export as a sequence of discrete points instead of freemanchain (use the largest contour if more contours appears)");
   args.addBooleanOption("-outputSDPAll", "-outputSDPAll export as a sequence of discrete points instead of freemanchain (all contours are exported: one per line)");
   args.addBooleanOption("-version", "-version : display version");    
+  args.addOption("-profile", "-profile <file>: write a JSON report of the time and memory used by each step.", "profile.json");
 
  
   if ( ( argc <= 1 ) ||  ! args.readArguments( argc, argv ) ) 
@@ -257,10 +261,17 @@ int main( int argc, char** argv )
     selectDistanceMax = args.getOption("-selectContour")->getIntValue(2);
   }
  
+  if(args.check("-profile")){
+    profiler.enable(args.getOption("-profile")->getValue(0), "pgm2freeman");
+  }
+
   typedef ImageSelector < Z2i::Domain, unsigned char>::Type Image;
   typedef IntervalThresholder<Image::Value> Binarizer; 
   std::string imageFileName = args.getOption("-image")->getValue(0);
+  profiler.beginPhase("load");
   Image image = PNMReader<Image>::importPGM( imageFileName ); 
+  profiler.count("pixels", image.domain().size());
+  profiler.endPhase();
   
   Z2i::KSpace ks;
   if(! ks.init( image.domain().lowerBound(), 
@@ -274,6 +285,7 @@ int main( int argc, char** argv )
     if (!args.check("-maxThreshold")&& !args.check("-minThreshold")){
       minThreshold=0;
       trace.info() << "Min/Max threshold values not specified, set min to 0 and computing max with the otsu algorithm...";
+      Profiler::Phase phase(profiler, "otsu");
       maxThreshold = getOtsuThreshold(image);
       trace.info() << "[done] (max= " << maxThreshold << ") "<< std::endl;
     }
@@ -285,8 +297,12 @@ int main( int argc, char** argv )
     
     SurfelAdjacency<2> sAdj( badj );
     std::vector< std::vector< Z2i::Point >  >  vectContoursBdryPointels;
+    profiler.beginPhase("tracking");
     Surfaces<Z2i::KSpace>::extractAllPointContours4C( vectContoursBdryPointels,
   						      ks, predicate, sAdj );  
+    profiler.count("contours", vectContoursBdryPointels.size());
+    profiler.endPhase();
+    Profiler::Phase phase(profiler, "output");
     if(select){
       if(!exportSDP){
 	saveSelContoursAsFC(vectContoursBdryPointels,  minSize, selectCenter,  selectDistanceMax);
@@ -316,8 +332,12 @@ int main( int argc, char** argv )
       trace.info() << "DGtal contour extraction from thresholds ["<<  min << "," << max << "]" ;
       SurfelAdjacency<2> sAdj( badj );
       std::vector< std::vector< Z2i::Point >  >  vectContoursBdryPointels;
+      profiler.beginPhase("tracking");
       Surfaces<Z2i::KSpace>::extractAllPointContours4C( vectContoursBdryPointels,
   							ks, predicate, sAdj );  
+      profiler.count("contours", vectContoursBdryPointels.size());
+      profiler.endPhase();
+      Profiler::Phase phase(profiler, "output");
       if(select){
   	if(!exportSDP){
 	  saveSelContoursAsFC(vectContoursBdryPointels,  minSize, selectCenter,  selectDistanceMax);
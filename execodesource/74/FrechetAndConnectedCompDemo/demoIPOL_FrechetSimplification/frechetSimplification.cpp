@@ -33,10 +33,17 @@
 #include <cstdio>
 #include <cmath>
 #include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
 #include <vector>
+#include <algorithm>
 
 #include "DGtal/base/Common.h"
 #include "DGtal/base/Exceptions.h"
+#include "DGtal/base/Clock.h"
+#include "DGtal/base/Profiler.h"
+#include "DGtal/base/WorkStealingScheduler.h"
 #include "DGtal/kernel/SpaceND.h"
 
 #include "DGtal/kernel/domains/HyperRectDomain.h"
@@ -48,6 +55,7 @@
 #include "DGtal/helpers/StdDefs.h"
 
 #include "DGtal/geometry/curves/GreedySegmentation.h"
+#include "DGtal/geometry/curves/OnlineFrechetSimplification.h"
 
 #include "ImaGene/Arguments.h"
 
@@ -62,7 +70,7 @@ using namespace Z2i;
 static ImaGene::Arguments args;
 
 
-typedef Curve::PointsRange::ConstIterator Iterator;
+typedef std::vector<Z2i::Point>::const_iterator Iterator;
 typedef FrechetShortcut<Iterator,int> SegmentComputer;
 typedef GreedySegmentation<SegmentComputer> Segmentation;
 
@@ -86,61 +94,431 @@ void displayContour(const std::vector<Z2i::Point> &contour, Board2D &aBoard){
 
 
 
-void processContour(const std::vector<Z2i::Point> &contour, Board2D & aBoard, double error,ofstream &f,
-		    bool flagWidthOnly, bool displayPolygonInline=true){ 
-  Curve aCurve; //grid curve
-  aCurve.initFromVector(contour);
-  typedef Curve::PointsRange Range; //range
-  Range r = aCurve.getPointsRange(); //range
+/**
+ * Returns the end of the points of @a contour that a grid curve
+ * built from @a contour would go through: the last point is dropped
+ * unless it is 4-adjacent to the first one (closed contour).
+ * The contour is thus segmented in place, with the same result as
+ * the points range of the grid curve.
+ */
+Iterator curvePointsEnd(const std::vector<Z2i::Point> &contour){
+  if(contour.empty())
+    return contour.end();
+  if((contour.front()-contour.back()).norm1() == 1)
+    return contour.end();
+  return contour.end()-1;
+}
+
+
+/**
+ * The simplification of one contour for a given error. Only the end
+ * points of the segments are kept, not the segment computers.
+ */
+struct Simplification{
+  Iterator itPointsBegin;
+  Iterator itPointsEnd;
+  /// The first and last points of each segment.
+  std::vector< std::pair<Z2i::Point,Z2i::Point> > segments;
+  double cpuTime;
+};
+
+
+void simplifyContour(const std::vector<Z2i::Point> &contour, double error, bool flagWidthOnly,
+		     Simplification &result){
+  result.itPointsBegin = contour.begin();
+  result.itPointsEnd = curvePointsEnd(contour);
   clock_t time1, time2;
   time1 = clock();
-  Segmentation theSegmentation( r.begin(), r.end(), SegmentComputer(error,flagWidthOnly) );
-  time2 = clock();
-  double cpuTime;
-  cpuTime =  ((double)time2-(double)time1)/((double)CLOCKS_PER_SEC/1000);
+  Segmentation theSegmentation( result.itPointsBegin, result.itPointsEnd, SegmentComputer(error,flagWidthOnly) );
   
+  // the segments are computed while iterating the segmentation
+  result.segments.clear();
   Segmentation::SegmentComputerIterator it = theSegmentation.begin();
   Segmentation::SegmentComputerIterator itEnd = theSegmentation.end();
+  for ( ; it != itEnd; ++it) {
+    Iterator itLast = it->end();
+    --itLast;
+    result.segments.push_back(std::make_pair(*(it->begin()), *itLast));
+  }
+  time2 = clock();
+  result.cpuTime =  ((double)time2-(double)time1)/((double)CLOCKS_PER_SEC/1000);
+}
+
+
+/**
+ * Tells whether the segment [*a, *b] is at a distance at most @a
+ * error from the polyline a, ..., b (b included). Each vertex p is
+ * matched with the part of the segment lying in the disk of radius
+ * @a error centered at p. For the Frechet distance, these parts must
+ * be met in order (the edges are then matched linearly); for the
+ * width only, they must only be non empty.
+ */
+bool isShortcut(Iterator a, Iterator b, double error, bool flagWidthOnly){
+  const double dx = (*b)[0]-(*a)[0], dy = (*b)[1]-(*a)[1];
+  const double length2 = dx*dx+dy*dy;
+  // greatest position on [a,b] of the previous vertices
+  double minT = 0.0;
+  for(Iterator it = a; it != b+1; ++it){
+    const double px = (*it)[0]-(*a)[0], py = (*it)[1]-(*a)[1];
+    if(length2 == 0.0){
+      if(px*px+py*py > error*error)
+	return false;
+      continue;
+    }
+    const double cross = dx*py-dy*px;
+    const double h2 = error*error-cross*cross/length2;
+    if(h2 < 0.0)
+      return false;
+    const double t = (dx*px+dy*py)/length2;
+    const double halfWidth = sqrt(h2/length2);
+    const double maxT = std::min(1.0, t+halfWidth);
+    if(flagWidthOnly){
+      if(std::max(0.0, t-halfWidth) > maxT)
+	return false;
+    }else{
+      minT = std::max(minT, t-halfWidth);
+      if(minT > maxT)
+	return false;
+    }
+  }
+  return true;
+}
+
+
+/**
+ * Simplifies the polygon of @a finer, computed for a smaller error,
+ * with the error @a error: its vertices are the ones of @a finer kept
+ * by a greedy segmentation using isShortcut(). The Frechet distance
+ * (or the width) between the result and the contour is thus at most
+ * the error of @a finer plus @a error, without reading the points of
+ * the contour. Each extension tests all the vertices of the current
+ * segment, which is cheap as long as the errors are close.
+ */
+void simplifyPolygon(const Simplification &finer, double error, bool flagWidthOnly,
+		     Simplification &result){
+  result.itPointsBegin = finer.itPointsBegin;
+  result.itPointsEnd = finer.itPointsEnd;
+  result.segments.clear();
+  if(finer.segments.empty())
+    return;
+  std::vector<Z2i::Point> vertices;
+  for(unsigned int i=0; i < finer.segments.size(); i++)
+    vertices.push_back(finer.segments[i].first);
+  vertices.push_back(finer.segments.back().second);
   
-  int simplificationSize=0;
+  Iterator itBegin = vertices.begin();
+  Iterator itLast = vertices.end()-1;
+  while(itBegin != itLast){
+    // a segment of the polygon of finer is always kept
+    Iterator itEnd = itBegin+1;
+    while(itEnd != itLast && isShortcut(itBegin, itEnd+1, error, flagWidthOnly))
+      ++itEnd;
+    result.segments.push_back(std::make_pair(*itBegin, *itEnd));
+    itBegin = itEnd;
+  }
+}
+
+
+/**
+ * Sets the pen of the simplified segments on @a aBoard. The pen is
+ * built once and shared by all the drawings.
+ */
+void setSegmentPen(Board2D &aBoard){
+  static const CustomPen pen( Color::Red, Color::Red, 3.0, 
+			      Board2D::Shape::SolidStyle,
+			      Board2D::Shape::RoundCap,
+			      Board2D::Shape::RoundJoin );
+  pen.setStyle(aBoard);
+}
+
+
+/**
+ * Writes the vertices of @a simplification in @a f, its size on
+ * @a summary and its drawing on @a aBoard.
+ */
+void writeSimplification(const std::vector<Z2i::Point> &contour, const Simplification &simplification,
+			 Board2D & aBoard, double error, ofstream &f, std::ostream &summary,
+			 bool displayPolygonInline){
+  const std::vector< std::pair<Z2i::Point,Z2i::Point> > &vectSeg = simplification.segments;
 
   aBoard.setPenColor(Color::Red);
   aBoard.setLineStyle (LibBoard::Shape::SolidStyle );
   
-  std::vector<SegmentComputer> vectSeg;
-  for ( ; it != itEnd; ++it) {
-    SegmentComputer s(*it);
-    vectSeg.push_back(*it);
+  for(unsigned int i=0; i < vectSeg.size(); i++){
+    const Z2i::Point &p = vectSeg.at(i).first;
     //output vertices of the simplification 
     if(displayPolygonInline){
-      f << (*(s.begin()))[0] << " " << (*(s.begin()))[1] <<  " " ;
+      f << p[0] << " " << p[1] <<  " " ;
     }else{
-      f << (*(s.begin()))[0] << " " << (*(s.begin()))[1] <<  endl;
+      f << p[0] << " " << p[1] <<  endl;
     }
-    
-  // size of the simpification
-    simplificationSize++;
   }
   f << endl;
 
-  std::cout << aCurve.size()<<" " << error<<" " << simplificationSize<<" "<< cpuTime << std::endl;
+  // size of the simpification
+  summary << (simplification.itPointsEnd-simplification.itPointsBegin)<<" " << error<<" " 
+	  << vectSeg.size()<<" "<< simplification.cpuTime << std::endl;
   
   displayContour(contour, aBoard);
   
-  aBoard << r;
+  for(Iterator itP = simplification.itPointsBegin; itP != simplification.itPointsEnd; ++itP){
+    aBoard << SetMode( itP->className(), "Grid" ) << *itP;
+  }
   
-  for( int i=0; i < vectSeg.size(); i++){
-    aBoard << CustomStyle( vectSeg.at(i).className(),  new CustomPen( Color::Red, Color::Red, 3.0, 
-								      Board2D::Shape::SolidStyle,
-								      Board2D::Shape::RoundCap,
-								      Board2D::Shape::RoundJoin ) );
-    aBoard<< vectSeg.at(i);
+  setSegmentPen(aBoard);
+  for(unsigned int i=0; i < vectSeg.size(); i++){
+    const Z2i::Point &p1 = vectSeg.at(i).first;
+    const Z2i::Point &p2 = vectSeg.at(i).second;
+    aBoard.drawLine(p1[0], p1[1], p2[0], p2[1]);
+  }
+}
+
+
+void processContour(const std::vector<Z2i::Point> &contour, Board2D & aBoard, double error,ofstream &f,
+		    bool flagWidthOnly, bool displayPolygonInline=true){ 
+  Simplification simplification;
+  profiler.beginPhase("segmentation");
+  simplifyContour(contour, error, flagWidthOnly, simplification);
+  profiler.count("points", simplification.itPointsEnd-simplification.itPointsBegin);
+  profiler.count("segments", simplification.segments.size());
+  profiler.endPhase();
+  Profiler::Phase phase(profiler, "rendering");
+  writeSimplification(contour, simplification, aBoard, error, f, std::cout, displayPolygonInline);
+}
+
+
+/**
+ * Simplifies one contour for all the error levels: one task of the
+ * nested multi-level mode. Only the finest level (smallest error) is
+ * computed on the contour with FrechetShortcut, each other level
+ * simplifies the polygon of the finest one with the difference of
+ * their errors (see simplifyPolygon()).
+ */
+struct NestedLevelsTask{
+  const std::vector< std::vector<Z2i::Point> > *contours;
+  const std::vector<double> *errors;
+  std::size_t finestLevel;
+  bool flagWidthOnly;
+  /// The simplification of each contour, per level.
+  std::vector< std::vector<Simplification> > *simplifications;
+
+  void operator()(std::size_t j, unsigned int /*thread*/) const {
+    Simplification &finest = (*simplifications)[finestLevel][j];
+    Clock c;
+    c.startClock();
+    simplifyContour(contours->at(j), errors->at(finestLevel), flagWidthOnly, finest);
+    // clock() would count the time spent by all the threads
+    finest.cpuTime = c.stopClock();
+    for(std::size_t level=0; level<errors->size(); level++){
+      if(level == finestLevel)
+	continue;
+      Simplification &simplification = (*simplifications)[level][j];
+      c.startClock();
+      simplifyPolygon(finest, errors->at(level)-errors->at(finestLevel), flagWidthOnly, simplification);
+      simplification.cpuTime = c.stopClock();
+    }
+  }
+};
+
+
+/**
+ * Simplifies all the contours for one error level and writes the
+ * level i in output-i.txt and output-i.eps: one task of the
+ * multi-level mode. The levels share the parsed contours and are run
+ * concurrently. Only the simplification of the current contour is
+ * kept, the drawing being streamed when the image size is known.
+ * In the nested mode, the simplifications are already computed and
+ * only written.
+ */
+struct LevelTask{
+  const std::vector< std::vector<Z2i::Point> > *contours;
+  const std::vector<double> *errors;
+  bool flagWidthOnly;
+  bool displayPolygonInline;
+  bool drawImageSize;
+  unsigned int width, height;
+  /// The size of the simplifications of each level, written once all are done.
+  std::vector<std::string> *summaries;
+  /// The simplifications of the nested mode per level, or NULL.
+  const std::vector< std::vector<Simplification> > *simplifications;
+
+  void operator()(std::size_t level, unsigned int /*thread*/) const {
+    stringstream name;
+    name << "output-" << level;
+    ofstream f((name.str()+".txt").c_str(), std::ofstream::out);
+    ofstream eps((name.str()+".eps").c_str());
+    Board2D board;
+    // the bounding box is known: the drawing is written while it is made
+    if(drawImageSize)
+      board.beginStreamEPS(eps, Rect(0, height, width, height), 800, 800);
+    std::ostringstream summary;
+    Simplification simplification;
+    for(unsigned int j=0; j<contours->size(); j++){
+      if(simplifications != NULL){
+	writeSimplification(contours->at(j), (*simplifications)[level][j], board, errors->at(level), f,
+			    summary, displayPolygonInline);
+	continue;
+      }
+      Clock c;
+      c.startClock();
+      simplifyContour(contours->at(j), errors->at(level), flagWidthOnly, simplification);
+      // clock() would count the time spent by all the threads
+      simplification.cpuTime = c.stopClock();
+      writeSimplification(contours->at(j), simplification, board, errors->at(level), f, summary,
+			  displayPolygonInline);
+    }
+    if(drawImageSize){
+      board.setLineWidth(0.0);
+      board.setFillColor( DGtal::Color::None);
+      board.drawRectangle(0,height, width, height);
+      board.endStream();
+    }else{
+      board.saveEPS(eps, 800, 800);
+    }
+    (*summaries)[level] = summary.str();
   }
+};
+
+
+/**
+ * Simplifies all the contours for each error of @a errors in one
+ * run. The vertices of the level i are written in output-i.txt and
+ * its drawing in output-i.eps as soon as the level is done.
+ *
+ * By default, the levels only share the parsing of the input and the
+ * point storage: each one is a full segmentation, so the total time
+ * is the one of separate runs, spread over the threads. With @a
+ * nestedLevels, the contours are simplified concurrently, each level
+ * from the vertices of the finest one (see NestedLevelsTask): only
+ * the finest level reads the points of the contours, but the vertices
+ * of the other levels differ from the ones of separate runs.
+ */
+void processLevels(const std::vector< std::vector<Z2i::Point> > &contours, const std::vector<double> &errors,
+		   bool flagWidthOnly, bool displayPolygonInline, unsigned int nbThreads,
+		   bool drawImageSize, unsigned int width, unsigned int height,
+		   bool nestedLevels){
+  std::vector<std::string> summaries(errors.size());
+  std::vector< std::vector<Simplification> > simplifications;
+  if(nestedLevels && !errors.empty()){
+    simplifications.resize(errors.size(), std::vector<Simplification>(contours.size()));
+    NestedLevelsTask nestedTask;
+    nestedTask.contours = &contours;
+    nestedTask.errors = &errors;
+    nestedTask.finestLevel = std::min_element(errors.begin(), errors.end())-errors.begin();
+    nestedTask.flagWidthOnly = flagWidthOnly;
+    nestedTask.simplifications = &simplifications;
+    profiler.beginPhase("nested levels");
+    WorkStealingScheduler scheduler(nbThreads);
+    scheduler.run(contours.size(), nestedTask);
+    profiler.count("contours", contours.size());
+    profiler.endPhase();
+  }
+  
+  LevelTask task;
+  task.contours = &contours;
+  task.errors = &errors;
+  task.flagWidthOnly = flagWidthOnly;
+  task.displayPolygonInline = displayPolygonInline;
+  task.drawImageSize = drawImageSize;
+  task.width = width;
+  task.height = height;
+  task.summaries = &summaries;
+  task.simplifications = simplifications.empty() ? NULL : &simplifications;
+  profiler.beginPhase("levels");
+  WorkStealingScheduler scheduler(nbThreads);
+  scheduler.run(errors.size(), task);
+  profiler.count("levels", errors.size());
+  profiler.endPhase();
+
+  for(unsigned int i=0; i<summaries.size(); i++)
+    std::cout << summaries[i];
 }
 
 
+/**
+ * Output iterator writing each vertex on a stream, "x y" on one line,
+ * as soon as it is assigned.
+ */
+struct VertexWriter: public std::iterator<std::output_iterator_tag, void, void, void, void>{
+  std::ostream *out;
+  explicit VertexWriter(std::ostream &o): out(&o){}
+  VertexWriter & operator=(const Z2i::Point &p){
+    *out << p[0] << " " << p[1] << "\n";
+    out->flush();
+    return *this;
+  }
+  VertexWriter & operator*(){ return *this; }
+  VertexWriter & operator++(){ return *this; }
+  VertexWriter & operator++(int){ return *this; }
+};
 
 
+/**
+ * Simplifies the contours read on @a in, one point "x y" per line
+ * and an empty line after each contour, and writes each vertex on
+ * @a out as soon as its segment is closed (an empty line ends each
+ * contour). Only the points of the current segment are stored.
+ * As in the other modes, the last point of a contour is dropped
+ * unless it is 4-adjacent to the first one: it is thus processed
+ * one point late.
+ */
+void processStream(std::istream &in, std::ostream &out, double error, bool flagWidthOnly){
+  typedef OnlineFrechetSimplification<Z2i::Point,int> Simplification;
+  Simplification simplification(error, flagWidthOnly);
+  VertexWriter writer(out);
+  Z2i::Point first, pending;
+  bool hasPending = false;
+  unsigned int nbContours = 0;
+  std::string line;
+  bool endOfStream = false;
+  while(!endOfStream){
+    endOfStream = !std::getline(in, line);
+    const char *c = endOfStream ? "" : line.c_str();
+    while(*c == ' ' || *c == '\t' || *c == '\r')
+      ++c;
+    if(*c == '#')
+      continue;
+    if(*c != '\0'){
+      char *next;
+      Z2i::Point p;
+      p[0] = strtol(c, &next, 10);
+      p[1] = strtol(next, &next, 10);
+      if(hasPending)
+	simplification.push(pending, writer);
+      else
+	first = p;
+      pending = p;
+      hasPending = true;
+    }else if(hasPending){
+      // end of the contour
+      if((first-pending).norm1() == 1)
+	simplification.push(pending, writer);
+      trace.info() << "# contour " << nbContours++ << ": " << simplification.size() << " points, "
+		   << simplification.maxBufferSize() << " stored at most" << endl;
+      profiler.count("contours");
+      profiler.count("points", simplification.size());
+      simplification.flush(writer);
+      out << endl;
+      hasPending = false;
+    }
+  }
+}
+
+
+/**
+ * Reads a list of errors separated by commas, e.g. "1,2.5,4".
+ */
+std::vector<double> readErrors(const std::string &list){
+  std::vector<double> errors;
+  std::string item;
+  stringstream ss(list);
+  while(std::getline(ss, item, ',')){
+    if(!item.empty())
+      errors.push_back(atof(item.c_str()));
+  }
+  return errors;
+}
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // Standard services - public :
@@ -149,9 +527,14 @@ int main( int argc, char** argv )
 {
   args.addOption( "-error", "-error <val>:parameter used in the simplification algorithm (Frechet or width) (default is 2)", "2" );
   args.addOption("-sdp", "-sdp <contour.sdp> : Import a contour as a Sequence of Discrete Points (SDP format)", "contour.sdp" );
-  args.addOption( "-imageSize", "-imageSize <width> <height>: used to improve the output display to correspond to an source image by displaying an empty box of width 0 (to force the correspondance of the BB)", "", "" );
+  args.addOption( "-imageSize", "-imageSize <width> <height>: used to improve the output display to correspond to an source image by displaying an empty box of width 0 (to force the correspondance of the BB). With -allContours, the drawing is then written while it is made instead of being kept in memory", "", "" );
   args.addBooleanOption("-w", "-w: compute the simplification using the width only");
   args.addBooleanOption("-allContours", "-allContours: compute the simplification of all the contours (one contour per line given in sdp file)");
+  args.addOption( "-errors", "-errors <e1,e2,...>: compute in one run the simplifications for each error of the list (levels of detail); the level i is saved in output-i.txt and output-i.eps", "2" );
+  args.addBooleanOption("-stream", "-stream: read the contours on the standard input (one point \"x y\" per line, an empty line after each contour) and write the vertices of their simplification on the standard output as soon as they are computed");
+  args.addBooleanOption("-nestedLevels", "-nestedLevels: with -errors, simplify each level from the vertices of the finest level instead of the contour (faster, the error bound still holds, but the vertices differ from the ones of separate runs)");
+  args.addOption( "-threads", "-threads <n>: number of threads used to compute the levels of -errors (default is 0: one per processor)", "0" );
+  args.addOption("-profile", "-profile <file>: write a JSON report of the time and memory used by each step.", "profile.json");
   
   bool parseOK=  args.readArguments( argc, argv );
   
@@ -163,45 +546,93 @@ int main( int argc, char** argv )
 	   << endl;
       return 1;
     }  
+  if(args.check("-profile")){
+    profiler.enable(args.getOption("-profile")->getValue(0), "frechetSimplification");
+  }
   
   Board2D board;   
   double error = args.getOption("-error")->getFloatValue(0);
-  ofstream f;
-  f.open("output.txt", std::ofstream::out);
   
   bool flagWidthOnly = false;
   if(args.check("-w"))
     flagWidthOnly = true;
 
 
+  if( args.check("-stream") ){
+    Profiler::Phase phase(profiler, "segmentation");
+    processStream(std::cin, std::cout, error, flagWidthOnly);
+    return 0;
+  }
+
+  if( args.check("-sdp") && args.check("-errors") ){
+    string fileName = args.getOption("-sdp")->getValue(0);
+    std::vector<double> errors = readErrors(args.getOption("-errors")->getValue(0));
+    std::vector< std::vector<Z2i::Point> > vectContours;
+    profiler.beginPhase("load");
+    if(args.check("-allContours"))
+      vectContours = PointListReader< Z2i::Point >::getPolygonsFromFile(fileName);
+    else
+      vectContours.push_back(PointListReader< Z2i::Point >::getPointsFromFile(fileName));
+    profiler.count("contours", vectContours.size());
+    profiler.endPhase();
+    unsigned int width = 0, height = 0;
+    if(args.check("-imageSize")){
+      width = args.getOption("-imageSize")->getIntValue(0);
+      height = args.getOption("-imageSize")->getIntValue(1);
+    }
+    std::cout << "# curve_size error simplification_size cpu_time  "<< std::endl;
+    processLevels(vectContours, errors, flagWidthOnly, args.check("-allContours"),
+		  args.getOption("-threads")->getIntValue(0),
+		  args.check("-allContours") && args.check("-imageSize"), width, height,
+		  args.check("-nestedLevels"));
+    return 0;
+  }
+
+  ofstream f;
+  f.open("output.txt", std::ofstream::out);
+
   if( args.check("-sdp") && !args.check("-allContours")){
     std::vector<Z2i::Point> contour;
     string fileName = args.getOption("-sdp")->getValue(0);
+    profiler.beginPhase("load");
     contour =   PointListReader< Z2i::Point >::getPointsFromFile(fileName); 
+    profiler.endPhase();
     std::cout << "# curve_size error simplification_size cpu_time  "<< std::endl;
     processContour(contour, board, error, f, flagWidthOnly, false);     
+    Profiler::Phase phase(profiler, "output");
     board.saveEPS("output.eps", 800, 800 ); 
   }
 
 
   if( args.check("-sdp") && args.check("-allContours")  ){
     string fileName = args.getOption("-sdp")->getValue(0);
+    profiler.beginPhase("load");
     std::vector< std::vector<Z2i::Point> > vectContours =   PointListReader< Z2i::Point >::getPolygonsFromFile(fileName);
+    profiler.count("contours", vectContours.size());
+    profiler.endPhase();
+    ofstream eps("output.eps");
+    unsigned int width = 0, height = 0;
+    // the bounding box is known: the drawing is written while it is made
+    if(args.check("-imageSize")){
+      width = args.getOption("-imageSize")->getIntValue(0);
+      height = args.getOption("-imageSize")->getIntValue(1);
+      board.beginStreamEPS(eps, Rect(0, height, width, height), 800, 800);
+    }
     std::cout << "# curve_size error simplification_size cpu_time  " << std::endl;
     for (int j=0; j<vectContours.size(); j++){
       trace.info() << "# Processing contour " << j << endl;
       processContour(vectContours.at(j), board, error,  f, flagWidthOnly, true); 
     }    
 
-      if(args.check("-imageSize")){
-    unsigned int width = args.getOption("-imageSize")->getIntValue(0);
-    unsigned int height = args.getOption("-imageSize")->getIntValue(1);
-    board.setLineWidth(0.0);
-    board.setFillColor( DGtal::Color::None);
-    board.drawRectangle(0,height, width, height);
-  }
-
-    board.saveEPS("output.eps", 800, 800); 
+    Profiler::Phase phase(profiler, "output");
+    if(args.check("-imageSize")){
+      board.setLineWidth(0.0);
+      board.setFillColor( DGtal::Color::None);
+      board.drawRectangle(0,height, width, height);
+      board.endStream();
+    }else{
+      board.saveEPS(eps, 800, 800); 
+    }
   }
 
 
@@ -95,14 +95,22 @@ Board::State::State()
 }
 
 Board::Board( const DGtal::Color & bgColor )
-  : _backgroundColor( bgColor )
+  : _backgroundColor( bgColor ),
+    _stream( 0 ),
+    _streamFormat( NoStream ),
+    _streamClipping( false ),
+    _streamDepth( 0 )
 {
 }
 
 Board::Board( const Board & other )
   : ShapeList( other ),
     _state( other._state ),
-    _backgroundColor( other._backgroundColor )
+    _backgroundColor( other._backgroundColor ),
+    _stream( 0 ),
+    _streamFormat( NoStream ),
+    _streamClipping( false ),
+    _streamDepth( 0 )
 {
 }
 
@@ -138,7 +146,8 @@ Board::operator<<( Unit unit )
 
 Board::~Board()
 {
-
+  if ( _stream )
+    endStream();
 }
 
 void
@@ -350,10 +359,10 @@ void
 Board::drawDot( double x, double y, int depthValue )
 {  
   if ( depthValue != -1 ) 
-    _shapes.push_back( new Dot( _state.unit(x), _state.unit(y),
+    pushShape( new Dot( _state.unit(x), _state.unit(y),
         _state.penColor, _state.lineWidth, depthValue ) );
   else
-    _shapes.push_back( new Dot( _state.unit(x), _state.unit(y),
+    pushShape( new Dot( _state.unit(x), _state.unit(y),
         _state.penColor, _state.lineWidth, _nextDepth-- ) );
 }
 
@@ -362,12 +371,12 @@ Board::drawLine( double x1, double y1, double x2, double y2,
      int depthValue /* = -1 */  )
 {
   if ( depthValue != -1 ) 
-    _shapes.push_back( new Line( _state.unit(x1), _state.unit(y1),
+    pushShape( new Line( _state.unit(x1), _state.unit(y1),
          _state.unit(x2), _state.unit(y2),
          _state.penColor, _state.lineWidth,
          _state.lineStyle, _state.lineCap, _state.lineJoin, depthValue ) );
   else
-    _shapes.push_back( new Line( _state.unit(x1), _state.unit(y1),
+    pushShape( new Line( _state.unit(x1), _state.unit(y1),
          _state.unit(x2), _state.unit(y2),
          _state.penColor, _state.lineWidth,
          _state.lineStyle, _state.lineCap, _state.lineJoin, _nextDepth-- ) );
@@ -379,12 +388,12 @@ Board::drawArrow( double x1, double y1, double x2, double y2,
       int depthValue /* = -1 */  )
 {
   if ( depthValue != -1 )
-    _shapes.push_back( new Arrow( _state.unit(x1), _state.unit(y1),
+    pushShape( new Arrow( _state.unit(x1), _state.unit(y1),
           _state.unit(x2), _state.unit(y2),
           _state.penColor, filledArrow ? _state.penColor : DGtal::Color::None,
           _state.lineWidth, _state.lineStyle, _state.lineCap, _state.lineJoin, depthValue ) );
   else
-    _shapes.push_back( new Arrow( _state.unit(x1), _state.unit(y1),
+    pushShape( new Arrow( _state.unit(x1), _state.unit(y1),
           _state.unit(x2), _state.unit(y2),
           _state.penColor, filledArrow ? _state.penColor : DGtal::Color::None,
           _state.lineWidth, _state.lineStyle, _state.lineCap, _state.lineJoin, _nextDepth-- ) );
@@ -396,7 +405,7 @@ Board::drawRectangle( double x, double y,
           int depthValue /* = -1 */ )
 {
   int d = (depthValue != -1) ? depthValue : _nextDepth--;
-  _shapes.push_back( new Rectangle( _state.unit(x), _state.unit(y), _state.unit(width), _state.unit(height), 
+  pushShape( new Rectangle( _state.unit(x), _state.unit(y), _state.unit(width), _state.unit(height), 
             _state.penColor, _state.fillColor,
             _state.lineWidth, _state.lineStyle, _state.lineCap, _state.lineJoin, d ) );
 }
@@ -407,7 +416,7 @@ Board::drawImage(std::string filename, double x, double y,
      int depthValue, double alpha /* = -1 */ )
 {
   int d = (depthValue != -1) ? depthValue : _nextDepth--;
-  _shapes.push_back( new Image( _state.unit(x), _state.unit(y), _state.unit(width), _state.unit(height), 
+  pushShape( new Image( _state.unit(x), _state.unit(y), _state.unit(width), _state.unit(height), 
         filename, d, alpha ) );
 }
 
@@ -418,7 +427,7 @@ Board::fillRectangle( double x, double y,
           int depthValue /* = -1 */ )
 {
   int d = (depthValue != -1) ? depthValue : _nextDepth--;
-  _shapes.push_back( new Rectangle( _state.unit(x), _state.unit(y), _state.unit(width), _state.unit(height),
+  pushShape( new Rectangle( _state.unit(x), _state.unit(y), _state.unit(width), _state.unit(height),
             DGtal::Color::None, _state.penColor,
             0.0f, _state.lineStyle, _state.lineCap, _state.lineJoin,
             d ) );
@@ -429,7 +438,7 @@ Board::drawCircle( double x, double y, double radius,
        int depthValue /* = -1 */  )
 {
   int d = (depthValue != -1) ? depthValue : _nextDepth--;
-  _shapes.push_back( new Circle( _state.unit(x), _state.unit(y), _state.unit(radius), 
+  pushShape( new Circle( _state.unit(x), _state.unit(y), _state.unit(radius), 
          _state.penColor, _state.fillColor,
          _state.lineWidth, _state.lineStyle, d ) );
 }
@@ -438,7 +447,7 @@ void
 Board::drawArc(double x, double y, double radius, double angle1, double angle2, 
 	       bool neg, int depthValue /*= -1*/ ){
   int d = (depthValue != -1) ? depthValue : _nextDepth--;
-  _shapes.push_back( new Arc( _state.unit(x), _state.unit(y), _state.unit(radius), 
+  pushShape( new Arc( _state.unit(x), _state.unit(y), _state.unit(radius), 
 			      angle1, angle2, neg,_state.penColor,
 			      DGtal::Color::None, _state.lineWidth, _state.lineStyle, d ) );
 }
@@ -450,7 +459,7 @@ Board::fillCircle( double x, double y,
        int depthValue /* = -1 */ )
 {
   int d = (depthValue != -1) ? depthValue : _nextDepth--;
-  _shapes.push_back( new Circle( _state.unit(x), _state.unit(y), _state.unit(radius), 
+  pushShape( new Circle( _state.unit(x), _state.unit(y), _state.unit(radius), 
          DGtal::Color::None, _state.penColor,
          0.0f, _state.lineStyle, d ) );
 }
@@ -461,7 +470,7 @@ Board::drawEllipse( double x, double y,
         int depthValue /* = -1 */  )
 {
   int d = (depthValue != -1) ? depthValue : _nextDepth--;
-  _shapes.push_back( new Ellipse( _state.unit(x), _state.unit(y),
+  pushShape( new Ellipse( _state.unit(x), _state.unit(y),
           _state.unit(xRadius), _state.unit(yRadius),
           _state.penColor,
           _state.fillColor,
@@ -476,7 +485,7 @@ Board::fillEllipse( double x, double y,
         int depthValue /* = -1 */ )
 {
   int d = depthValue ? depthValue : _nextDepth--;
-  _shapes.push_back( new Ellipse( _state.unit(x), _state.unit(y), _state.unit(xRadius), _state.unit(yRadius),
+  pushShape( new Ellipse( _state.unit(x), _state.unit(y), _state.unit(xRadius), _state.unit(yRadius),
           DGtal::Color::None,
           _state.penColor,
           0.0f, 
@@ -496,7 +505,7 @@ Board::drawPolyline( const std::vector<Point> & points,
     (*it) = _state.unit( *it );
     ++it;
   }
-  _shapes.push_back( new Polyline( v, false, _state.penColor, _state.fillColor,
+  pushShape( new Polyline( v, false, _state.penColor, _state.fillColor,
            _state.lineWidth,
            _state.lineStyle,
            _state.lineCap,
@@ -516,7 +525,7 @@ Board::drawClosedPolyline( const std::vector<Point> & points,
     (*it) = _state.unit( *it );
     ++it;
   }
-  _shapes.push_back( new Polyline( v, true, _state.penColor, _state.fillColor,
+  pushShape( new Polyline( v, true, _state.penColor, _state.fillColor,
            _state.lineWidth,
            _state.lineStyle,
            _state.lineCap,
@@ -536,7 +545,7 @@ Board::fillPolyline( const std::vector<Point> & points,
     (*it) = _state.unit( *it );
     ++it;
   }
-  _shapes.push_back( new Polyline( v, true, DGtal::Color::None, _state.penColor,
+  pushShape( new Polyline( v, true, DGtal::Color::None, _state.penColor,
            0.0f,
            _state.lineStyle,
            _state.lineCap,
@@ -555,7 +564,7 @@ Board::drawTriangle( double x1, double y1,
   points.push_back( Point( _state.unit(x1), _state.unit(y1) ) );
   points.push_back( Point( _state.unit(x2), _state.unit(y2) ) );
   points.push_back( Point( _state.unit(x3), _state.unit(y3) ) );
-  _shapes.push_back( new Polyline( points, true, _state.penColor, _state.fillColor,
+  pushShape( new Polyline( points, true, _state.penColor, _state.fillColor,
            _state.lineWidth,
            _state.lineStyle,
            _state.lineCap,
@@ -574,7 +583,7 @@ Board::drawTriangle( const Point & p1,
   points.push_back( Point( _state.unit(p1.x), _state.unit(p1.y) ) );
   points.push_back( Point( _state.unit(p2.x), _state.unit(p2.y) ) );
   points.push_back( Point( _state.unit(p3.x), _state.unit(p3.y) ) );
-  _shapes.push_back( new Polyline( points, true, _state.penColor, _state.fillColor,
+  pushShape( new Polyline( points, true, _state.penColor, _state.fillColor,
            _state.lineWidth,
            _state.lineStyle,
            _state.lineCap,
@@ -593,7 +602,7 @@ Board::fillTriangle( double x1, double y1,
   points.push_back( Point( _state.unit(x1), _state.unit(y1) ) );
   points.push_back( Point( _state.unit(x2), _state.unit(y2) ) );
   points.push_back( Point( _state.unit(x3), _state.unit(y3) ) );
-  _shapes.push_back( new Polyline( points, true, DGtal::Color::None, _state.penColor,
+  pushShape( new Polyline( points, true, DGtal::Color::None, _state.penColor,
            0.0f,
            _state.lineStyle,
            _state.lineCap,
@@ -612,7 +621,7 @@ Board::fillTriangle( const Point & p1,
   points.push_back( Point( _state.unit(p1.x), _state.unit(p1.y) ) );
   points.push_back( Point( _state.unit(p2.x), _state.unit(p2.y) ) );
   points.push_back( Point( _state.unit(p3.x), _state.unit(p3.y) ) );
-  _shapes.push_back( new Polyline( points, true, DGtal::Color::None, _state.penColor,
+  pushShape( new Polyline( points, true, DGtal::Color::None, _state.penColor,
            0.0f,
            _state.lineStyle,
            _state.lineCap,
@@ -631,7 +640,7 @@ Board::fillGouraudTriangle( const Point & p1,
           int depthValue /* = -1 */ )
 {
   int d = (depthValue != -1) ? depthValue : _nextDepth--;
-  _shapes.push_back( new GouraudTriangle( Point( _state.unit(p1.x), _state.unit(p1.y) ), color1,
+  pushShape( new GouraudTriangle( Point( _state.unit(p1.x), _state.unit(p1.y) ), color1,
             Point( _state.unit(p2.x), _state.unit(p2.y) ), color2,
             Point( _state.unit(p3.x), _state.unit(p3.y) ), color3,
             divisions, d ) );
@@ -671,7 +680,7 @@ Board::drawText( double x, double y, const char * text,
      int depthValue /* = -1 */ )
 {
   int d = (depthValue != -1) ? depthValue : _nextDepth--;
-  _shapes.push_back( new Text( _state.unit(x), _state.unit(y), text,
+  pushShape( new Text( _state.unit(x), _state.unit(y), text,
              _state.font, _state.fontSize, _state.penColor, d ) );
 }
 
@@ -679,7 +688,7 @@ void
 Board::drawText( double x, double y, const std::string & str, int depthValue /* = -1 */ )
 {
   int d = (depthValue != -1) ? depthValue : _nextDepth--;
-  _shapes.push_back( new Text( _state.unit(x), _state.unit(y), str,
+  pushShape( new Text( _state.unit(x), _state.unit(y), str,
              _state.font, _state.fontSize, _state.penColor, d ) );
 }
 
@@ -688,7 +697,7 @@ Board::drawBoundingBox( int depthValue /* = -1 */ )
 {
   int d = (depthValue != -1) ? depthValue : _nextDepth--;
   Rect box = boundingBox();
-  _shapes.push_back( new Rectangle( _state.unit(box.left),
+  pushShape( new Rectangle( _state.unit(box.left),
             _state.unit(box.top),
             _state.unit(box.width),
             _state.unit(box.height),
@@ -804,63 +813,7 @@ Board::saveEPS( std::ostream &out, double pageWidth, double pageHeight, double m
   TransformEPS transform;
   transform.setBoundingBox( box, pageWidth, pageHeight, margin );
   
-  out << "%!PS-Adobe-2.0 EPSF-2.0" << std::endl;
-  out << "%%Title:  output.eps " << std::endl;
-  out << "%%Creator: Board library (Copyleft)2007 Sebastien Fourey" << std::endl;
-  {
-    time_t t = time(0);
-    char str_time[255];
-    secured_ctime( str_time, &t, 255 );
-    out << "%%CreationDate: " << str_time;
-  }
-  out << "%%BoundingBox: " << std::setprecision( 8 )
-       << transform.mapX( box.left ) << " "
-       << transform.mapY( box.top - box.height ) << " "
-       << transform.mapX( box.left + box.width ) << " "
-       << transform.mapY( box.top ) << std::endl;
-
-  out << "%Magnification: 1.0000" << std::endl;
-  out << "%%EndComments" << std::endl;
-
-  out << std::endl;
-  out << "/cp {closepath} bind def" << std::endl;
-  out << "/ef {eofill} bind def" << std::endl;
-  out << "/gr {grestore} bind def" << std::endl;
-  out << "/gs {gsave} bind def" << std::endl;
-  out << "/sa {save} bind def" << std::endl;
-  out << "/rs {restore} bind def" << std::endl;
-  out << "/l {lineto} bind def" << std::endl;
-  out << "/m {moveto} bind def" << std::endl;
-  out << "/rm {rmoveto} bind def" << std::endl;
-  out << "/n {newpath} bind def" << std::endl;
-  out << "/s {stroke} bind def" << std::endl;
-  out << "/sh {show} bind def" << std::endl;
-  out << "/slc {setlinecap} bind def" << std::endl;
-  out << "/slj {setlinejoin} bind def" << std::endl;
-  out << "/slw {setlinewidth} bind def" << std::endl;
-  out << "/srgb {setrgbcolor} bind def" << std::endl;
-  out << "/rot {rotate} bind def" << std::endl;
-  out << "/sc {scale} bind def" << std::endl;
-  out << "/sd {setdash} bind def" << std::endl;
-  out << "/ff {findfont} bind def" << std::endl;
-  out << "/sf {setfont} bind def" << std::endl;
-  out << "/scf {scalefont} bind def" << std::endl;
-  out << "/sw {stringwidth} bind def" << std::endl;
-  out << "/sd {setdash} bind def" << std::endl;
-  out << "/tr {translate} bind def" << std::endl;
-  out << " 0.5 setlinewidth" << std::endl;
-
-  if ( clipping ) {
-    out << " newpath ";
-    _clippingPath.flushPostscript( out, transform );
-    out << " 0 slw clip " << std::endl;
-  }
-  
-  // Draw the background color if needed.
-  if ( _backgroundColor != DGtal::Color::None ) { 
-    Rectangle r( box, DGtal::Color::None, _backgroundColor, 0.0f );
-    r.flushPostscript( out, transform );
-  }
+  flushEPSHeader( out, box, transform, clipping );
 
   // Draw the shapes
   std::vector< Shape* > shapes = _shapes;
@@ -1019,6 +972,94 @@ Board::saveSVG( std::ostream &file, double pageWidth, double pageHeight, double
     box = box && _clippingPath.boundingBox();
   transform.setBoundingBox( box, pageWidth, pageHeight, margin );
 
+  flushSVGHeader( file, box, transform, clipping, pageWidth, pageHeight, filename );
+  
+  // Draw the shapes.
+  std::vector< Shape* > shapes = _shapes;
+  stable_sort( shapes.begin(), shapes.end(), shapeGreaterDepth );
+  std::vector< Shape* >::const_iterator i = shapes.begin();
+  std::vector< Shape* >::const_iterator end = shapes.end();
+  while ( i != end ) {
+    (*i)->flushSVG( file, transform );
+    ++i;
+  }  
+
+  if ( clipping )
+    file << "</g>\n</g>";
+  file << "</svg>" << std::endl;
+ 
+}
+
+
+void
+Board::flushEPSHeader( std::ostream & out, const Rect & box,
+                       const TransformEPS & transform, bool clipping ) const
+{
+  out << "%!PS-Adobe-2.0 EPSF-2.0" << std::endl;
+  out << "%%Title:  output.eps " << std::endl;
+  out << "%%Creator: Board library (Copyleft)2007 Sebastien Fourey" << std::endl;
+  {
+    time_t t = time(0);
+    char str_time[255];
+    secured_ctime( str_time, &t, 255 );
+    out << "%%CreationDate: " << str_time;
+  }
+  out << "%%BoundingBox: " << std::setprecision( 8 )
+       << transform.mapX( box.left ) << " "
+       << transform.mapY( box.top - box.height ) << " "
+       << transform.mapX( box.left + box.width ) << " "
+       << transform.mapY( box.top ) << std::endl;
+
+  out << "%Magnification: 1.0000" << std::endl;
+  out << "%%EndComments" << std::endl;
+
+  out << std::endl;
+  out << "/cp {closepath} bind def" << std::endl;
+  out << "/ef {eofill} bind def" << std::endl;
+  out << "/gr {grestore} bind def" << std::endl;
+  out << "/gs {gsave} bind def" << std::endl;
+  out << "/sa {save} bind def" << std::endl;
+  out << "/rs {restore} bind def" << std::endl;
+  out << "/l {lineto} bind def" << std::endl;
+  out << "/m {moveto} bind def" << std::endl;
+  out << "/rm {rmoveto} bind def" << std::endl;
+  out << "/n {newpath} bind def" << std::endl;
+  out << "/s {stroke} bind def" << std::endl;
+  out << "/sh {show} bind def" << std::endl;
+  out << "/slc {setlinecap} bind def" << std::endl;
+  out << "/slj {setlinejoin} bind def" << std::endl;
+  out << "/slw {setlinewidth} bind def" << std::endl;
+  out << "/srgb {setrgbcolor} bind def" << std::endl;
+  out << "/rot {rotate} bind def" << std::endl;
+  out << "/sc {scale} bind def" << std::endl;
+  out << "/sd {setdash} bind def" << std::endl;
+  out << "/ff {findfont} bind def" << std::endl;
+  out << "/sf {setfont} bind def" << std::endl;
+  out << "/scf {scalefont} bind def" << std::endl;
+  out << "/sw {stringwidth} bind def" << std::endl;
+  out << "/sd {setdash} bind def" << std::endl;
+  out << "/tr {translate} bind def" << std::endl;
+  out << " 0.5 setlinewidth" << std::endl;
+
+  if ( clipping ) {
+    out << " newpath ";
+    _clippingPath.flushPostscript( out, transform );
+    out << " 0 slw clip " << std::endl;
+  }
+  
+  // Draw the background color if needed.
+  if ( _backgroundColor != DGtal::Color::None ) { 
+    Rectangle r( box, DGtal::Color::None, _backgroundColor, 0.0f );
+    r.flushPostscript( out, transform );
+  }
+}
+
+void
+Board::flushSVGHeader( std::ostream & file, const Rect & box,
+                       const TransformSVG & transform, bool clipping,
+                       double pageWidth, double pageHeight,
+                       const std::string & filename ) const
+{
   file << "<?xml version=\"1.0\" encoding=\"ISO-8859-1\" standalone=\"no\"?>" << std::endl;
   file << "<!DOCTYPE svg PUBLIC \"-//W3C//DTD SVG 1.1//EN\"" << std::endl;
   file << " \"http://www.w3.org/Graphics/SVG/1.1/DTD/svg11.dtd\">" << std::endl;
@@ -1063,23 +1104,87 @@ Board::saveSVG( std::ostream &file, double pageWidth, double pageHeight, double
     Rectangle r( box, DGtal::Color::None, _backgroundColor, 0.0 );
     r.flushSVG( file, transform );
   }
-  
-  // Draw the shapes.
-  std::vector< Shape* > shapes = _shapes;
-  stable_sort( shapes.begin(), shapes.end(), shapeGreaterDepth );
-  std::vector< Shape* >::const_iterator i = shapes.begin();
-  std::vector< Shape* >::const_iterator end = shapes.end();
-  while ( i != end ) {
-    (*i)->flushSVG( file, transform );
-    ++i;
-  }  
+}
 
-  if ( clipping )
-    file << "</g>\n</g>";
-  file << "</svg>" << std::endl;
- 
+void
+Board::pushShape( Shape * shape )
+{
+  if ( ! _stream ) {
+    _shapes.push_back( shape );
+    return;
+  }
+  if ( shape->depth() > _streamDepth )
+    warning << "Board: a shape of greater depth is streamed over the previous ones.\n";
+  _streamDepth = shape->depth();
+  if ( _streamFormat == StreamEPS )
+    shape->flushPostscript( *_stream, _streamTransformEPS );
+  else
+    shape->flushSVG( *_stream, _streamTransformSVG );
+  delete shape;
 }
 
+void
+Board::beginStreamEPS( std::ostream &out, const Rect & box,
+                       double pageWidth, double pageHeight, double margin )
+{
+  if ( _stream )
+    endStream();
+  Rect b( _state.unit( box.left ), _state.unit( box.top ),
+          _state.unit( box.width ), _state.unit( box.height ) );
+  _streamClipping = _clippingPath.size() > 2;
+  if ( _streamClipping )
+    b = b && _clippingPath.boundingBox();
+  _streamTransformEPS.setBoundingBox( b, pageWidth, pageHeight, margin );
+  flushEPSHeader( out, b, _streamTransformEPS, _streamClipping );
+  _stream = &out;
+  _streamFormat = StreamEPS;
+  _streamDepth = std::numeric_limits<int>::max();
+}
+
+void
+Board::beginStreamSVG( std::ostream &out, const Rect & box,
+                       double pageWidth, double pageHeight, double margin )
+{
+  if ( _stream )
+    endStream();
+  Rect b( _state.unit( box.left ), _state.unit( box.top ),
+          _state.unit( box.width ), _state.unit( box.height ) );
+  _streamClipping = _clippingPath.size() > 2;
+  if ( _streamClipping )
+    b = b && _clippingPath.boundingBox();
+  _streamTransformSVG.setBoundingBox( b, pageWidth, pageHeight, margin );
+  flushSVGHeader( out, b, _streamTransformSVG, _streamClipping,
+                  pageWidth, pageHeight, "output.svg" );
+  _stream = &out;
+  _streamFormat = StreamSVG;
+  _streamDepth = std::numeric_limits<int>::max();
+}
+
+void
+Board::endStream()
+{
+  if ( ! _stream )
+    return;
+  std::ostream & out = *_stream;
+  if ( _streamFormat == StreamEPS ) {
+    out << "showpage" << std::endl;
+    out << "%%Trailer" << std::endl;
+    out << "%EOF" << std::endl;
+  } else {
+    if ( _streamClipping )
+      out << "</g>\n</g>";
+    out << "</svg>" << std::endl;
+  }
+  _stream = 0;
+  _streamFormat = NoStream;
+  _streamClipping = false;
+}
+
+bool
+Board::isStreaming() const
+{
+  return _stream != 0;
+}
 
 void
 Board::save( const char * filename, double pageWidth, double pageHeight, double margin ) const 
@@ -915,8 +915,87 @@ public:
    */
   void saveTikZ( std::ostream &out, double pageWidth, double pageHeight, double margin = 10.0 ) const ;
 
+  /** 
+   * Starts writing the drawing in EPS format through an output
+   * stream while it is drawn: the shapes are no longer stored in the
+   * board, but written on the stream as soon as they are added, in
+   * the order of their insertion. The memory used is thus
+   * independent of the number of shapes.
+   *
+   * Depths are not sorted: the output matches the one of saveEPS()
+   * only if each shape has a depth lower than or equal to the
+   * previous one, which is the case of the shapes drawn with the
+   * default depths. A warning is issued when a shape of greater
+   * depth is written, as it lays above shapes that saveEPS() would
+   * draw over it. As the
+   * bounding box cannot be computed from the shapes, it must be
+   * given: shapes outside of it are written but lay outside of the
+   * page. The current clipping path and background color are used.
+   * 
+   * @param out The output stream, which must remain valid until endStream().
+   * @param box The bounding box of the drawing, in the current unit.
+   * @param pageWidth Width of the page in millimeters.
+   * @param pageHeight Height of the page in millimeters.
+   * @param margin Minimal margin around the figure in the page, in millimeters.
+   */
+  void beginStreamEPS( std::ostream &out, const Rect & box,
+                       double pageWidth, double pageHeight, double margin = 10.0 );
+
+  /** 
+   * Starts writing the drawing in SVG format through an output
+   * stream while it is drawn (see beginStreamEPS()).
+   * 
+   * @param out The output stream, which must remain valid until endStream().
+   * @param box The bounding box of the drawing, in the current unit.
+   * @param pageWidth Width of the page in millimeters.
+   * @param pageHeight Height of the page in millimeters.
+   * @param margin Minimal margin around the figure in the page, in millimeters.
+   */
+  void beginStreamSVG( std::ostream &out, const Rect & box,
+                       double pageWidth, double pageHeight, double margin = 10.0 );
+
+  /** 
+   * Ends the drawing started by beginStreamEPS() or beginStreamSVG():
+   * the end of the file is written and the board stores the next
+   * shapes again. Called by the destructor if needed.
+   */
+  void endStream();
+
+  /** 
+   * @return true if the shapes are written on a stream as they are
+   * drawn (see beginStreamEPS()).
+   */
+  bool isStreaming() const;
+
  protected:
 
+  /** 
+   * Adds a shape, dynamically allocated by the caller, to the
+   * board. In streaming mode, it is written and deleted at once.
+   * 
+   * @param shape The shape, acquired by the board.
+   */
+  virtual void pushShape( Shape * shape );
+
+  /** 
+   * Writes the beginning of an EPS file, up to the background.
+   */
+  void flushEPSHeader( std::ostream & out, const Rect & box,
+                       const TransformEPS & transform, bool clipping ) const;
+
+  /** 
+   * Writes the beginning of an SVG file, up to the background.
+   */
+  void flushSVGHeader( std::ostream & out, const Rect & box,
+                       const TransformSVG & transform, bool clipping,
+                       double pageWidth, double pageHeight,
+                       const std::string & filename ) const;
+
+  /** 
+   * Output format of the streaming mode.
+   */
+  enum StreamFormat { NoStream, StreamEPS, StreamSVG };
+
   /**
    * Current graphical state for drawings made by the drawSomething() methods.
    * 
@@ -939,6 +1018,12 @@ public:
   State _state;       /**< The current state. */
   DGtal::Color _backgroundColor;   /**< The color of the background. */
   Path _clippingPath;
+  std::ostream * _stream;           /**< The output stream of the streaming mode, or 0. */
+  StreamFormat _streamFormat;       /**< The format written on the stream. */
+  bool _streamClipping;             /**< True if the stream is clipped. */
+  TransformEPS _streamTransformEPS; /**< The transform of an EPS stream. */
+  TransformSVG _streamTransformSVG; /**< The transform of an SVG stream. */
+  int _streamDepth;                 /**< The depth of the last streamed shape. */
 };
 
 } // namespace LibBoard
@@ -103,14 +103,14 @@ ShapeList::operator<<( const Shape & shape )
         while ( i != end ) {
             Shape * s = (*i)->clone();
             s->depth( _nextDepth-- );
-            _shapes.push_back( s );
+            pushShape( s );
             ++i;
         }
     } else {
         Shape * s = shape.clone();
         if ( s->depth() == -1 )
             s->depth( _nextDepth-- );
-        _shapes.push_back( s );
+        pushShape( s );
         if ( typeid( shape ) == typeid( Group ) ) {
             _nextDepth = dynamic_cast<const Group&>(shape).minDepth() - 1;
         }
@@ -133,7 +133,7 @@ ShapeList::addShape( const Shape & shape, double scaleFactor )
             s->depth( _nextDepth-- );
             if ( scaleFactor != 1.0 )
                 s->scaleAll( scaleFactor );
-            _shapes.push_back( s );
+            pushShape( s );
             ++i;
         }
     } else {
@@ -142,7 +142,7 @@ ShapeList::addShape( const Shape & shape, double scaleFactor )
             s->depth( _nextDepth-- );
         if ( scaleFactor != 1.0 )
             s->scaleAll( scaleFactor );
-        _shapes.push_back( s );
+        pushShape( s );
         if ( typeid( shape ) == typeid( Group ) ) {
             _nextDepth = dynamic_cast<const Group&>(shape).minDepth() - 1;
         }
@@ -171,15 +171,21 @@ ShapeList::operator+=( const Shape & shape )
         std::vector<Shape*>::const_iterator end = sl._shapes.end();
         while ( i != end ) {
             Shape * s = (*i)->clone();
-            _shapes.push_back( s );
+            pushShape( s );
             ++i;
         }
     } else {
-        _shapes.push_back( shape.clone() );
+        pushShape( shape.clone() );
     }
     return *this;
 }
 
+void
+ShapeList::pushShape( Shape * shape )
+{
+    _shapes.push_back( shape );
+}
+
 ShapeList &
 ShapeList::insert( const Shape & , int /* depth */ )
 {
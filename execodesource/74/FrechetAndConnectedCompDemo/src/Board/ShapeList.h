@@ -166,6 +166,14 @@ protected:
 
   void addShape( const Shape & shape, double scaleFactor );
 
+  /** 
+   * Appends a shape, dynamically allocated by the caller, to the
+   * list. All the insertions go through this method.
+   * 
+   * @param shape The shape, acquired by the list.
+   */
+  virtual void pushShape( Shape * shape );
+
   std::vector<Shape*> _shapes;  /**< The vector of shapes. */
   int _nextDepth;    /**< The depth of the next figure to be added.  */
 
@@ -0,0 +1,293 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file Profiler.cpp
+ *
+ * Implementation of methods defined in Profiler.h
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <fstream>
+#include <ctime>
+#include <cstring>
+#include "DGtal/base/Profiler.h"
+
+#if ( (defined(UNIX)||defined(unix)||defined(linux)||defined(__MACH__)) )
+#include <sys/resource.h>
+#endif
+///////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+  Profiler profiler;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// class Profiler
+///////////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  /// Writes @a s as a JSON string: quotes, backslashes and control
+  /// characters are escaped.
+  void writeString( std::ostream & out, const std::string & s )
+  {
+    static const char hex[] = "0123456789abcdef";
+    out << '"';
+    for ( std::string::const_iterator it = s.begin(); it != s.end(); ++it )
+      {
+        const unsigned char c = static_cast<unsigned char>( *it );
+        if ( ( c == '"' ) || ( c == '\\' ) )
+          out << '\\' << *it;
+        else if ( c < 0x20 )
+          out << "\\u00" << hex[ c >> 4 ] << hex[ c & 0xf ];
+        else
+          out << *it;
+      }
+    out << '"';
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+DGtal::Profiler::Profiler()
+  : myEnabled( false ), myWritten( false )
+{
+}
+
+DGtal::Profiler::~Profiler()
+{
+  if ( myEnabled && ! myWritten )
+    writeReport();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Interface - public :
+
+void
+DGtal::Profiler::enable( const std::string & filename,
+                         const std::string & program )
+{
+  myEnabled = true;
+  myWritten = false;
+  myFilename = filename;
+  myRecords.clear();
+  myStack.clear();
+
+  Record root;
+  root.name = program;
+  root.calls = 1;
+  root.wallTime = 0;
+  root.cpuTime = 0;
+  root.peakRSS = 0;
+  myRecords.push_back( root );
+  Running running;
+  running.record = 0;
+  running.cpuStart = cpuTime();
+  myStack.push_back( running );
+  myStack.back().clock.startClock();
+}
+
+//-----------------------------------------------------------------------------
+void
+DGtal::Profiler::writeReport( std::ostream & out )
+{
+  if ( myRecords.empty() )
+    return;
+  Record & root = myRecords[ 0 ];
+  root.wallTime = myStack[ 0 ].clock.stopClock();
+  root.cpuTime = cpuTime() - myStack[ 0 ].cpuStart;
+  root.peakRSS = peakRSS();
+
+  out << "{" << std::endl << "  \"program\": ";
+  writeString( out, root.name );
+  out << "," << std::endl;
+  writeRecord( out, 0, "  " );
+  out << "}" << std::endl;
+}
+
+//-----------------------------------------------------------------------------
+bool
+DGtal::Profiler::writeReport()
+{
+  std::ofstream out( myFilename.c_str() );
+  writeReport( out );
+  myWritten = true;
+  if ( ! out.good() )
+    {
+      std::cerr << "[Profiler::writeReport] cannot write " << myFilename
+                << std::endl;
+      return false;
+    }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+double
+DGtal::Profiler::cpuTime()
+{
+  return 1000.0 * (double) std::clock() / (double) CLOCKS_PER_SEC;
+}
+
+//-----------------------------------------------------------------------------
+long
+DGtal::Profiler::peakRSS()
+{
+#if ( (defined(UNIX)||defined(unix)||defined(linux)||defined(__MACH__)) )
+  struct rusage usage;
+  if ( getrusage( RUSAGE_SELF, &usage ) != 0 )
+    return 0;
+#ifdef __MACH__
+  return (long) ( usage.ru_maxrss / 1024 ); // bytes on OS X
+#else
+  return (long) usage.ru_maxrss;
+#endif
+#else
+  return 0;
+#endif
+}
+
+//-----------------------------------------------------------------------------
+void
+DGtal::Profiler::selfDisplay ( std::ostream & out ) const
+{
+  out << "[Profiler] " << ( myEnabled ? myFilename : "disabled" )
+      << " phases=" << myRecords.size();
+}
+
+//-----------------------------------------------------------------------------
+bool
+DGtal::Profiler::isValid() const
+{
+  return ! myEnabled || ! myStack.empty();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Internals - private :
+
+void
+DGtal::Profiler::doBeginPhase( const char * name )
+{
+  const std::size_t parent = myStack.back().record;
+  std::size_t r = 0;
+  std::vector< std::size_t > & children = myRecords[ parent ].children;
+  std::size_t i = 0;
+  for ( ; i < children.size(); ++i )
+    if ( myRecords[ children[ i ] ].name == name )
+      break;
+  if ( i < children.size() )
+    r = children[ i ];
+  else
+    {
+      Record record;
+      record.name = name;
+      record.calls = 0;
+      record.wallTime = 0;
+      record.cpuTime = 0;
+      record.peakRSS = 0;
+      r = myRecords.size();
+      myRecords.push_back( record );
+      myRecords[ parent ].children.push_back( r );
+    }
+  myRecords[ r ].calls++;
+
+  Running running;
+  running.record = r;
+  running.cpuStart = cpuTime();
+  myStack.push_back( running );
+  myStack.back().clock.startClock();
+}
+
+//-----------------------------------------------------------------------------
+void
+DGtal::Profiler::doEndPhase()
+{
+  // the whole program is never ended
+  if ( myStack.size() <= 1 )
+    return;
+  Running & running = myStack.back();
+  Record & record = myRecords[ running.record ];
+  record.wallTime += running.clock.stopClock();
+  record.cpuTime += cpuTime() - running.cpuStart;
+  record.peakRSS = peakRSS();
+  myStack.pop_back();
+}
+
+//-----------------------------------------------------------------------------
+void
+DGtal::Profiler::doCount( const char * name, unsigned long n )
+{
+  std::vector< std::pair< std::string, unsigned long > > & counters
+    = myRecords[ myStack.back().record ].counters;
+  for ( std::size_t i = 0; i < counters.size(); ++i )
+    if ( std::strcmp( counters[ i ].first.c_str(), name ) == 0 )
+      {
+        counters[ i ].second += n;
+        return;
+      }
+  counters.push_back( std::make_pair( std::string( name ), n ) );
+}
+
+//-----------------------------------------------------------------------------
+void
+DGtal::Profiler::writeRecord( std::ostream & out, std::size_t r,
+                              const std::string & indent ) const
+{
+  const Record & record = myRecords[ r ];
+  out << indent << "\"calls\": " << record.calls << "," << std::endl
+      << indent << "\"wallTimeMs\": " << record.wallTime << "," << std::endl
+      << indent << "\"cpuTimeMs\": " << record.cpuTime << "," << std::endl
+      << indent << "\"peakRSSKB\": " << record.peakRSS << "," << std::endl
+      << indent << "\"counters\": {";
+  for ( std::size_t i = 0; i < record.counters.size(); ++i )
+    {
+      out << ( i > 0 ? ", " : " " );
+      writeString( out, record.counters[ i ].first );
+      out << ": " << record.counters[ i ].second;
+    }
+  out << " }," << std::endl << indent << "\"phases\": [";
+  for ( std::size_t i = 0; i < record.children.size(); ++i )
+    {
+      const std::size_t c = record.children[ i ];
+      out << ( i > 0 ? "," : "" ) << std::endl
+          << indent << "  {" << std::endl
+          << indent << "    \"name\": ";
+      writeString( out, myRecords[ c ].name );
+      out << "," << std::endl;
+      writeRecord( out, c, indent + "    " );
+      out << indent << "  }";
+    }
+  if ( ! record.children.empty() )
+    out << std::endl << indent;
+  out << "]" << std::endl;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Implementation of inline functions                                        //
+
+std::ostream&
+DGtal::operator<< ( std::ostream & out, const Profiler & object )
+{
+  object.selfDisplay( out );
+  return out;
+}
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,282 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file Profiler.h
+ *
+ * @brief Named phases and counters of a program, reported as JSON.
+ *
+ * Header file for module Profiler.cpp
+ *
+ * This file is part of the DGtal library.
+ *
+ * @see testProfiler.cpp
+ */
+
+#if defined(Profiler_RECURSES)
+#error Recursive header files inclusion detected in Profiler.h
+#else // defined(Profiler_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define Profiler_RECURSES
+
+#if !defined Profiler_h
+/** Prevents repeated inclusion of headers. */
+#define Profiler_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include "DGtal/base/Clock.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // class Profiler
+  /**
+   * Description of class 'Profiler' <p>
+   * \brief Aim: Measures the named phases of a program (wall time,
+   * CPU time, peak resident memory, item counters) and writes them
+   * as a JSON report.
+   *
+   * Nothing is measured until enable() is called: a phase or a
+   * counter then only costs a test of a boolean, so that the calls
+   * can stay in the programs. The phases are nested as the calls of
+   * beginPhase() and endPhase(); the phases with the same name and
+   * the same parent are merged, their number of calls is counted. A
+   * counter is added to the current phase.
+   *
+   * The global object DGtal::profiler is used by the demonstration
+   * programs with the option -profile <file>; the report is written
+   * to the file when the program ends. The profiler must only be
+   * used from the main thread.
+   *
+   *  \code
+   *  profiler.enable( "report.json", "pgm2freeman" );
+   *  {
+   *    Profiler::Phase phase( profiler, "tracking" );
+   *    ...
+   *    profiler.count( "contours", contours.size() );
+   *  }
+   *  \endcode
+   *
+   * The report looks like:
+   *  \code
+   *  { "program": "pgm2freeman", "calls": 1, "wallTimeMs": 35.2,
+   *    "cpuTimeMs": 34.9, "peakRSSKB": 10240, "counters": { },
+   *    "phases": [ { "name": "tracking", "calls": 1, ... } ] }
+   *  \endcode
+   */
+  class Profiler
+  {
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+     * Phase measured during the life of the object.
+     */
+    class Phase
+    {
+    public:
+      /**
+       * Begins the phase @a name.
+       * @param aProfiler the profiler.
+       * @param name the name of the phase.
+       */
+      Phase( Profiler & aProfiler, const char * name )
+        : myProfiler( aProfiler )
+      { myProfiler.beginPhase( name ); }
+
+      /**
+       * Ends the phase.
+       */
+      ~Phase()
+      { myProfiler.endPhase(); }
+
+    private:
+      /// The profiler.
+      Profiler & myProfiler;
+      Phase( const Phase & other );
+      Phase & operator=( const Phase & other );
+    };
+
+    /**
+     * Constructor. The profiler is disabled.
+     */
+    Profiler();
+
+    /**
+     * Destructor. Writes the report if the profiler is enabled and
+     * the report has not been written yet.
+     */
+    ~Profiler();
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * Enables the profiler: starts the measure of the whole program.
+     *
+     * @param filename the file of the report.
+     * @param program the name of the program.
+     */
+    void enable( const std::string & filename, const std::string & program );
+
+    /**
+     * @return 'true' if the profiler measures the phases.
+     */
+    bool isEnabled() const
+    { return myEnabled; }
+
+    /**
+     * Begins a phase, nested in the current one.
+     * @param name the name of the phase.
+     */
+    void beginPhase( const char * name )
+    { if ( myEnabled ) doBeginPhase( name ); }
+
+    /**
+     * Ends the current phase.
+     */
+    void endPhase()
+    { if ( myEnabled ) doEndPhase(); }
+
+    /**
+     * Adds @a n to the counter @a name of the current phase.
+     * @param name the name of the counter.
+     * @param n the number of counted items.
+     */
+    void count( const char * name, unsigned long n = 1 )
+    { if ( myEnabled ) doCount( name, n ); }
+
+    /**
+     * Writes the report in JSON.
+     * @param out the output stream where the report is written.
+     */
+    void writeReport( std::ostream & out );
+
+    /**
+     * Writes the report in the file given to enable().
+     * @return 'false' if the file could not be written.
+     */
+    bool writeReport();
+
+    /**
+     * @return the CPU time of the process, in ms.
+     */
+    static double cpuTime();
+
+    /**
+     * @return the peak resident memory of the process, in KB (0 if
+     * not available on this system).
+     */
+    static long peakRSS();
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+
+    /**
+     * Measures of a phase, for all its calls.
+     */
+    struct Record
+    {
+      std::string name;
+      unsigned long calls;
+      double wallTime;
+      double cpuTime;
+      long peakRSS;
+      std::vector< std::pair< std::string, unsigned long > > counters;
+      std::vector< std::size_t > children;
+    };
+
+    /**
+     * A running phase.
+     */
+    struct Running
+    {
+      std::size_t record;
+      Clock clock;
+      double cpuStart;
+    };
+
+    /// 'true' when the phases are measured.
+    bool myEnabled;
+    /// 'true' when the report has been written.
+    bool myWritten;
+    /// The file of the report.
+    std::string myFilename;
+    /// The phases, the whole program first.
+    std::vector< Record > myRecords;
+    /// The running phases, the whole program first.
+    std::vector< Running > myStack;
+
+    // ------------------------- Hidden services ------------------------------
+  private:
+
+    Profiler( const Profiler & other );
+    Profiler & operator=( const Profiler & other );
+
+    void doBeginPhase( const char * name );
+    void doEndPhase();
+    void doCount( const char * name, unsigned long n );
+
+    /**
+     * Writes the record @a r and its children.
+     */
+    void writeRecord( std::ostream & out, std::size_t r,
+                      const std::string & indent ) const;
+
+  }; // end of class Profiler
+
+  /// The profiler of the programs.
+  extern Profiler profiler;
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'Profiler'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'Profiler' to write.
+   * @return the output stream after the writing.
+   */
+  std::ostream&
+  operator<< ( std::ostream & out, const Profiler & object );
+
+} // namespace DGtal
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined Profiler_h
+
+#undef Profiler_RECURSES
+#endif // else defined(Profiler_RECURSES)
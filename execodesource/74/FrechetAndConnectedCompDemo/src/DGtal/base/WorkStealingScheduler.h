@@ -0,0 +1,278 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file WorkStealingScheduler.h
+ *
+ * @brief A portable thread pool running independent tasks with work stealing.
+ *
+ * Header file for module WorkStealingScheduler.ih
+ *
+ * This file is part of the DGtal library.
+ *
+ * @see testWorkStealingScheduler.cpp
+ */
+
+#if defined(WorkStealingScheduler_RECURSES)
+#error Recursive header files inclusion detected in WorkStealingScheduler.h
+#else // defined(WorkStealingScheduler_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define WorkStealingScheduler_RECURSES
+
+#if !defined WorkStealingScheduler_h
+/** Prevents repeated inclusion of headers. */
+#define WorkStealingScheduler_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <cstddef>
+#include "DGtal/base/Common.h"
+
+#ifdef WITH_PTHREAD
+#include <pthread.h>
+#endif
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // class WorkStealingScheduler
+  /**
+   * Description of class 'WorkStealingScheduler' <p>
+   * \brief Aim: Run a given number of independent tasks on a pool of
+   * threads, balancing the load by work stealing.
+   *
+   * The tasks are numbered from 0 to n-1 and initially split into
+   * one contiguous range per thread. Each thread processes its own
+   * range from the front; once it is empty, the thread steals the
+   * upper half of the range of another thread. The calling thread
+   * takes part in the computation and run() returns once every task
+   * is done.
+   *
+   * If DGtal has been built with POSIX threads support (WITH_PTHREAD
+   * flag, set by default when they are found), the tasks are
+   * processed concurrently;
+   * otherwise they are processed sequentially by the calling thread,
+   * in increasing order. This class is used as the parallel backend
+   * of the separable distance transformations (VoronoiMap, PowerMap)
+   * when OpenMP is not available.
+   *
+   * The task functor must be a model of a binary function
+   * <tt>void operator()( std::size_t task, unsigned int thread )</tt>
+   * where @a thread is the index (in [0, threadNumber()) ) of the
+   * thread running the task. It is typically used to select per
+   * thread buffers. Tasks must not write to shared data.
+   *
+   *  \code
+   *  #include "DGtal/base/WorkStealingScheduler.h"
+   *
+   *  struct MyTask
+   *  {
+   *    void operator()( std::size_t task, unsigned int thread ) const
+   *    { ... }
+   *  };
+   *
+   *  WorkStealingScheduler scheduler;
+   *  MyTask f;
+   *  scheduler.run( 1000, f );
+   *  \endcode
+   *
+   * @see testWorkStealingScheduler.cpp
+   */
+  class WorkStealingScheduler
+  {
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param nbThreads the number of threads of the pool (the calling
+     * thread included). If 0, defaultThreadNumber() threads are
+     * used. It is always 1 without POSIX threads support.
+     */
+    WorkStealingScheduler( unsigned int nbThreads = 0 );
+
+    /**
+     * Destructor.
+     */
+    ~WorkStealingScheduler();
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * @return the number of threads used by run().
+     */
+    unsigned int threadNumber() const;
+
+    /**
+     * Runs the tasks 0, ..., @a nbTasks - 1 and returns when all of
+     * them are done.
+     *
+     * @tparam TTaskFunctor the type of the task functor (see class
+     * description).
+     * @param nbTasks the number of tasks.
+     * @param aFunctor the task functor.
+     */
+    template <typename TTaskFunctor>
+    void run( std::size_t nbTasks, TTaskFunctor & aFunctor ) const;
+
+    /**
+     * @return the number of threads used by default by the
+     * schedulers (the number of processors unless it has been
+     * changed by setDefaultThreadNumber()).
+     */
+    static unsigned int defaultThreadNumber();
+
+    /**
+     * Sets the number of threads used by default by the schedulers,
+     * e.g. by the distance transformations.
+     *
+     * @param nbThreads the number of threads, 0 to use one thread per
+     * processor.
+     */
+    static void setDefaultThreadNumber( unsigned int nbThreads );
+
+    /**
+     * @return the number of processors available (at least 1).
+     */
+    static unsigned int hardwareConcurrency();
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+
+    /// Number of threads of the pool.
+    unsigned int myThreadNumber;
+
+    // ------------------------- Hidden services ------------------------------
+  private:
+
+    /**
+     * @return a reference to the user defined default number of
+     * threads (0 if unset).
+     */
+    static unsigned int & defaultThreadNumberSetting();
+
+#ifdef WITH_PTHREAD
+    /// The pending tasks [begin, end) of one thread.
+    struct TaskRange
+    {
+      std::size_t begin;
+      std::size_t end;
+      pthread_mutex_t mutex;
+    };
+
+    /// What a worker thread needs to know.
+    template <typename TTaskFunctor>
+    struct Worker
+    {
+      TaskRange * ranges;
+      unsigned int nbThreads;
+      unsigned int id;
+      TTaskFunctor * functor;
+    };
+
+    /**
+     * Main loop of a worker: process its own range, then steal from
+     * the others until every range is empty.
+     * @param aWorker a pointer to a Worker<TTaskFunctor>.
+     */
+    template <typename TTaskFunctor>
+    static void * workerLoop( void * aWorker );
+
+    /**
+     * Pops the next task of the range @a id.
+     * @param ranges the ranges of all the threads.
+     * @param id the index of the range.
+     * @param task (returns) the popped task.
+     * @return 'true' if a task has been popped.
+     */
+    static bool popTask( TaskRange * ranges, unsigned int id,
+                         std::size_t & task );
+
+    /**
+     * Moves the upper half of the range of another thread into the
+     * (empty) range @a id.
+     * @param ranges the ranges of all the threads.
+     * @param nbThreads the number of ranges.
+     * @param id the index of the range of the thief.
+     * @return 'true' if some tasks have been stolen.
+     */
+    static bool steal( TaskRange * ranges, unsigned int nbThreads,
+                       unsigned int id );
+#endif
+
+    // ------------------------- Hidden services ------------------------------
+  private:
+
+    /**
+     * Copy constructor.
+     * @param other the object to clone.
+     * Forbidden by default.
+     */
+    WorkStealingScheduler ( const WorkStealingScheduler & other );
+
+    /**
+     * Assignment.
+     * @param other the object to copy.
+     * @return a reference on 'this'.
+     * Forbidden by default.
+     */
+    WorkStealingScheduler & operator= ( const WorkStealingScheduler & other );
+
+  }; // end of class WorkStealingScheduler
+
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'WorkStealingScheduler'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'WorkStealingScheduler' to write.
+   * @return the output stream after the writing.
+   */
+  std::ostream&
+  operator<< ( std::ostream & out, const WorkStealingScheduler & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/base/WorkStealingScheduler.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined WorkStealingScheduler_h
+
+#undef WorkStealingScheduler_RECURSES
+#endif // else defined(WorkStealingScheduler_RECURSES)
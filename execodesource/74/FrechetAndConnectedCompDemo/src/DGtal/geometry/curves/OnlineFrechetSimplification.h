@@ -0,0 +1,306 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file OnlineFrechetSimplification.h
+ *
+ * @brief Greedy Frechet simplification of a stream of points.
+ *
+ * Header file for module OnlineFrechetSimplification.ih
+ *
+ * This file is part of the DGtal library.
+ *
+ * @see testOnlineFrechetSimplification.cpp
+ */
+
+#if defined(OnlineFrechetSimplification_RECURSES)
+#error Recursive header files inclusion detected in OnlineFrechetSimplification.h
+#else // defined(OnlineFrechetSimplification_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define OnlineFrechetSimplification_RECURSES
+
+#if !defined OnlineFrechetSimplification_h
+/** Prevents repeated inclusion of headers. */
+#define OnlineFrechetSimplification_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <iterator>
+#include <deque>
+#include <cstddef>
+#include "DGtal/base/Common.h"
+#include "DGtal/geometry/curves/FrechetShortcut.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class OnlineFrechetSimplification
+  /**
+   * Description of template class 'OnlineFrechetSimplification' <p>
+   * \brief Aim: Computes the greedy segmentation of a digital curve
+   * into Frechet shortcuts (see FrechetShortcut) while its points
+   * are read, one at a time.
+   *
+   * The vertices of the simplification are the first points of the
+   * segments. They are the same, and given in the same order, as the
+   * ones of a GreedySegmentation<FrechetShortcut> of the whole
+   * (open) curve. A vertex is output as soon as the segment that
+   * starts at it can no longer be extended, and the last one when
+   * flush() is called.
+   *
+   * Only the points of the current segment are stored: the memory
+   * needed is bounded by the length of the longest segment, and not
+   * by the length of the curve.
+   *
+   * As FrechetShortcut, it only processes 8-connected curves.
+   *
+   *  \code
+   *  OnlineFrechetSimplification<Z2i::Point> simplification( error );
+   *  std::vector<Z2i::Point> vertices;
+   *  Z2i::Point p;
+   *  while ( read( p ) )
+   *    simplification.push( p, std::back_inserter( vertices ) );
+   *  simplification.flush( std::back_inserter( vertices ) );
+   *  \endcode
+   *
+   * @tparam TPoint the type of the points.
+   * @tparam TInteger the type of the integers used by the shortcuts.
+   *
+   * @see FrechetShortcut GreedySegmentation testOnlineFrechetSimplification.cpp
+   */
+  template <typename TPoint,
+            typename TInteger = typename TPoint::Coordinate>
+  class OnlineFrechetSimplification
+  {
+    // ----------------------- Types ------------------------------
+  public:
+
+    typedef TPoint Point;
+    typedef TInteger Integer;
+
+    /**
+     * Random access iterator on the stored points. It remains valid
+     * while the point it refers to is stored, whatever the number of
+     * points read afterwards.
+     */
+    class ConstIterator
+      : public std::iterator<std::random_access_iterator_tag, Point,
+                             std::ptrdiff_t, const Point *, const Point &>
+    {
+    public:
+      ConstIterator(): myOwner( 0 ), myIndex( 0 ) {}
+      ConstIterator( const OnlineFrechetSimplification * owner,
+                     std::ptrdiff_t index )
+        : myOwner( owner ), myIndex( index ) {}
+
+      const Point & operator*() const
+      { return myOwner->myPoints[ myIndex - myOwner->myOffset ]; }
+      const Point * operator->() const
+      { return &( operator*() ); }
+      const Point & operator[]( std::ptrdiff_t n ) const
+      { return *( *this + n ); }
+
+      ConstIterator & operator++() { ++myIndex; return *this; }
+      ConstIterator operator++( int )
+      { ConstIterator tmp( *this ); ++myIndex; return tmp; }
+      ConstIterator & operator--() { --myIndex; return *this; }
+      ConstIterator operator--( int )
+      { ConstIterator tmp( *this ); --myIndex; return tmp; }
+      ConstIterator & operator+=( std::ptrdiff_t n )
+      { myIndex += n; return *this; }
+      ConstIterator & operator-=( std::ptrdiff_t n )
+      { myIndex -= n; return *this; }
+      ConstIterator operator+( std::ptrdiff_t n ) const
+      { return ConstIterator( myOwner, myIndex + n ); }
+      ConstIterator operator-( std::ptrdiff_t n ) const
+      { return ConstIterator( myOwner, myIndex - n ); }
+      std::ptrdiff_t operator-( const ConstIterator & other ) const
+      { return myIndex - other.myIndex; }
+
+      bool operator==( const ConstIterator & other ) const
+      { return myIndex == other.myIndex; }
+      bool operator!=( const ConstIterator & other ) const
+      { return myIndex != other.myIndex; }
+      bool operator<( const ConstIterator & other ) const
+      { return myIndex < other.myIndex; }
+      bool operator>( const ConstIterator & other ) const
+      { return myIndex > other.myIndex; }
+      bool operator<=( const ConstIterator & other ) const
+      { return myIndex <= other.myIndex; }
+      bool operator>=( const ConstIterator & other ) const
+      { return myIndex >= other.myIndex; }
+
+    private:
+      /// The simplification that stores the points.
+      const OnlineFrechetSimplification * myOwner;
+      /// Index of the point in the stream.
+      std::ptrdiff_t myIndex;
+    };
+
+    typedef FrechetShortcut<ConstIterator, Integer> SegmentComputer;
+
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+     * Constructor.
+     * @param error the maximal Frechet distance (or width if @a
+     * flagWidthOnly is 'true') between the curve and its
+     * simplification.
+     * @param flagWidthOnly when 'true', only the width criterion is
+     * used (see FrechetShortcut).
+     */
+    OnlineFrechetSimplification( double error, bool flagWidthOnly = false );
+
+    /**
+     * Destructor.
+     */
+    ~OnlineFrechetSimplification();
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * Reads the next point of the curve.
+     *
+     * @param p the point, 8-adjacent to the previous one.
+     * @param out the output iterator where the vertices of the
+     * segments closed by @a p are written.
+     * @return the output iterator after the writing.
+     * @tparam OutputIterator a model of output iterator on Point.
+     */
+    template <typename OutputIterator>
+    OutputIterator push( const Point & p, OutputIterator out );
+
+    /**
+     * Ends the curve: the vertex of the current segment is written
+     * and the simplification is ready for a new curve.
+     *
+     * @param out the output iterator where the vertex is written.
+     * @return the output iterator after the writing.
+     * @tparam OutputIterator a model of output iterator on Point.
+     */
+    template <typename OutputIterator>
+    OutputIterator flush( OutputIterator out );
+
+    /**
+     * @return the number of points read since the beginning of the
+     * curve.
+     */
+    std::size_t size() const;
+
+    /**
+     * @return the number of points currently stored, i.e. the
+     * length of the current segment plus one.
+     */
+    std::size_t bufferSize() const;
+
+    /**
+     * @return the maximal number of points stored since the
+     * beginning of the curve.
+     */
+    std::size_t maxBufferSize() const;
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+
+    /// The stored points, from the first point of the current segment.
+    std::deque<Point> myPoints;
+    /// Index in the stream of the first stored point.
+    std::ptrdiff_t myOffset;
+    /// The current segment.
+    SegmentComputer mySegment;
+    /// 'true' if the current segment has been initialized.
+    bool myFlagStarted;
+    /// Number of points of the current curve.
+    std::size_t myNbPoints;
+    /// Maximal number of points stored.
+    std::size_t myMaxBufferSize;
+
+    // ------------------------- Hidden services ------------------------------
+  private:
+
+    /**
+     * @return an iterator on the point after the last one read.
+     */
+    ConstIterator end() const;
+
+    /**
+     * Starts a new segment at @a it and forgets the points before it.
+     * @param it an iterator on a stored point.
+     */
+    void startSegment( const ConstIterator & it );
+
+    /**
+     * Copy constructor.
+     * @param other the object to clone.
+     * Forbidden by default: the iterators refer to their owner.
+     */
+    OnlineFrechetSimplification ( const OnlineFrechetSimplification & other );
+
+    /**
+     * Assignment.
+     * @param other the object to copy.
+     * @return a reference on 'this'.
+     * Forbidden by default.
+     */
+    OnlineFrechetSimplification & operator= ( const OnlineFrechetSimplification & other );
+
+  }; // end of class OnlineFrechetSimplification
+
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'OnlineFrechetSimplification'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'OnlineFrechetSimplification' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename TPoint, typename TInteger>
+  std::ostream&
+  operator<< ( std::ostream & out,
+               const OnlineFrechetSimplification<TPoint, TInteger> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/geometry/curves/OnlineFrechetSimplification.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined OnlineFrechetSimplification_h
+
+#undef OnlineFrechetSimplification_RECURSES
+#endif // else defined(OnlineFrechetSimplification_RECURSES)
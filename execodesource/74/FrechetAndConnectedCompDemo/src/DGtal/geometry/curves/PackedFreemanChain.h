@@ -0,0 +1,340 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file PackedFreemanChain.h
+ *
+ * @brief Freeman chain codes stored on 2 bits, decoded by tables.
+ *
+ * Header file for module PackedFreemanChain.ih
+ *
+ * This file is part of the DGtal library.
+ *
+ * @see testPackedFreemanChain.cpp
+ */
+
+#if defined(PackedFreemanChain_RECURSES)
+#error Recursive header files inclusion detected in PackedFreemanChain.h
+#else // defined(PackedFreemanChain_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define PackedFreemanChain_RECURSES
+
+#if !defined PackedFreemanChain_h
+/** Prevents repeated inclusion of headers. */
+#define PackedFreemanChain_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <string>
+#include <vector>
+#include <iterator>
+#include "DGtal/base/Common.h"
+#include "DGtal/geometry/curves/FreemanChain.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class PackedFreemanChain
+  /**
+   * Description of template class 'PackedFreemanChain' <p>
+   * \brief Aim: Stores a 4-connected Freeman chain with 2 bits per
+   * code, i.e. four codes per byte instead of one char per code in
+   * FreemanChain.
+   *
+   * The codes are decoded with precomputed tables indexed by a whole
+   * byte: one lookup gives the displacements of the four steps of the
+   * byte, or their four characters. The points of the contour and its
+   * text format ("x0 y0 chain") are thus computed without testing the
+   * codes one by one.
+   *
+   * The codes are seen through a random access iterator, whose values
+   * are the characters '0' to '3' as the ones of FreemanChain::code.
+   *
+   *  \code
+   *  PackedFreemanChain<int> pfc( contourPoints );
+   *  std::vector< PackedFreemanChain<int>::Point > points;
+   *  pfc.getContourPoints( points );
+   *  pfc.write( std::cout );  // same line as FreemanChain::write
+   *  FreemanChain<int> fc = pfc.toFreemanChain();
+   *  \endcode
+   *
+   * @tparam TInteger type of the coordinates of the starting point.
+   *
+   * @see FreemanChain testPackedFreemanChain.cpp
+   */
+  template <typename TInteger>
+  class PackedFreemanChain
+  {
+    // ----------------------- Types ------------------------------
+  public:
+
+    typedef TInteger Integer;
+    typedef FreemanChain<Integer> Chain;
+    typedef typename Chain::Point Point;
+    typedef typename Chain::Vector Vector;
+    typedef typename Chain::Size Size;
+    typedef typename Chain::Index Index;
+    typedef unsigned char Byte;
+
+    /**
+     * Random access iterator on the codes of the chain: a position in
+     * the chain, dereferenced as a character '0' to '3'.
+     */
+    class ConstCodeIterator
+      : public std::iterator<std::random_access_iterator_tag, char,
+                             int, const char*, char>
+    {
+    public:
+      ConstCodeIterator(): myChain( 0 ), myPos( 0 ) {}
+      ConstCodeIterator( const PackedFreemanChain & aChain, Index n )
+        : myChain( &aChain ), myPos( n ) {}
+
+      char operator*() const { return myChain->code( myPos ); }
+      char operator[]( int n ) const { return myChain->code( myPos + n ); }
+      Index getPosition() const { return myPos; }
+
+      ConstCodeIterator & operator++() { ++myPos; return *this; }
+      ConstCodeIterator operator++( int )
+      { ConstCodeIterator tmp( *this ); ++myPos; return tmp; }
+      ConstCodeIterator & operator--() { --myPos; return *this; }
+      ConstCodeIterator operator--( int )
+      { ConstCodeIterator tmp( *this ); --myPos; return tmp; }
+      ConstCodeIterator & operator+=( int n ) { myPos += n; return *this; }
+      ConstCodeIterator & operator-=( int n ) { myPos -= n; return *this; }
+      ConstCodeIterator operator+( int n ) const
+      { return ConstCodeIterator( *myChain, myPos + n ); }
+      ConstCodeIterator operator-( int n ) const
+      { return ConstCodeIterator( *myChain, myPos - n ); }
+      int operator-( const ConstCodeIterator & other ) const
+      { return (int) myPos - (int) other.myPos; }
+
+      bool operator==( const ConstCodeIterator & other ) const
+      { return myPos == other.myPos; }
+      bool operator!=( const ConstCodeIterator & other ) const
+      { return myPos != other.myPos; }
+      bool operator<( const ConstCodeIterator & other ) const
+      { return myPos < other.myPos; }
+      bool operator>( const ConstCodeIterator & other ) const
+      { return myPos > other.myPos; }
+      bool operator<=( const ConstCodeIterator & other ) const
+      { return myPos <= other.myPos; }
+      bool operator>=( const ConstCodeIterator & other ) const
+      { return myPos >= other.myPos; }
+
+    private:
+      /// The visited chain.
+      const PackedFreemanChain * myChain;
+      /// The current position.
+      Index myPos;
+    };
+
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+     * Constructor of an empty chain.
+     * @param x the x-coordinate of the first point.
+     * @param y the y-coordinate of the first point.
+     */
+    PackedFreemanChain( Integer x = 0, Integer y = 0 );
+
+    /**
+     * Constructor from a Freeman chain.
+     * @param aChain any Freeman chain.
+     */
+    PackedFreemanChain( const Chain & aChain );
+
+    /**
+     * Constructor from a vector of 4-connected points.
+     * @param vectPoints the points of the contour.
+     */
+    PackedFreemanChain( const std::vector<Point> & vectPoints );
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * @return the number of codes.
+     */
+    Size size() const;
+
+    /**
+     * @return the number of bytes used by the codes.
+     */
+    Size nbBytes() const;
+
+    /**
+     * @param pos a position in the chain.
+     * @return the code at position @a pos, as a character '0' to '3'.
+     */
+    char code( Index pos ) const;
+
+    /**
+     * @return the first point of the chain.
+     */
+    Point firstPoint() const;
+
+    /**
+     * @return the last point of the chain.
+     */
+    Point lastPoint() const;
+
+    /**
+     * @return an iterator on the first code.
+     */
+    ConstCodeIterator codesBegin() const;
+
+    /**
+     * @return an iterator after the last code.
+     */
+    ConstCodeIterator codesEnd() const;
+
+    /**
+     * Removes all the codes and sets the first point.
+     * @param x the x-coordinate of the first point.
+     * @param y the y-coordinate of the first point.
+     */
+    void clear( Integer x = 0, Integer y = 0 );
+
+    /**
+     * Adds a code at the end of the chain.
+     * @param aCode a code, as a character '0' to '3'.
+     */
+    void extend( char aCode );
+
+    /**
+     * Replaces the chain by the codes of the points range [ @a
+     * itBegin , @a itEnd ), whose consecutive points must be
+     * 4-adjacent.
+     *
+     * @tparam TConstIterator an iterator on points.
+     * @param itBegin iterator on the first point.
+     * @param itEnd iterator after the last point.
+     */
+    template <typename TConstIterator>
+    void readFromPointsRange( const TConstIterator & itBegin,
+                              const TConstIterator & itEnd );
+
+    /**
+     * Reads a chain in the text format of FreemanChain (first line
+     * not starting with '#').
+     * @param in any input stream.
+     */
+    void read( std::istream & in );
+
+    /**
+     * Writes the chain in the text format of FreemanChain:
+     * "x0 y0 chain" followed by an end of line.
+     * @param out any output stream.
+     */
+    void write( std::ostream & out ) const;
+
+    /**
+     * @return the chain codes as a string of '0' to '3'.
+     */
+    std::string toString() const;
+
+    /**
+     * @return the equivalent Freeman chain.
+     */
+    Chain toFreemanChain() const;
+
+    /**
+     * Computes the size() + 1 points of the chain, from the first to
+     * the last one (none if the chain is empty, as FreemanChain).
+     * @param aVContour (returns) the points.
+     */
+    void getContourPoints( std::vector<Point> & aVContour ) const;
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+
+    /// The codes, four per byte, the first one in the lowest bits.
+    std::vector<Byte> myCodes;
+    /// The number of codes.
+    Size mySize;
+    /// The first point.
+    Integer myX0, myY0;
+    /// The last point.
+    Integer myXn, myYn;
+
+    // ------------------------- Hidden services ------------------------------
+  private:
+
+    /**
+     * Decoding tables, indexed by a byte of four codes.
+     */
+    struct Tables
+    {
+      /// Displacements from the point before the byte to the point
+      /// after each of its four steps.
+      int dx[ 256 ][ 4 ];
+      int dy[ 256 ][ 4 ];
+      /// The four characters of the codes.
+      char text[ 256 ][ 4 ];
+
+      Tables();
+    };
+
+    /**
+     * @return the decoding tables, built at the first call.
+     */
+    static const Tables & tables();
+
+  }; // end of class PackedFreemanChain
+
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'PackedFreemanChain'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'PackedFreemanChain' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename TInteger>
+  std::ostream&
+  operator<< ( std::ostream & out, const PackedFreemanChain<TInteger> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/geometry/curves/PackedFreemanChain.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined PackedFreemanChain_h
+
+#undef PackedFreemanChain_RECURSES
+#endif // else defined(PackedFreemanChain_RECURSES)
@@ -0,0 +1,244 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file ParallelSaturatedSegmentation.h
+ *
+ * @brief Maximal segments of a range computed by chunks on a pool of
+ * threads.
+ *
+ * This file is part of the DGtal library.
+ *
+ * @see testParallelSaturatedSegmentation.cpp
+ */
+
+#if defined(ParallelSaturatedSegmentation_RECURSES)
+#error Recursive header files inclusion detected in ParallelSaturatedSegmentation.h
+#else // defined(ParallelSaturatedSegmentation_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define ParallelSaturatedSegmentation_RECURSES
+
+#if !defined ParallelSaturatedSegmentation_h
+/** Prevents repeated inclusion of headers. */
+#define ParallelSaturatedSegmentation_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <vector>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/WorkStealingScheduler.h"
+#include "DGtal/geometry/curves/SegmentComputerUtils.h"
+#include "DGtal/geometry/curves/CForwardSegmentComputer.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class ParallelSaturatedSegmentation
+  /**
+   * Description of template class 'ParallelSaturatedSegmentation' <p>
+   * \brief Aim: Computes the whole set of maximal segments of a range,
+   * as SaturatedSegmentation, by splitting the range into chunks
+   * processed on a pool of threads (see WorkStealingScheduler).
+   *
+   * The range is cut at points c_0, ..., c_{k-1}. The chunk i starts
+   * with the first maximal segment passing through c_i and ends
+   * before the first maximal segment passing through c_{i+1}. The
+   * maximal segments are computed with respect to the whole range,
+   * so that a chunk reads the points beyond its cuts as far as its
+   * segments need them: a segment crossing a cut belongs to exactly
+   * one chunk. The concatenation of the chunks is thus exactly the
+   * sequence of SaturatedSegmentation in mode "First":
+   * - for a range given by iterators, it is the same sequence in
+   *   every mode;
+   * - for a whole closed curve, given by two equal circulators, it
+   *   starts with the first maximal segment passing through the
+   *   first point.
+   *
+   * The segments are computed by the constructor and stored; the
+   * flags intersectNext() and intersectPrevious() of
+   * SaturatedSegmentation are not provided.
+   *
+   *  \code
+   *  typedef ArithmeticalDSS<ConstIterator,int,4> DSS;
+   *  ParallelSaturatedSegmentation<DSS> seg( curve.begin(), curve.end(), DSS() );
+   *  for ( ParallelSaturatedSegmentation<DSS>::SegmentComputerIterator
+   *          it = seg.begin(); it != seg.end(); ++it )
+   *    ... // *it is a maximal DSS
+   *  \endcode
+   *
+   * @tparam TSegmentComputer at least a model of CForwardSegmentComputer
+   * whose copies can be used concurrently.
+   *
+   * @see SaturatedSegmentation WorkStealingScheduler
+   */
+  template <typename TSegmentComputer>
+  class ParallelSaturatedSegmentation
+  {
+
+    BOOST_CONCEPT_ASSERT(( CForwardSegmentComputer<TSegmentComputer> ));
+
+    // ----------------------- Types ------------------------------
+  public:
+
+    typedef TSegmentComputer SegmentComputer;
+    typedef typename SegmentComputer::ConstIterator ConstIterator;
+    typedef std::vector<SegmentComputer> Segments;
+    typedef typename Segments::const_iterator SegmentComputerIterator;
+
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+     * Constructor: computes the maximal segments of the range.
+     *
+     * @param itb begin iterator of the range.
+     * @param ite end iterator of the range (equal to @a itb for a
+     * whole closed curve given by circulators).
+     * @param aSegmentComputer a segment computer, copied for each
+     * segment.
+     * @param nbThreads the number of threads, 0 for
+     * WorkStealingScheduler::defaultThreadNumber().
+     * @param nbChunks the number of chunks, 0 for four chunks per
+     * thread (there are never less than 32 points per chunk).
+     */
+    ParallelSaturatedSegmentation( const ConstIterator & itb,
+                                   const ConstIterator & ite,
+                                   const SegmentComputer & aSegmentComputer,
+                                   unsigned int nbThreads = 0,
+                                   unsigned int nbChunks = 0 );
+
+    /**
+     * Destructor.
+     */
+    ~ParallelSaturatedSegmentation();
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * @return an iterator on the first maximal segment.
+     */
+    SegmentComputerIterator begin() const;
+
+    /**
+     * @return an iterator after the last maximal segment.
+     */
+    SegmentComputerIterator end() const;
+
+    /**
+     * @return the number of maximal segments.
+     */
+    typename Segments::size_type size() const;
+
+    /**
+     * @return the number of chunks of the range.
+     */
+    unsigned int chunkNumber() const;
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+
+    /// Begin and end of the range.
+    ConstIterator myBegin, myEnd;
+    /// 'true' for a whole closed curve.
+    bool myIsClosed;
+    /// The segment computer copied for each segment.
+    SegmentComputer mySegmentComputer;
+    /// The first point of each chunk.
+    std::vector<ConstIterator> myCuts;
+    /// The maximal segments of each chunk.
+    std::vector<Segments> myChunkSegments;
+    /// The maximal segments of the range.
+    Segments mySegments;
+
+    // ------------------------- Hidden services ------------------------------
+  private:
+
+    /**
+     * Computes the maximal segments of a chunk.
+     */
+    struct ChunkTask
+    {
+      ParallelSaturatedSegmentation * owner;
+      void operator()( std::size_t task, unsigned int thread );
+    };
+
+    /**
+     * @return 'true' if the range is a whole closed curve.
+     */
+    bool isClosed( IteratorType ) const;
+    bool isClosed( CirculatorType ) const;
+
+    /**
+     * Computes the maximal segments of the chunk @a k in
+     * myChunkSegments[ @a k ].
+     */
+    void computeChunk( std::size_t k );
+
+    /**
+     * @return 'true' if @a s1 and @a s2 are the same segment.
+     */
+    static bool sameSegment( const SegmentComputer & s1,
+                             const SegmentComputer & s2 );
+
+    ParallelSaturatedSegmentation( const ParallelSaturatedSegmentation & other );
+    ParallelSaturatedSegmentation & operator= ( const ParallelSaturatedSegmentation & other );
+
+  }; // end of class ParallelSaturatedSegmentation
+
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'ParallelSaturatedSegmentation'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'ParallelSaturatedSegmentation' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename TSegmentComputer>
+  std::ostream&
+  operator<< ( std::ostream & out,
+               const ParallelSaturatedSegmentation<TSegmentComputer> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/geometry/curves/ParallelSaturatedSegmentation.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined ParallelSaturatedSegmentation_h
+
+#undef ParallelSaturatedSegmentation_RECURSES
+#endif // else defined(ParallelSaturatedSegmentation_RECURSES)
@@ -0,0 +1,259 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file IntegralInvariantMultiRadiiEstimator.h
+ *
+ * @brief Batch evaluation of an integral invariant curvature
+ * estimator for several kernel radii, on several threads.
+ *
+ * Header file for module IntegralInvariantMultiRadiiEstimator.ih
+ *
+ * This file is part of the DGtal library.
+ *
+ * @see testIntegralInvariantMultiRadiiEstimator.cpp
+ */
+
+#if defined(IntegralInvariantMultiRadiiEstimator_RECURSES)
+#error Recursive header files inclusion detected in IntegralInvariantMultiRadiiEstimator.h
+#else // defined(IntegralInvariantMultiRadiiEstimator_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define IntegralInvariantMultiRadiiEstimator_RECURSES
+
+#if !defined IntegralInvariantMultiRadiiEstimator_h
+/** Prevents repeated inclusion of headers. */
+#define IntegralInvariantMultiRadiiEstimator_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <vector>
+#include <cstddef>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/CountedPtr.h"
+#include "DGtal/base/WorkStealingScheduler.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class IntegralInvariantMultiRadiiEstimator
+  /**
+   * Description of template class 'IntegralInvariantMultiRadiiEstimator' <p>
+   * \brief Aim: Evaluates an integral invariant curvature estimator
+   * (IntegralInvariantMeanCurvatureEstimator,
+   * IntegralInvariantGaussianCurvatureEstimator) on a whole range
+   * of surfels for a list of kernel radii, on several threads.
+   *
+   * One estimator is initialized per radius. The range is cut into
+   * chunks of consecutive surfels, which are the tasks given to a
+   * WorkStealingScheduler. A chunk is evaluated for every radius
+   * before the next one, with the incremental evaluation of the
+   * estimators: the kernel is only moved by its shifting masks
+   * between two adjacent surfels, and the shape around the chunk
+   * is read again for each radius while it is in cache. A range
+   * given in the order of a surface traversal (e.g. a
+   * DepthFirstVisitor) thus keeps the chunks spatially coherent: the
+   * full kernel is only computed at the start of each chunk.
+   *
+   * The results are written in a flat array, surfel by surfel: the
+   * estimate of the i-th surfel for the r-th radius is at index
+   * i * nbRadii() + r. They are the ones of the eval( itb, ite,
+   * result ) method of each estimator called chunk by chunk, whatever
+   * the number of threads (the shifting masks are approximate, so
+   * they slightly differ from an evaluation on the whole range). The
+   * shape functor must support concurrent calls.
+   *
+   *  \code
+   *  IntegralInvariantMultiRadiiEstimator< MyIIMeanEstimator > estimator( kSpace, functorShape );
+   *  estimator.init( h, radii );
+   *  std::vector< double > curvatures;
+   *  estimator.eval( surfels.begin(), surfels.end(), curvatures );
+   *  \endcode
+   *
+   * @tparam TEstimator the type of the integral invariant estimator.
+   *
+   * @see IntegralInvariantMeanCurvatureEstimator IntegralInvariantGaussianCurvatureEstimator
+   */
+  template <typename TEstimator>
+  class IntegralInvariantMultiRadiiEstimator
+  {
+    // ----------------------- Types ------------------------------
+  public:
+
+    typedef TEstimator Estimator;
+    typedef typename Estimator::KSpace KSpace;
+    typedef typename Estimator::ShapeCellFunctor ShapeCellFunctor;
+    typedef typename Estimator::Quantity Quantity;
+
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+     * Constructor.
+     *
+     * @param space space in which the shape is defined.
+     * @param f functor on cell of the shape.
+     * @param chunkSize the number of consecutive surfels evaluated
+     * by a task.
+     */
+    IntegralInvariantMultiRadiiEstimator( ConstAlias< KSpace > space,
+                                          ConstAlias< ShapeCellFunctor > f,
+                                          std::size_t chunkSize = 256 );
+
+    /**
+     * Destructor.
+     */
+    ~IntegralInvariantMultiRadiiEstimator();
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * Initializes one estimator per radius.
+     *
+     * @param h precision of the grid.
+     * @param radii the Euclidean radii of the kernel supports.
+     */
+    void init( const double h, const std::vector< double > & radii );
+
+    /**
+     * Evaluates the estimators on the surfels from *itb to *ite
+     * (excluded).
+     *
+     * @tparam ConstIteratorOnCells a random access iterator on
+     * surfels.
+     *
+     * @param itb iterator on the first surfel.
+     * @param ite iterator after the last surfel.
+     * @param results the array where the estimates are written, resized
+     * to (ite - itb) * nbRadii().
+     * @param nbThreads the number of threads (0: default number of
+     * WorkStealingScheduler).
+     */
+    template <typename ConstIteratorOnCells>
+    void eval( const ConstIteratorOnCells & itb,
+               const ConstIteratorOnCells & ite,
+               std::vector< Quantity > & results,
+               unsigned int nbThreads = 0 );
+
+    /**
+     * @return the number of radii.
+     */
+    std::size_t nbRadii() const;
+
+    /**
+     * @param r an index of radius.
+     * @return the r-th radius.
+     */
+    double radius( std::size_t r ) const;
+
+    /**
+     * @param r an index of radius.
+     * @return the estimator for the r-th radius.
+     */
+    Estimator & estimator( std::size_t r );
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+
+    /// Khalimsky space of the shape.
+    const KSpace & mySpace;
+    /// Functor on cell of the shape.
+    const ShapeCellFunctor & myFunctor;
+    /// Number of consecutive surfels evaluated by a task.
+    std::size_t myChunkSize;
+    /// The radii.
+    std::vector< double > myRadii;
+    /// One estimator per radius.
+    std::vector< CountedPtr< Estimator > > myEstimators;
+
+    // ------------------------- Hidden services ------------------------------
+  private:
+
+    /**
+     * Evaluates every estimator on one chunk of surfels: a task of
+     * the scheduler.
+     */
+    template <typename ConstIteratorOnCells>
+    struct ChunkTask
+    {
+      IntegralInvariantMultiRadiiEstimator * owner;
+      ConstIteratorOnCells begin;
+      std::size_t size;
+      std::vector< Quantity > * results;
+
+      void operator()( std::size_t task, unsigned int thread );
+    };
+
+    /**
+     * Copy constructor.
+     * @param other the object to clone.
+     * Forbidden by default.
+     */
+    IntegralInvariantMultiRadiiEstimator ( const IntegralInvariantMultiRadiiEstimator & other );
+
+    /**
+     * Assignment.
+     * @param other the object to copy.
+     * @return a reference on 'this'.
+     * Forbidden by default.
+     */
+    IntegralInvariantMultiRadiiEstimator & operator= ( const IntegralInvariantMultiRadiiEstimator & other );
+
+  }; // end of class IntegralInvariantMultiRadiiEstimator
+
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'IntegralInvariantMultiRadiiEstimator'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'IntegralInvariantMultiRadiiEstimator' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename TEstimator>
+  std::ostream&
+  operator<< ( std::ostream & out,
+               const IntegralInvariantMultiRadiiEstimator<TEstimator> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantMultiRadiiEstimator.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined IntegralInvariantMultiRadiiEstimator_h
+
+#undef IntegralInvariantMultiRadiiEstimator_RECURSES
+#endif // else defined(IntegralInvariantMultiRadiiEstimator_RECURSES)
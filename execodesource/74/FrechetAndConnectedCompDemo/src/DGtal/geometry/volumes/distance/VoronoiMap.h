@@ -53,6 +53,7 @@
 #include "DGtal/geometry/volumes/distance/CSeparableMetric.h"
 #include "DGtal/kernel/domains/HyperRectDomain.h"
 #include "DGtal/base/ConstAlias.h"
+#include "DGtal/base/WorkStealingScheduler.h"
 //////////////////////////////////////////////////////////////////////////////
 
 namespace DGtal
@@ -87,9 +88,16 @@ namespace DGtal
    * which is optimal.
    *
    * If DGtal has been built with OpenMP support (WITH_OPENMP flag set
-   * to "true"), the computation is done in parallel (multithreaded)
-   * in an optimal way: on @a p processors, expected runtime is in
-   * @f$ O(h.d.n^d / p)@f$.
+   * to "true"), or otherwise with POSIX threads support (WITH_PTHREAD
+   * flag, set by default when they are found, see
+   * WorkStealingScheduler), the computation
+   * is done in parallel (multithreaded) in an optimal way: on @a p
+   * processors, expected runtime is in @f$ O(h.d.n^d / p)@f$.
+   *
+   * The 1D problems are processed by tiles of TileSize adjacent
+   * rows, interleaving their memory accesses so that the passes
+   * along the non-contiguous dimensions read whole runs of
+   * consecutive values.
    *
    * This class is a model of CConstImage.
    *
@@ -269,17 +277,68 @@ namespace DGtal
      * @param [in] dim the dimension to process
      */    
     void computeOtherSteps(const Dimension dim) const;
+    /**
+     * Number of adjacent 1D rows processed together by
+     * computeOtherStepTile().
+     */
+    BOOST_STATIC_CONSTANT( Abscissa, TileSize = 16 );
+
+    /**
+     * Reusable buffers of the 1D processes of a tile (one instance
+     * per thread).
+     */
+    struct TileBuffer
+    {
+      ///Stack of candidate sites of each row of the tile
+      std::vector< std::vector<Point> > sites;
+      ///Starting point of each row of the tile
+      std::vector<Point> rowStarts;
+      ///End point of each row of the tile
+      std::vector<Point> rowEnds;
+      ///Current site index of each row while rewriting
+      std::vector<std::size_t> current;
+    };
+
+    /**
+     * Task functor running computeOtherStepTile() on the tiles of a
+     * dimension (see WorkStealingScheduler).
+     */
+    struct TileTask
+    {
+      const Self * map;
+      const std::vector<Point> * tileStarts;
+      Dimension dim;
+      std::vector<TileBuffer> * buffers;
+
+      void operator()( std::size_t task, unsigned int thread ) const
+      {
+        map->computeOtherStepTile( (*tileStarts)[ task ], dim,
+                                   (*buffers)[ thread ] );
+      }
+    };
+    friend struct TileTask;
+
+    /**
+     * @param [in] dim the dimension of the 1D processes.
+     * @return the dimension along which the rows of a tile are
+     * adjacent (0, the contiguous one, unless @a dim is 0).
+     */
+    static Dimension tileDimension( const Dimension dim );
+
     /** 
      * Given  a voronoi map valid at dimension @a dim-1, this method
      * updates the map to make it consistent at dimension @a dim along
-     * the 1D span starting at @a row along the dimension @a
-     * dim.
+     * the 1D spans of a tile: the (at most TileSize) rows starting at
+     * @a startingPoint, @a startingPoint + e_t, ..., where t is
+     * tileDimension( @a dim ).
      * 
-     * @param [in] row starting point of the 1D process.
+     * @param [in] startingPoint starting point of the first row.
      * @param [in] dim dimension of the update.
+     * @param [in,out] buffer the buffers of the calling thread.
      */
-    void computeOtherStep1D (const Point &row, 
-			     const Size dim) const;
+    void computeOtherStepTile (const Point &startingPoint, 
+                               const Size dim,
+                               TileBuffer &buffer) const;
     
     // ------------------- protected methods ------------------------
   protected:
@@ -0,0 +1,466 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file CellCodeSet.h
+ *
+ * Header file for module CellCodeSet.ih
+ *
+ * This file is part of the DGtal library.
+ *
+ * @see testCellCodeSet.cpp
+ */
+
+#if defined(CellCodeSet_RECURSES)
+#error Recursive header files inclusion detected in CellCodeSet.h
+#else // defined(CellCodeSet_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define CellCodeSet_RECURSES
+
+#if !defined CellCodeSet_h
+/** Prevents repeated inclusion of headers. */
+#define CellCodeSet_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <iterator>
+#include <utility>
+#include <vector>
+#include "DGtal/base/Common.h"
+#include "DGtal/topology/KhalimskyCellCoder.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  namespace details
+  {
+    /**
+       Description of template class 'CodeTable' <p> \brief Aim: The
+       open addressing hash table (linear probing, power of two
+       capacity, backward shift deletion) shared by CellCodeSet and
+       CellCodeMap. The code with all bits set marks empty slots.
+
+       @tparam TEntry the type of the slots.
+       @tparam TKeyOf a type providing 'static Code key( const TEntry & )'
+       and 'static TEntry empty()'.
+    */
+    template <typename TEntry, typename TKeyOf>
+    struct CodeTable
+    {
+      typedef TEntry Entry;
+      typedef DGtal::uint64_t Code;
+
+      /// The slots, empty or not.
+      std::vector<Entry> mySlots;
+      /// The number of non empty slots.
+      std::size_t mySize;
+      /// log2 of the number of slots (0 when there are none).
+      unsigned int myBits;
+
+      CodeTable();
+      static Code emptyCode();
+      static bool isEmpty( const Entry & e );
+      void clear();
+      std::size_t home( Code aCode ) const;
+      /// @return the slot of [aCode] or, if absent, the empty slot where it would go.
+      std::size_t locate( Code aCode ) const;
+      /// @return the slot of [aCode], or mySlots.size() if absent.
+      std::size_t find( Code aCode ) const;
+      /// @return the slot of the entry and 'true' if it has been inserted.
+      std::pair<std::size_t, bool> insert( const Entry & e );
+      /// @return 'true' if [aCode] was in the table.
+      bool erase( Code aCode );
+      /// @return the first non empty slot from [slot], or mySlots.size().
+      std::size_t next( std::size_t slot ) const;
+      /// Doubles the number of slots (at least 16) and reinserts the entries.
+      void grow();
+      /// Halves the number of slots and reinserts the entries.
+      void shrink();
+      /// Sets the number of slots (a power of two) and reinserts the entries.
+      void rehash( std::size_t nbSlots );
+    };
+
+    /// Keys of the entries of a CellCodeSet.
+    struct CodeKeyOf
+    {
+      static DGtal::uint64_t key( const DGtal::uint64_t & e ) { return e; }
+      static DGtal::uint64_t empty() { return ~( (DGtal::uint64_t) 0 ); }
+    };
+
+    /// Keys of the entries of a CellCodeMap.
+    template <typename TValue>
+    struct CodeValueKeyOf
+    {
+      typedef std::pair<DGtal::uint64_t, TValue> Entry;
+      static DGtal::uint64_t key( const Entry & e ) { return e.first; }
+      static Entry empty() 
+      { return Entry( ~( (DGtal::uint64_t) 0 ), TValue() ); }
+    };
+  } // namespace details
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class CellCodeSet
+  /**
+     Description of template class 'CellCodeSet' <p> \brief Aim: A
+     set of cells of a bounded cellular grid space, stored as a flat
+     open addressing hash table of 64 bits cell codes (see
+     KhalimskyCellCoder).
+
+     Each slot holds an 8 bytes code. The table doubles when its load
+     factor would exceed 1/2 and halves when erasures bring it below
+     1/8, so it takes 16 to 32 bytes per cell while it is filled and at
+     most 64 bytes per cell after erasures (tables of more than 16
+     slots), against 48 bytes or more for the nodes of a
+     std::set<SCell>, and its lookups do not follow pointers. It provides the subset of the
+     std::set interface used by the tracking algorithms of Surfaces,
+     so it may be given as their SCellSet parameter:
+
+     @code
+     CellCodeSet<KSpace> boundary( K );
+     Surfaces<KSpace>::trackBoundary( boundary, K, surfAdj, predicate, bel );
+     @endcode
+
+     Iterators are invalidated by insertions and erasures, and the
+     cells are visited in no particular order. Dereferencing an
+     iterator gives a decoded copy of the cell.
+
+     @tparam TKSpace a model of CCellularGridSpaceND, whose cells
+     codes fit in 63 bits.
+     @tparam TCell either TKSpace::SCell (default) or TKSpace::Cell.
+
+     @see CellCodeMap, KhalimskyCellCoder
+   */
+  template <typename TKSpace, typename TCell = typename TKSpace::SCell>
+  class CellCodeSet
+  {
+    // ----------------------- public types ------------------------------
+  public:
+    typedef TKSpace KSpace;
+    typedef TCell Cell;
+    typedef KhalimskyCellCoder<KSpace> Coder;
+    typedef typename Coder::Code Code;
+    typedef std::size_t Size;
+
+    typedef Cell value_type;
+    typedef Cell key_type;
+    typedef Size size_type;
+
+  private:
+    typedef details::CodeTable<Code, details::CodeKeyOf> Table;
+
+  public:
+    /// Constant forward iterator on the cells of the set.
+    class ConstIterator
+    {
+    public:
+      typedef std::forward_iterator_tag iterator_category;
+      typedef Cell value_type;
+      typedef std::ptrdiff_t difference_type;
+      typedef const Cell * pointer;
+      typedef Cell reference;
+
+      ConstIterator() : mySet( 0 ), mySlot( 0 ) {}
+      ConstIterator( const CellCodeSet * aSet, std::size_t aSlot )
+        : mySet( aSet ), mySlot( aSlot ) {}
+      Cell operator*() const;
+      ConstIterator & operator++();
+      ConstIterator operator++( int );
+      bool operator==( const ConstIterator & other ) const
+      { return mySlot == other.mySlot; }
+      bool operator!=( const ConstIterator & other ) const
+      { return mySlot != other.mySlot; }
+      /// @return the code of the cell.
+      Code code() const;
+
+    private:
+      const CellCodeSet * mySet;
+      std::size_t mySlot;
+    };
+    typedef ConstIterator Iterator;
+    typedef ConstIterator const_iterator;
+    typedef ConstIterator iterator;
+    friend class ConstIterator;
+
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+     * Destructor.
+     */
+    ~CellCodeSet();
+
+    /**
+     * Constructor. The set is empty.
+     * @param K the space of the cells, whose codes must fit in 63 bits.
+     */
+    CellCodeSet( const KSpace & K );
+
+    /**
+     * Constructor. The set is empty.
+     * @param aCoder the coder of the cells of the space.
+     */
+    CellCodeSet( const Coder & aCoder );
+
+    // ----------------------- Set services --------------------------------
+  public:
+
+    /// @return the number of cells.
+    Size size() const;
+    /// @return 'true' if the set is empty.
+    bool empty() const;
+    /// Removes all the cells (the memory is kept).
+    void clear();
+    /// @param n the number of cells to store without rehashing.
+    void reserve( Size n );
+    /// @return the number of slots of the table.
+    Size capacity() const;
+
+    /**
+     * @param c any cell of the space.
+     * @return an iterator on [c] and 'true' if it was not already in
+     * the set.
+     */
+    std::pair<ConstIterator, bool> insert( const Cell & c );
+
+    /**
+     * Inserts a range of cells.
+     * @tparam TInputIterator a model of input iterator on cells.
+     * @param it the beginning of the range.
+     * @param itE the end of the range.
+     */
+    template <typename TInputIterator>
+    void insert( TInputIterator it, TInputIterator itE );
+
+    /// @return the number of erased cells (0 or 1).
+    Size erase( const Cell & c );
+    /// @return an iterator on [c], or end() if [c] is not in the set.
+    ConstIterator find( const Cell & c ) const;
+    /// @return 1 if [c] is in the set, 0 otherwise.
+    Size count( const Cell & c ) const;
+
+    ConstIterator begin() const;
+    ConstIterator end() const;
+
+    /// @return the coder of the cells.
+    const Coder & coder() const;
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+    Coder myCoder;
+    Table myTable;
+
+    // ------------------------- Hidden services ------------------------------
+  protected:
+
+    /**
+     * Constructor.
+     * Forbidden by default (protected to avoid g++ warnings).
+     */
+    CellCodeSet();
+
+  }; // end of class CellCodeSet
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class CellCodeMap
+  /**
+     Description of template class 'CellCodeMap' <p> \brief Aim: A
+     map from the cells of a bounded cellular grid space to values,
+     stored as a flat open addressing hash table keyed by the 64 bits
+     cell codes (see CellCodeSet).
+
+     Iterators give the cell (decoded) with cell() and the associated
+     value with value(). They are invalidated by insertions and
+     erasures.
+
+     @tparam TKSpace a model of CCellularGridSpaceND, whose cells
+     codes fit in 63 bits.
+     @tparam TValue the type of the values (default constructible and
+     assignable).
+     @tparam TCell either TKSpace::SCell (default) or TKSpace::Cell.
+   */
+  template <typename TKSpace, typename TValue,
+            typename TCell = typename TKSpace::SCell>
+  class CellCodeMap
+  {
+    // ----------------------- public types ------------------------------
+  public:
+    typedef TKSpace KSpace;
+    typedef TCell Cell;
+    typedef TValue Value;
+    typedef KhalimskyCellCoder<KSpace> Coder;
+    typedef typename Coder::Code Code;
+    typedef std::size_t Size;
+
+  private:
+    typedef details::CodeValueKeyOf<Value> KeyOf;
+    typedef details::CodeTable<typename KeyOf::Entry, KeyOf> Table;
+
+  public:
+    /// Forward iterator on the (cell,value) pairs of the map.
+    class Iterator
+    {
+    public:
+      Iterator() : myMap( 0 ), mySlot( 0 ) {}
+      Iterator( CellCodeMap * aMap, std::size_t aSlot )
+        : myMap( aMap ), mySlot( aSlot ) {}
+      /// @return the cell.
+      Cell cell() const;
+      /// @return the value associated with the cell.
+      Value & value() const;
+      Iterator & operator++();
+      bool operator==( const Iterator & other ) const
+      { return mySlot == other.mySlot; }
+      bool operator!=( const Iterator & other ) const
+      { return mySlot != other.mySlot; }
+
+    private:
+      CellCodeMap * myMap;
+      std::size_t mySlot;
+    };
+    friend class Iterator;
+
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+     * Destructor.
+     */
+    ~CellCodeMap();
+
+    /**
+     * Constructor. The map is empty.
+     * @param K the space of the cells, whose codes must fit in 63 bits.
+     */
+    CellCodeMap( const KSpace & K );
+
+    // ----------------------- Map services --------------------------------
+  public:
+
+    /// @return the number of cells.
+    Size size() const;
+    /// @return 'true' if the map is empty.
+    bool empty() const;
+    /// Removes all the cells (the memory is kept).
+    void clear();
+    /// @param n the number of cells to store without rehashing.
+    void reserve( Size n );
+
+    /**
+     * @param c any cell of the space.
+     * @return a reference on the value of [c], default constructed
+     * if [c] was not in the map.
+     */
+    Value & operator[]( const Cell & c );
+
+    /// @return the number of erased cells (0 or 1).
+    Size erase( const Cell & c );
+    /// @return an iterator on [c], or end() if [c] is not in the map.
+    Iterator find( const Cell & c );
+    /// @return 1 if [c] is in the map, 0 otherwise.
+    Size count( const Cell & c ) const;
+
+    Iterator begin();
+    Iterator end();
+
+    /// @return the coder of the cells.
+    const Coder & coder() const;
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the object is valid, 'false' otherwise.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+    Coder myCoder;
+    Table myTable;
+
+    // ------------------------- Hidden services ------------------------------
+  protected:
+
+    /**
+     * Constructor.
+     * Forbidden by default (protected to avoid g++ warnings).
+     */
+    CellCodeMap();
+
+  }; // end of class CellCodeMap
+
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'CellCodeSet'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'CellCodeSet' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename TKSpace, typename TCell>
+  std::ostream&
+  operator<< ( std::ostream & out, const CellCodeSet<TKSpace, TCell> & object );
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'CellCodeMap'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'CellCodeMap' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename TKSpace, typename TValue, typename TCell>
+  std::ostream&
+  operator<< ( std::ostream & out, 
+               const CellCodeMap<TKSpace, TValue, TCell> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/topology/CellCodeSet.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined CellCodeSet_h
+
+#undef CellCodeSet_RECURSES
+#endif // else defined(CellCodeSet_RECURSES)
@@ -0,0 +1,255 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+#pragma once
+
+/**
+ * @file KhalimskyCellCoder.h
+ *
+ * Header file for module KhalimskyCellCoder.ih
+ *
+ * This file is part of the DGtal library.
+ *
+ * @see testCellCodeSet.cpp
+ */
+
+#if defined(KhalimskyCellCoder_RECURSES)
+#error Recursive header files inclusion detected in KhalimskyCellCoder.h
+#else // defined(KhalimskyCellCoder_RECURSES)
+/** Prevents recursive inclusion of headers. */
+#define KhalimskyCellCoder_RECURSES
+
+#if !defined KhalimskyCellCoder_h
+/** Prevents repeated inclusion of headers. */
+#define KhalimskyCellCoder_h
+
+//////////////////////////////////////////////////////////////////////////////
+// Inclusions
+#include <iostream>
+#include <cstddef>
+#include "DGtal/base/Common.h"
+//////////////////////////////////////////////////////////////////////////////
+
+namespace DGtal
+{
+
+  /**
+     \brief Aim: Hash functor for the 64 bits codes of cells (see
+     KhalimskyCellCoder). It is a Fibonacci hashing: the high bits of
+     the code times 2^64 divided by the golden ratio.
+  */
+  struct CellCodeHash
+  {
+    /**
+     * @param aCode any code.
+     * @param nbBits the number of bits of the hash value, between 1 and 63.
+     * @return the hash value, in [0, 2^nbBits).
+     */
+    static std::size_t hash( DGtal::uint64_t aCode, unsigned int nbBits );
+
+    /**
+     * @param aCode any code.
+     * @return the hash value, on as many bits as a std::size_t (at most 63).
+     */
+    std::size_t operator()( DGtal::uint64_t aCode ) const;
+  };
+
+  /////////////////////////////////////////////////////////////////////////////
+  // template class KhalimskyCellCoder
+  /**
+     Description of template class 'KhalimskyCellCoder' <p> \brief
+     Aim: Packs the cells of a bounded cellular grid space into 64
+     bits codes, and unpacks them.
+
+     A cell is represented by its Khalimsky coordinates, relative to
+     the lower cell of the space, and by its sign for signed cells.
+     Bit 0 holds the sign (always 0 for unsigned cells), then each
+     coordinate uses the number of bits needed by the Khalimsky
+     extent of the space along its axis, axis 0 first. The code of a
+     cell is thus unique among the cells of the space, and two
+     signed cells with opposite signs only differ by their lowest
+     bit.
+
+     At most 63 bits are used, so that the code with all bits set
+     never represents a cell (see CellCodeSet). This covers, for
+     instance, 3D spaces up to 2^20 - 1 voxels wide along each axis.
+     isValid() tells whether the space is small enough.
+
+     @code
+     typedef KhalimskySpaceND<3, int> KSpace;
+     KSpace K;
+     K.init( Point( 0, 0, 0 ), Point( 511, 511, 511 ), true );
+     KhalimskyCellCoder<KSpace> coder( K );
+     KSpace::SCell c = K.sSpel( Point( 3, 4, 5 ) );
+     KhalimskyCellCoder<KSpace>::Code code = coder.code( c );
+     KSpace::SCell d;
+     coder.decode( code, d ); // d == c
+     @endcode
+
+     @tparam TKSpace a model of CCellularGridSpaceND (typically a
+     KhalimskySpaceND).
+
+     @see CellCodeSet
+   */
+  template <typename TKSpace>
+  class KhalimskyCellCoder
+  {
+    // ----------------------- public types ------------------------------
+  public:
+    typedef TKSpace KSpace;
+    typedef typename KSpace::Integer Integer;
+    typedef typename KSpace::Point Point;
+    typedef typename KSpace::Cell Cell;
+    typedef typename KSpace::SCell SCell;
+    typedef DGtal::uint64_t Code;
+
+    // ----------------------- Standard services ------------------------------
+  public:
+
+    /**
+     * Destructor.
+     */
+    ~KhalimskyCellCoder();
+
+    /**
+     * Constructor.
+     * @param K the space of the cells (only its bounds are used).
+     */
+    KhalimskyCellCoder( const KSpace & K );
+
+    /**
+     * Copy constructor.
+     * @param other the object to clone.
+     */
+    KhalimskyCellCoder( const KhalimskyCellCoder & other );
+
+    /**
+     * Assignment.
+     * @param other the object to copy.
+     * @return a reference on 'this'.
+     */
+    KhalimskyCellCoder & operator= ( const KhalimskyCellCoder & other );
+
+    // ----------------------- Coding services --------------------------------
+  public:
+
+    /**
+     * @param c any unsigned cell of the space.
+     * @return its code.
+     */
+    Code code( const Cell & c ) const;
+
+    /**
+     * @param c any signed cell of the space.
+     * @return its code.
+     */
+    Code code( const SCell & c ) const;
+
+    /**
+     * @param aCode the code of an unsigned cell.
+     * @param c (returns) the cell.
+     */
+    void decode( Code aCode, Cell & c ) const;
+
+    /**
+     * @param aCode the code of a signed cell.
+     * @param c (returns) the cell.
+     */
+    void decode( Code aCode, SCell & c ) const;
+
+    /**
+     * @return the number of bits used by the codes.
+     */
+    unsigned int codeBits() const;
+
+    // ----------------------- Interface --------------------------------------
+  public:
+
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param out the output stream where the object is written.
+     */
+    void selfDisplay ( std::ostream & out ) const;
+
+    /**
+     * Checks the validity/consistency of the object.
+     * @return 'true' if the codes of the space fit in 63 bits.
+     */
+    bool isValid() const;
+
+    // ------------------------- Private Datas --------------------------------
+  private:
+
+    /// The lower Khalimsky coordinates of the space.
+    Point myLower;
+    /// The position of the lowest bit of each coordinate.
+    unsigned int myShifts[ KSpace::dimension ];
+    /// The mask of each coordinate (once shifted).
+    Code myMasks[ KSpace::dimension ];
+    /// The total number of bits (sign included).
+    unsigned int myBits;
+
+    // ------------------------- Hidden services ------------------------------
+  protected:
+
+    /**
+     * Constructor.
+     * Forbidden by default (protected to avoid g++ warnings).
+     */
+    KhalimskyCellCoder();
+
+    // ------------------------- Internals ------------------------------------
+  private:
+
+    /**
+     * @param kp any Khalimsky coordinates in the space.
+     * @return the code of the coordinates (without sign).
+     */
+    Code codeCoordinates( const Point & kp ) const;
+
+    /**
+     * @param aCode any code.
+     * @param kp (returns) the Khalimsky coordinates.
+     */
+    void decodeCoordinates( Code aCode, Point & kp ) const;
+
+  }; // end of class KhalimskyCellCoder
+
+
+  /**
+   * Overloads 'operator<<' for displaying objects of class 'KhalimskyCellCoder'.
+   * @param out the output stream where the object is written.
+   * @param object the object of class 'KhalimskyCellCoder' to write.
+   * @return the output stream after the writing.
+   */
+  template <typename TKSpace>
+  std::ostream&
+  operator<< ( std::ostream & out, const KhalimskyCellCoder<TKSpace> & object );
+
+} // namespace DGtal
+
+
+///////////////////////////////////////////////////////////////////////////////
+// Includes inline functions.
+#include "DGtal/topology/KhalimskyCellCoder.ih"
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#endif // !defined KhalimskyCellCoder_h
+
+#undef KhalimskyCellCoder_RECURSES
+#endif // else defined(KhalimskyCellCoder_RECURSES)
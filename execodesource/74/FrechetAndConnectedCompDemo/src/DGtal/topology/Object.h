@@ -43,6 +43,7 @@
 #include <iostream>
 #include <string>
 #include <map>
+#include <vector>
 #include "DGtal/base/Common.h"
 #include "DGtal/base/CowPtr.h"
 #include "DGtal/kernel/sets/CDigitalSet.h"
@@ -433,6 +434,38 @@ namespace DGtal
        */
       Connectedness computeConnectedness() const;
 
+      /**
+         Computes the connected components of the object and writes
+         them on the output iterator [it], like writeComponents. The
+         components and their order are the same, but the visited
+         points are marked in a dense bitmap of the domain of the
+         point set (one bit per point of the domain) instead of a
+         std::set. It is much faster and lighter as long as the object
+         fills a significant part of its domain (e.g. thresholded
+         images), but should not be used when the domain is huge
+         compared to the object.
+        
+         @tparam OutputObjectIterator the type of an output iterator in
+         a container of Object s.
+        
+         @param it the output iterator. *it is an Object.
+         @return the number of components.
+
+         @see writeComponents
+       */
+      template <typename OutputObjectIterator>
+      Size writeComponentsInDomain( OutputObjectIterator & it ) const;
+
+      /**
+       * Same as computeConnectedness, but the visited points are
+       * marked in a dense bitmap of the domain (@see
+       * writeComponentsInDomain).
+       *
+       * @return the connectedness of this object. Either CONNECTED or
+       * DISCONNECTED.
+       */
+      Connectedness computeConnectednessInDomain() const;
+
       // ----------------------- Graph services ------------------------------
     public:
       
@@ -565,6 +598,39 @@ namespace DGtal
     protected:
 
     private:
+
+      /**
+       * Initializes the bitmap used by writeComponentsInDomain: one
+       * bit per point of the domain, set for the points of the
+       * object.
+       *
+       * @param bitmap (returns) the bitmap, in the order of the domain.
+       * @param extent (returns) the size of the domain along each axis.
+       */
+      void initComponentBitmap( std::vector<bool> & bitmap,
+                                Point & extent ) const;
+
+      /**
+       * Visits the component of [seed] breadth-first, through the
+       * points whose bit is set in [bitmap], and clears their bits.
+       *
+       * @param bitmap the bitmap of the points not visited yet.
+       * @param extent the size of the domain along each axis.
+       * @param seed a point of the object whose bit is set.
+       * @param component (returns) the points of the component, in
+       * the order of the visit.
+       */
+      void visitComponentBitmap( std::vector<bool> & bitmap,
+                                 const Point & extent,
+                                 const Point & seed,
+                                 std::vector<Point> & component ) const;
+
+      /**
+       * @param p any point of the domain.
+       * @param extent the size of the domain along each axis.
+       * @return the index of [p] in the component bitmap.
+       */
+      std::size_t bitmapIndex( const Point & p, const Point & extent ) const;
     
 
     
@@ -155,7 +155,8 @@ namespace DGtal
        PointPredicate. The algorithms tracks surfels along the
        boundary of the shape.
        
-       @tparam SCellSet a model of a set of SCell (e.g., std::set<SCell>).
+       @tparam SCellSet a model of a set of SCell (e.g., std::set<SCell>,
+       or CellCodeSet<KSpace> for a bounded space).
 
        @tparam PointPredicate a model of CPointPredicate describing
        the inside of a digital shape, meaning a functor taking a Point
@@ -196,7 +197,8 @@ namespace DGtal
        be fully inside the space. Follows the idea of Artzy, Frieder
        and Herman algorithm [Artzy:1981-cgip], but in nD.
        
-       @tparam SCellSet a model of a set of SCell (e.g., std::set<SCell>).
+       @tparam SCellSet a model of a set of SCell (e.g., std::set<SCell>,
+       or CellCodeSet<KSpace> for a bounded space).
 
        @tparam PointPredicate a model of CPointPredicate describing
        the inside of a digital shape, meaning a functor taking a Point
@@ -234,7 +236,8 @@ namespace DGtal
        boundary component of a digital surface described by a
        SurfelPredicate. The algorithms tracks surfels along the surface.
        
-       @tparam SCellSet a model of a set of SCell (e.g., std::set<SCell>).
+       @tparam SCellSet a model of a set of SCell (e.g., std::set<SCell>,
+       or CellCodeSet<KSpace> for a bounded space).
 
        @tparam SurfelPredicate a model of CSurfelPredicate describing
        whether a surfel belongs or not to the surface.
@@ -269,7 +272,8 @@ namespace DGtal
        surface. This is an optimized version of trackSurface, which is
        valid only when the tracked surface is closed.
        
-       @tparam SCellSet a model of a set of SCell (e.g., std::set<SCell>).
+       @tparam SCellSet a model of a set of SCell (e.g., std::set<SCell>,
+       or CellCodeSet<KSpace> for a bounded space).
 
        @tparam SurfelPredicate a model of CSurfelPredicate describing
        whether a surfel belongs or not to the surface.
@@ -579,6 +583,41 @@ namespace DGtal
       const KSpace & aKSpace,
       const SurfelAdjacency<KSpace::dimension> & aSurfelAdj,
       const PointPredicate & pp );
+
+    /**
+       Same as extractAll2DSCellContours above, but the boundary
+       surfels not yet visited are kept in the given set instead of a
+       std::set<SCell>. The contours are found in the order in which
+       the set iterates its surfels.
+       
+       @tparam SCellSet a model of a set of SCell (e.g., std::set<SCell>,
+       or CellCodeSet<KSpace> for a bounded space).
+       @tparam PointPredicate a model of CPointPredicate describing
+       the inside of a digital shape, meaning a functor taking a Point
+       and returning 'true' whenever the point belongs to the shape.
+       
+       @param aBoundary (modified) the set used to store the boundary
+       surfels during the extraction, empty afterwards.
+       
+       @param aVectSCellContour2D (modified) a vector of contour represented
+       by a vector of cells (which are all surfels), containing the
+       ordered list of the boundary component of [spelset].
+       
+       @param aKSpace any space.
+       
+       @param aSurfelAdj the surfel adjacency chosen for the tracking.
+       
+       @param pp an instance of a model of CPointPredicate, for
+       instance a SetPredicate for a digital set representing a shape.
+    */
+    template <typename SCellSet, typename PointPredicate>
+    static 
+    void extractAll2DSCellContours
+    ( SCellSet & aBoundary,
+      std::vector< std::vector<SCell> > & aVectSCellContour2D,
+      const KSpace & aKSpace,
+      const SurfelAdjacency<KSpace::dimension> & aSurfelAdj,
+      const PointPredicate & pp );
     
 
     /**
@@ -688,7 +727,8 @@ namespace DGtal
        boundary components of a digital shape described by the predicate
        [pp].
        
-       @tparam SCellSet a model of a set of SCell (e.g., std::set<SCell>).
+       @tparam SCellSet a model of a set of SCell (e.g., std::set<SCell>,
+       or CellCodeSet<KSpace> for a bounded space).
        @tparam PointPredicate a model of CPointPredicate describing
        the inside of a digital shape, meaning a functor taking a Point
        and returning 'true' whenever the point belongs to the shape.
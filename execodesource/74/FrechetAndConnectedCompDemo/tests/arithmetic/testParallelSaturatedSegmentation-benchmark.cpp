@@ -0,0 +1,120 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testParallelSaturatedSegmentation-benchmark.cpp
+ * @ingroup Tests
+ *
+ * Scaling of the computation of the maximal DSSs of a long closed
+ * curve with the number of threads.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <cstdlib>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/Clock.h"
+#include "DGtal/base/Circulator.h"
+#include "DGtal/kernel/PointVector.h"
+#include "DGtal/geometry/curves/ArithmeticalDSS.h"
+#include "DGtal/geometry/curves/SaturatedSegmentation.h"
+#include "DGtal/geometry/curves/ParallelSaturatedSegmentation.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+
+typedef PointVector<2,int> Point;
+typedef std::vector<Point> Curve;
+typedef Curve::const_iterator ConstIterator;
+typedef Circulator<ConstIterator> ConstCirculator;
+typedef ArithmeticalDSS<ConstCirculator,int,4> DSS;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for benchmarking class ParallelSaturatedSegmentation.
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * @return the 4-connected digitization of a flower of radius @a r.
+ */
+Curve digitalFlower( double r )
+{
+  Curve curve;
+  Point p( (int) std::floor( 1.2 * r + 0.5 ), 0 );
+  const unsigned int n = (unsigned int) ( 32 * r ) + 16;
+  for ( unsigned int i = 1; i <= n; ++i )
+    {
+      const double t = 2.0 * M_PI * i / n;
+      const double rt = r * ( 1.0 + 0.2 * std::cos( 5.0 * t ) );
+      const Point q( (int) std::floor( rt * std::cos( t ) + 0.5 ),
+                     (int) std::floor( rt * std::sin( t ) + 0.5 ) );
+      while ( p[ 0 ] != q[ 0 ] )
+        {
+          curve.push_back( p );
+          p[ 0 ] += ( q[ 0 ] > p[ 0 ] ) ? 1 : -1;
+        }
+      while ( p[ 1 ] != q[ 1 ] )
+        {
+          curve.push_back( p );
+          p[ 1 ] += ( q[ 1 ] > p[ 1 ] ) ? 1 : -1;
+        }
+    }
+  return curve;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  const double r = ( argc > 1 ) ? atof( argv[ 1 ] ) : 100000.0;
+  const unsigned int maxThreads = ( argc > 2 ) ? atoi( argv[ 2 ] ) : 8;
+  Curve curve = digitalFlower( r );
+  ConstCirculator c( curve.begin(), curve.begin(), curve.end() );
+
+  Clock clock;
+  clock.startClock();
+  SaturatedSegmentation<DSS> seq( c, c, DSS() );
+  seq.setMode( "First" );
+  unsigned int nbSegments = 0;
+  for ( SaturatedSegmentation<DSS>::SegmentComputerIterator it = seq.begin();
+        it != seq.end(); ++it )
+    ++nbSegments;
+  const double seqTime = clock.stopClock();
+
+  std::cout << "# " << curve.size() << " points, " << nbSegments
+            << " maximal segments" << std::endl
+            << "# threads time(ms) speedup" << std::endl
+            << "0 " << seqTime << " 1" << std::endl;
+  for ( unsigned int threads = 1; threads <= maxThreads; threads *= 2 )
+    {
+      clock.startClock();
+      ParallelSaturatedSegmentation<DSS> par( c, c, DSS(), threads );
+      const double time = clock.stopClock();
+      std::cout << threads << " " << time << " " << seqTime / time;
+      if ( par.size() != nbSegments )
+        std::cout << " # error: " << par.size() << " segments";
+      std::cout << std::endl;
+    }
+  return 0;
+}
+
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,199 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testProfiler.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class Profiler.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cmath>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/Clock.h"
+#include "DGtal/base/Profiler.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class Profiler.
+///////////////////////////////////////////////////////////////////////////////
+
+/// @return the number of occurrences of @a word in @a s.
+unsigned int occurrences( const std::string & s, const std::string & word )
+{
+  unsigned int n = 0;
+  for ( std::string::size_type pos = s.find( word );
+        pos != std::string::npos; pos = s.find( word, pos + 1 ) )
+    ++n;
+  return n;
+}
+
+/**
+ * Nested phases, merged phases and counters.
+ */
+bool testProfiler()
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  trace.beginBlock ( "Phases and counters" );
+  Profiler p;
+  nbok += ( ! p.isEnabled() && p.isValid() ) ? 1 : 0;
+  nb++;
+
+  p.enable( "testProfiler.json", "testProfiler" );
+  double tmp = 0;
+  {
+    Profiler::Phase phase( p, "load" );
+    for ( unsigned int i = 0; i < 1000000; ++i )
+      tmp = cos( tmp + i );
+    p.count( "pixels", 1000 );
+  }
+  for ( unsigned int k = 0; k < 3; ++k )
+    {
+      Profiler::Phase phase( p, "contour" );
+      {
+        Profiler::Phase inner( p, "segmentation" );
+        p.count( "segments", 2 );
+      }
+      p.count( "points", 10 );
+    }
+  p.count( "contours", 3 );
+
+  nbok += p.writeReport() ? 1 : 0;
+  nb++;
+  std::ifstream in( "testProfiler.json" );
+  std::ostringstream out;
+  out << in.rdbuf();
+  const std::string report = out.str();
+  trace.info() << p << std::endl << report;
+
+  nbok += ( occurrences( report, "\"program\": \"testProfiler\"" ) == 1 ) ? 1 : 0;
+  nb++;
+  // whole program, load, contour, segmentation: merged calls
+  nbok += ( occurrences( report, "\"name\": " ) == 3
+            && occurrences( report, "\"calls\": 3" ) == 2
+            && occurrences( report, "\"wallTimeMs\"" ) == 4
+            && occurrences( report, "\"peakRSSKB\"" ) == 4 ) ? 1 : 0;
+  nb++;
+  nbok += ( occurrences( report, "\"segments\": 6" ) == 1
+            && occurrences( report, "\"points\": 30" ) == 1
+            && occurrences( report, "\"pixels\": 1000" ) == 1
+            && occurrences( report, "\"contours\": 3" ) == 1 ) ? 1 : 0;
+  nb++;
+  // balanced braces and brackets
+  nbok += ( occurrences( report, "{" ) == occurrences( report, "}" )
+            && occurrences( report, "[" ) == occurrences( report, "]" ) ) ? 1 : 0;
+  nb++;
+  nbok += p.isValid() ? 1 : 0;
+  nb++;
+
+  trace.info() << "(" << nbok << "/" << nb << ") "
+               << "phases and counters reported" << std::endl;
+  trace.endBlock();
+  return nbok == nb;
+}
+
+/**
+ * Names are written as valid JSON strings.
+ */
+bool testEscaping()
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  trace.beginBlock ( "Escaped names" );
+  Profiler p;
+  p.enable( "testProfiler-escaping.json", "quote\" backslash\\ tab\t newline\n" );
+  {
+    Profiler::Phase phase( p, "\x01" );
+  }
+  std::ostringstream out;
+  p.writeReport( out );
+  const std::string report = out.str();
+  trace.info() << report;
+  nbok += ( occurrences( report,
+                         "\"quote\\\" backslash\\\\ tab\\u0009 newline\\u000a\"" ) == 1 )
+    ? 1 : 0;
+  nb++;
+  nbok += ( occurrences( report, "\"name\": \"\\u0001\"" ) == 1 ) ? 1 : 0;
+  nb++;
+  nbok += ( occurrences( report, "\t" ) == 0 ) ? 1 : 0;
+  nb++;
+
+  trace.info() << "(" << nbok << "/" << nb << ") "
+               << "quotes, backslashes and control characters escaped" << std::endl;
+  trace.endBlock();
+  return nbok == nb;
+}
+
+/**
+ * A disabled profiler measures nothing.
+ */
+bool testDisabled()
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  trace.beginBlock ( "Disabled profiler" );
+  Profiler p;
+  Clock c;
+  c.startClock();
+  for ( unsigned int i = 0; i < 10000000; ++i )
+    {
+      Profiler::Phase phase( p, "loop" );
+      p.count( "iterations" );
+    }
+  trace.info() << "10000000 phases: " << c.stopClock() << " ms" << std::endl;
+  std::ostringstream out;
+  p.writeReport( out );
+  nbok += out.str().empty() ? 1 : 0;
+  nb++;
+
+  trace.info() << "(" << nbok << "/" << nb << ") "
+               << "nothing reported" << std::endl;
+  trace.endBlock();
+  return nbok == nb;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  trace.beginBlock ( "Testing class Profiler" );
+  trace.info() << "Args:";
+  for ( int i = 0; i < argc; ++i )
+    trace.info() << " " << argv[ i ];
+  trace.info() << endl;
+
+  bool res = testProfiler() && testEscaping() && testDisabled();
+  trace.emphase() << ( res ? "Passed." : "Error." ) << endl;
+  trace.endBlock();
+  return res ? 0 : 1;
+}
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
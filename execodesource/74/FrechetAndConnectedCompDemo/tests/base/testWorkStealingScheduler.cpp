@@ -0,0 +1,138 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testWorkStealingScheduler.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class WorkStealingScheduler.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <vector>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/WorkStealingScheduler.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class WorkStealingScheduler.
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Counts the runs of each task and checks the thread index. The
+ * tasks have unbalanced costs so that stealing happens.
+ */
+struct CountingTask
+{
+  std::vector<unsigned int> runs;
+  std::vector<double> results;
+  unsigned int nbThreads;
+  bool validThreads;
+
+  void operator()( std::size_t task, unsigned int thread )
+  {
+    if ( thread >= nbThreads )
+      validThreads = false;
+    double sum = 0.0;
+    for ( std::size_t i = 0; i < ( task % 7 ) * 1000; ++i )
+      sum += 1.0 / ( 1.0 + i );
+    results[ task ] = sum;
+    ++runs[ task ];
+  }
+};
+
+bool testRun( unsigned int nbThreads, std::size_t nbTasks )
+{
+  WorkStealingScheduler scheduler( nbThreads );
+  CountingTask f;
+  f.runs.assign( nbTasks, 0 );
+  f.results.assign( nbTasks, 0.0 );
+  f.nbThreads = scheduler.threadNumber();
+  f.validThreads = true;
+  scheduler.run( nbTasks, f );
+
+  bool res = f.validThreads;
+  for ( std::size_t i = 0; i < nbTasks; ++i )
+    res = res && ( f.runs[ i ] == 1 );
+  trace.info() << scheduler << " tasks=" << nbTasks
+               << ( res ? " ok" : " ERROR" ) << std::endl;
+  return res;
+}
+
+bool testWorkStealingScheduler()
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  trace.beginBlock ( "Testing that every task runs exactly once ..." );
+  const unsigned int threads[] = { 1, 2, 3, 4, 8 };
+  const std::size_t tasks[] = { 0, 1, 3, 17, 1000 };
+  for ( unsigned int t = 0; t < 5; ++t )
+    for ( unsigned int n = 0; n < 5; ++n )
+      {
+        nbok += testRun( threads[ t ], tasks[ n ] ) ? 1 : 0;
+        nb++;
+      }
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "all tasks run once" << std::endl;
+  trace.endBlock();
+
+  trace.beginBlock ( "Testing the default number of threads ..." );
+  WorkStealingScheduler::setDefaultThreadNumber( 3 );
+  WorkStealingScheduler scheduler;
+#ifdef WITH_PTHREAD
+  nbok += ( scheduler.threadNumber() == 3 ) ? 1 : 0;
+#else
+  nbok += ( scheduler.threadNumber() == 1 ) ? 1 : 0;
+#endif
+  nb++;
+  WorkStealingScheduler::setDefaultThreadNumber( 0 );
+  nbok += ( WorkStealingScheduler::defaultThreadNumber()
+            == WorkStealingScheduler::hardwareConcurrency() ) ? 1 : 0;
+  nb++;
+  nbok += scheduler.isValid() ? 1 : 0;
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "default thread number" << std::endl;
+  trace.endBlock();
+
+  return nbok == nb;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  trace.beginBlock ( "Testing class WorkStealingScheduler" );
+  trace.info() << "Args:";
+  for ( int i = 0; i < argc; ++i )
+    trace.info() << " " << argv[ i ];
+  trace.info() << endl;
+
+  bool res = testWorkStealingScheduler(); // && ... other tests
+  trace.emphase() << ( res ? "Passed." : "Error." ) << endl;
+  trace.endBlock();
+  return res ? 0 : 1;
+}
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
@@ -34,6 +34,7 @@
 #include <cmath>
 #include <fstream>
 #include <vector>
+#include <algorithm>
 
 #include "DGtal/base/Common.h"
 #include "DGtal/base/Exceptions.h"
@@ -48,6 +49,9 @@
 #include "DGtal/helpers/StdDefs.h"
 
 #include "DGtal/geometry/curves/GreedySegmentation.h"
+#include "DGtal/io/readers/PointListReader.h"
+
+#include "ConfigTest.h"
 
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -212,6 +216,119 @@ bool testSegmentation()
 
 
 
+/**
+ * Checks that the segmentation of a vector of points, scanned with
+ * random-access iterators, is the same as the segmentation of the
+ * points range of the grid curve built from it. As in
+ * frechetSimplification, the last point of the vector is left out
+ * unless it is 4-adjacent to the first one, since the grid curve
+ * does not go through it.
+ */
+bool sameSegmentations( const std::vector<Z2i::Point> & contour,
+                        const std::string & name )
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  typedef PointVector<2,int> Point;
+
+  trace.beginBlock ( "Greedy segmentation of a vector of points: " + name );
+
+  Curve aCurve;
+  aCurve.initFromVector(contour);
+  Curve::PointsRange r = aCurve.getPointsRange();
+
+  typedef std::vector<Point>::const_iterator VectorIterator;
+  VectorIterator itBegin = contour.begin();
+  VectorIterator itEnd = contour.end();
+  if ( ( contour.front() - contour.back() ).norm1() != 1 )
+    --itEnd;
+  nbok += ( aCurve.size() == (unsigned int)(itEnd - itBegin) ) ? 1 : 0;
+  nb++;
+  nbok += std::equal( itBegin, itEnd, r.begin() ) ? 1 : 0;
+  nb++;
+
+  for ( double error = 1; error <= 5; error += 2 )
+    for ( int flagWidthOnly = 0; flagWidthOnly < 2; ++flagWidthOnly )
+      {
+        typedef FrechetShortcut<Curve::PointsRange::ConstIterator,int> RangeComputer;
+        typedef FrechetShortcut<VectorIterator,int> VectorComputer;
+        GreedySegmentation<RangeComputer> rangeSegmentation
+          ( r.begin(), r.end(), RangeComputer( error, flagWidthOnly ) );
+        GreedySegmentation<VectorComputer> vectorSegmentation
+          ( itBegin, itEnd, VectorComputer( error, flagWidthOnly ) );
+
+        // first vertex and number of points of each segment
+        std::vector<Point> rangeVertices, vectorVertices;
+        std::vector<int> rangeLengths, vectorLengths;
+        for ( GreedySegmentation<RangeComputer>::SegmentComputerIterator
+                it = rangeSegmentation.begin(),
+                itE = rangeSegmentation.end(); it != itE; ++it )
+          {
+            rangeVertices.push_back( *( it->begin() ) );
+            rangeLengths.push_back( std::distance( it->begin(), it->end() ) );
+          }
+        for ( GreedySegmentation<VectorComputer>::SegmentComputerIterator
+                it = vectorSegmentation.begin(),
+                itE = vectorSegmentation.end(); it != itE; ++it )
+          {
+            vectorVertices.push_back( *( it->begin() ) );
+            vectorLengths.push_back( it->end() - it->begin() );
+          }
+
+        trace.info() << "error=" << error << " widthOnly=" << flagWidthOnly
+                     << " #segments=" << vectorVertices.size() << std::endl;
+        nbok += ( rangeVertices == vectorVertices 
+                  && rangeLengths == vectorLengths ) ? 1 : 0;
+        nb++;
+      }
+
+  trace.info() << "(" << nbok << "/" << nb << ") "
+               << "same segmentations" << std::endl;
+  trace.endBlock();
+
+  return nbok == nb;
+}
+
+/**
+ * Compares the segmentations of vectors and grid curves on a closed
+ * contour (klokan.sdp), on an open curve and on a contour whose last
+ * point is not 4-adjacent to the first one.
+ */
+bool testSegmentationOnVector()
+{
+  typedef PointVector<2,int> Point;
+  std::string filename = testPath + "samples/klokan.sdp";
+  std::vector<Point> closed = PointListReader<Point>::getPointsFromFile( filename );
+
+  // 4-connected digitization of a sine wave
+  std::vector<Point> open;
+  open.push_back( Point( 0, 0 ) );
+  for ( int x = 1; x < 200; ++x )
+    {
+      int y = (int) floor( 20 * sin( x / 15.0 ) + 0.5 );
+      Point p = open.back();
+      while ( p[1] != y )
+        {
+          p[1] += ( y > p[1] ) ? 1 : -1;
+          open.push_back( p );
+        }
+      open.push_back( Point( x, y ) );
+    }
+
+  // boundary of a rectangle, stopped two steps before closing
+  std::vector<Point> unclosed;
+  for ( int x = 0; x < 30; ++x ) unclosed.push_back( Point( x, 0 ) );
+  for ( int y = 0; y < 12; ++y ) unclosed.push_back( Point( 30, y ) );
+  for ( int x = 30; x > 0; --x ) unclosed.push_back( Point( x, 12 ) );
+  for ( int y = 12; y > 1; --y ) unclosed.push_back( Point( 0, y ) );
+
+  return sameSegmentations( closed, "closed contour" )
+    && sameSegmentations( open, "open curve" )
+    && sameSegmentations( unclosed, "unclosed contour" );
+}
+
+
 ///////////////////////////////////////////////////////////////////////////////
 // Standard services - public :
 
@@ -225,7 +342,8 @@ int main( int argc, char** argv )
 
   testFrechetShortcutConceptChecking();
 
-  bool res = testFrechetShortcut() && testSegmentation(); // && ... other tests
+  bool res = testFrechetShortcut() && testSegmentation()
+    && testSegmentationOnVector(); // && ... other tests
   trace.emphase() << ( res ? "Passed." : "Error." ) << endl;
   trace.endBlock();
   return res ? 0 : 1;
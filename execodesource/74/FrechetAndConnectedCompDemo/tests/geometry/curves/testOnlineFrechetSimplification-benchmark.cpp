@@ -0,0 +1,148 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testOnlineFrechetSimplification-benchmark.cpp
+ * @ingroup Tests
+ *
+ * Benchmark of class OnlineFrechetSimplification: throughput in
+ * points per second.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/Clock.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/geometry/curves/FrechetShortcut.h"
+#include "DGtal/geometry/curves/GreedySegmentation.h"
+#include "DGtal/geometry/curves/OnlineFrechetSimplification.h"
+#include <boost/lexical_cast.hpp>
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+using namespace Z2i;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class OnlineFrechetSimplification-benchmark.
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * An endless 8-connected curve: a walk whose direction slowly and
+ * randomly turns, as a tracker feed.
+ */
+struct RandomWalk
+{
+  RandomWalk(): myPoint( 0, 0 ), myAngle( 0 ), myX( 0 ), myY( 0 )
+  { srand( 0 ); }
+
+  Point next()
+  {
+    myAngle += 0.2 * ( (double) rand() / RAND_MAX - 0.5 );
+    myX += cos( myAngle );
+    myY += sin( myAngle );
+    //8-neighbour of the current point towards the real position
+    const int dx = (int) floor( myX + 0.5 ) - myPoint[ 0 ];
+    const int dy = (int) floor( myY + 0.5 ) - myPoint[ 1 ];
+    myPoint += Point( dx > 0 ? 1 : ( dx < 0 ? -1 : 0 ),
+                      dy > 0 ? 1 : ( dy < 0 ? -1 : 0 ) );
+    return myPoint;
+  }
+
+  Point myPoint;
+  double myAngle, myX, myY;
+};
+
+/**
+ * Simplifies a curve of @a nbPoints points, read one at a time, and
+ * compares with the greedy segmentation of the stored curve.
+ */
+bool runATest( unsigned int nbPoints, double error )
+{
+  trace.beginBlock( "Curve of " + boost::lexical_cast<string>( nbPoints )
+                    + " points, error " + boost::lexical_cast<string>( error ) );
+  Clock c;
+
+  std::vector<Point> onlineVertices;
+  std::size_t maxBufferSize;
+  {
+    RandomWalk walk;
+    OnlineFrechetSimplification<Point,int> online( error );
+    std::back_insert_iterator< std::vector<Point> > out( onlineVertices );
+    c.startClock();
+    for ( unsigned int i = 0; i < nbPoints; ++i )
+      out = online.push( walk.next(), out );
+    maxBufferSize = online.maxBufferSize();
+    online.flush( out );
+    const double t = c.stopClock();
+    trace.info() << "Online: " << t << " ms, "
+                 << (unsigned long) ( 1000.0 * nbPoints / t ) << " points/s, "
+                 << onlineVertices.size() << " vertices, at most "
+                 << maxBufferSize << " points stored" << std::endl;
+  }
+
+  std::vector<Point> vertices;
+  {
+    RandomWalk walk;
+    std::vector<Point> curve( nbPoints );
+    for ( unsigned int i = 0; i < nbPoints; ++i )
+      curve[ i ] = walk.next();
+    typedef std::vector<Point>::const_iterator Iterator;
+    typedef FrechetShortcut<Iterator,int> SegmentComputer;
+    typedef GreedySegmentation<SegmentComputer> Segmentation;
+    c.startClock();
+    Segmentation segmentation( curve.begin(), curve.end(),
+                               SegmentComputer( error ) );
+    for ( Segmentation::SegmentComputerIterator it = segmentation.begin(),
+            itEnd = segmentation.end(); it != itEnd; ++it )
+      vertices.push_back( *( it->begin() ) );
+    const double t = c.stopClock();
+    trace.info() << "Stored curve: " << t << " ms, "
+                 << (unsigned long) ( 1000.0 * nbPoints / t ) << " points/s"
+                 << std::endl;
+  }
+
+  const bool res = ( vertices == onlineVertices );
+  trace.info() << ( res ? "Same vertices" : "Different vertices" ) << std::endl;
+  trace.endBlock();
+  return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  trace.beginBlock ( "Testing class OnlineFrechetSimplification-benchmark" );
+  trace.info() << "Args:";
+  for ( int i = 0; i < argc; ++i )
+    trace.info() << " " << argv[ i ];
+  trace.info() << endl;
+
+  bool res = runATest( 1000000, 2 ) && runATest( 1000000, 8 );
+  trace.emphase() << ( res ? "Passed." : "Error." ) << endl;
+  trace.endBlock();
+  return res ? 0 : 1;
+}
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,164 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testOnlineFrechetSimplification.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class OnlineFrechetSimplification.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <iterator>
+#include <vector>
+#include <string>
+#include "DGtal/base/Common.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/geometry/curves/FrechetShortcut.h"
+#include "DGtal/geometry/curves/GreedySegmentation.h"
+#include "DGtal/geometry/curves/OnlineFrechetSimplification.h"
+#include "DGtal/io/readers/PointListReader.h"
+#include "ConfigTest.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+using namespace Z2i;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class OnlineFrechetSimplification.
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Simplifies the curve of @a filename point by point and checks that
+ * the vertices are the ones of the greedy segmentation of the whole
+ * curve, and that only the points of the current segment are stored.
+ */
+bool testOnlineFrechetSimplification( const std::string & filename )
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  typedef std::vector<Point>::const_iterator Iterator;
+  typedef FrechetShortcut<Iterator,int> SegmentComputer;
+  typedef GreedySegmentation<SegmentComputer> Segmentation;
+
+  std::vector<Point> curve = PointListReader<Point>::getPointsFromFile( filename );
+
+  trace.beginBlock ( "Online simplification of " + filename );
+  for ( double error = 1; error <= 5; error += 2 )
+    for ( int flagWidthOnly = 0; flagWidthOnly < 2; ++flagWidthOnly )
+      {
+        std::vector<Point> vertices;
+        std::size_t maxLength = 0;
+        Segmentation segmentation( curve.begin(), curve.end(),
+                                   SegmentComputer( error, flagWidthOnly ) );
+        for ( Segmentation::SegmentComputerIterator it = segmentation.begin(),
+                itEnd = segmentation.end(); it != itEnd; ++it )
+          {
+            vertices.push_back( *( it->begin() ) );
+            maxLength = std::max<std::size_t>( maxLength,
+                                               it->end() - it->begin() );
+          }
+
+        OnlineFrechetSimplification<Point,int> online( error, flagWidthOnly );
+        std::vector<Point> onlineVertices;
+        std::back_insert_iterator< std::vector<Point> > out( onlineVertices );
+        for ( Iterator it = curve.begin(); it != curve.end(); ++it )
+          out = online.push( *it, out );
+        const std::size_t maxBufferSize = online.maxBufferSize();
+        nbok += ( online.size() == curve.size() ) ? 1 : 0;
+        nb++;
+        online.flush( out );
+
+        trace.info() << "error=" << error << " widthOnly=" << flagWidthOnly
+                     << " #vertices=" << onlineVertices.size()
+                     << " max stored=" << maxBufferSize
+                     << " longest segment=" << maxLength << std::endl;
+        nbok += ( onlineVertices == vertices ) ? 1 : 0;
+        nb++;
+        // the point that closes a segment is stored with it
+        nbok += ( maxBufferSize <= maxLength + 1 ) ? 1 : 0;
+        nb++;
+        nbok += ( online.bufferSize() == 0 ) ? 1 : 0;
+        nb++;
+      }
+  trace.info() << "(" << nbok << "/" << nb << ") "
+               << "same vertices, bounded storage" << std::endl;
+  trace.endBlock();
+
+  return nbok == nb;
+}
+
+/**
+ * Simplifies several curves with the same object.
+ */
+bool testSeveralCurves()
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  trace.beginBlock ( "Several curves" );
+  std::vector<Point> line;
+  for ( int i = 0; i < 20; ++i )
+    line.push_back( Point( i, i / 3 ) );
+
+  OnlineFrechetSimplification<Point,int> online( 2 );
+  std::vector<Point> first, second;
+  for ( unsigned int i = 0; i < line.size(); ++i )
+    online.push( line[ i ], std::back_inserter( first ) );
+  online.flush( std::back_inserter( first ) );
+  for ( unsigned int i = 0; i < line.size(); ++i )
+    online.push( line[ i ], std::back_inserter( second ) );
+  online.flush( std::back_inserter( second ) );
+
+  trace.info() << online << std::endl;
+  nbok += ( first.size() == 1 && first[ 0 ] == line[ 0 ] ) ? 1 : 0;
+  nb++;
+  nbok += ( first == second ) ? 1 : 0;
+  nb++;
+  nbok += online.isValid() ? 1 : 0;
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+               << "one vertex per digital straight segment" << std::endl;
+  trace.endBlock();
+
+  return nbok == nb;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  trace.beginBlock ( "Testing class OnlineFrechetSimplification" );
+  trace.info() << "Args:";
+  for ( int i = 0; i < argc; ++i )
+    trace.info() << " " << argv[ i ];
+  trace.info() << endl;
+
+  bool res = testOnlineFrechetSimplification( testPath + "samples/klokan.sdp" )
+    && testOnlineFrechetSimplification( testPath + "samples/france.sdp" )
+    && testSeveralCurves();
+  trace.emphase() << ( res ? "Passed." : "Error." ) << endl;
+  trace.endBlock();
+  return res ? 0 : 1;
+}
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,172 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testPackedFreemanChain.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class PackedFreemanChain.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/Clock.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/geometry/curves/FreemanChain.h"
+#include "DGtal/geometry/curves/PackedFreemanChain.h"
+#include "ConfigTest.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class PackedFreemanChain.
+///////////////////////////////////////////////////////////////////////////////
+
+typedef FreemanChain<int> Chain;
+typedef PackedFreemanChain<int> PackedChain;
+typedef Chain::Point Point;
+
+/**
+ * Packs the chain of @a filename and compares codes, points and text
+ * with the ones of FreemanChain.
+ */
+bool testPackedFreemanChain( const std::string & filename )
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  trace.beginBlock ( "Packed chain of " + filename );
+  std::fstream inputStream( filename.c_str(), ios::in );
+  Chain fc( inputStream );
+  inputStream.close();
+
+  PackedChain pfc( fc );
+  trace.info() << pfc << std::endl;
+  nbok += ( pfc.isValid() && pfc.size() == fc.size()
+            && pfc.nbBytes() == ( fc.size() + 3 ) / 4 ) ? 1 : 0;
+  nb++;
+
+  bool sameCodes = true;
+  for ( PackedChain::ConstCodeIterator it = pfc.codesBegin();
+        it != pfc.codesEnd(); ++it )
+    sameCodes = sameCodes && ( *it == fc.code( it.getPosition() ) );
+  nbok += ( sameCodes && ( pfc.codesEnd() - pfc.codesBegin() == (int) fc.size() )
+            && ( pfc.codesBegin()[ 5 ] == fc.code( 5 ) ) ) ? 1 : 0;
+  nb++;
+
+  std::vector<Point> points, packedPoints;
+  Chain::getContourPoints( fc, points );
+  pfc.getContourPoints( packedPoints );
+  nbok += ( points == packedPoints ) ? 1 : 0;
+  nb++;
+  nbok += ( pfc.lastPoint() == fc.lastPoint() ) ? 1 : 0;
+  nb++;
+
+  // round trips: points, FreemanChain and text
+  PackedChain fromPoints( points );
+  nbok += ( fromPoints.toFreemanChain() == fc ) ? 1 : 0;
+  nb++;
+  std::ostringstream fcText, packedText;
+  Chain::write( fcText, fc );
+  pfc.write( packedText );
+  std::istringstream in( packedText.str() );
+  PackedChain fromText;
+  fromText.read( in );
+  nbok += ( fcText.str() == packedText.str()
+            && fromText.toString() == fc.chain ) ? 1 : 0;
+  nb++;
+
+  trace.info() << "(" << nbok << "/" << nb << ") "
+               << "same codes, points and text as FreemanChain" << std::endl;
+  trace.endBlock();
+  return nbok == nb;
+}
+
+/**
+ * Chains of every length modulo 4, and decoding time of a long chain.
+ */
+bool testLengths()
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  trace.beginBlock ( "Chains of every length" );
+  std::string s;
+  for ( unsigned int n = 0; n < 9; ++n )
+    {
+      Chain fc( s, 3, -2 );
+      PackedChain pfc( fc );
+      std::vector<Point> points, packedPoints;
+      Chain::getContourPoints( fc, points );
+      pfc.getContourPoints( packedPoints );
+      nbok += ( pfc.toString() == s && points == packedPoints ) ? 1 : 0;
+      nb++;
+      s += (char) ( '0' + ( n * 7 + 1 ) % 4 );
+    }
+
+  std::string longChain;
+  for ( unsigned int i = 0; i < 4000000; ++i )
+    longChain += (char) ( '0' + ( i / 3 + i / 7 ) % 4 );
+  Chain fc( longChain, 0, 0 );
+  PackedChain pfc( fc );
+  std::vector<Point> points, packedPoints;
+  Clock c;
+  c.startClock();
+  Chain::getContourPoints( fc, points );
+  trace.info() << "FreemanChain points: " << c.stopClock() << " ms" << std::endl;
+  c.startClock();
+  pfc.getContourPoints( packedPoints );
+  trace.info() << "PackedFreemanChain points: " << c.stopClock() << " ms, "
+               << pfc.nbBytes() << " bytes instead of " << fc.chain.size()
+               << std::endl;
+  nbok += ( points == packedPoints ) ? 1 : 0;
+  nb++;
+
+  trace.info() << "(" << nbok << "/" << nb << ") "
+               << "same points" << std::endl;
+  trace.endBlock();
+  return nbok == nb;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  trace.beginBlock ( "Testing class PackedFreemanChain" );
+  trace.info() << "Args:";
+  for ( int i = 0; i < argc; ++i )
+    trace.info() << " " << argv[ i ];
+  trace.info() << endl;
+
+  bool res = testPackedFreemanChain( testPath + "samples/france.fc" )
+    && testPackedFreemanChain( testPath + "samples/contourS.fc" )
+    && testLengths();
+  trace.emphase() << ( res ? "Passed." : "Error." ) << endl;
+  trace.endBlock();
+  return res ? 0 : 1;
+}
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
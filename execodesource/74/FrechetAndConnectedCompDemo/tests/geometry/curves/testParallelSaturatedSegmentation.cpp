@@ -0,0 +1,208 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testParallelSaturatedSegmentation.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class ParallelSaturatedSegmentation.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/Clock.h"
+#include "DGtal/base/Circulator.h"
+#include "DGtal/kernel/PointVector.h"
+#include "DGtal/geometry/curves/FreemanChain.h"
+#include "DGtal/geometry/curves/ArithmeticalDSS.h"
+#include "DGtal/geometry/curves/SaturatedSegmentation.h"
+#include "DGtal/geometry/curves/ParallelSaturatedSegmentation.h"
+#include "ConfigTest.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class ParallelSaturatedSegmentation.
+///////////////////////////////////////////////////////////////////////////////
+
+typedef PointVector<2,int> Point;
+typedef std::vector<Point> Curve;
+typedef Curve::const_iterator ConstIterator;
+typedef Circulator<ConstIterator> ConstCirculator;
+
+/// Numbers of chunks, 0 for the default one.
+const unsigned int nbChunks[ 4 ] = { 0, 1, 7, 100 };
+
+/**
+ * @return the 4-connected digitization of a circle of radius @a r,
+ * without repeating the first point.
+ */
+Curve digitalCircle( double r )
+{
+  Curve curve;
+  Point p( (int) std::floor( r + 0.5 ), 0 );
+  const unsigned int n = (unsigned int) ( 16 * r ) + 16;
+  for ( unsigned int i = 1; i <= n; ++i )
+    {
+      const double t = 2.0 * M_PI * i / n;
+      const Point q( (int) std::floor( r * std::cos( t ) + 0.5 ),
+                     (int) std::floor( r * std::sin( t ) + 0.5 ) );
+      while ( p[ 0 ] != q[ 0 ] )
+        {
+          curve.push_back( p );
+          p[ 0 ] += ( q[ 0 ] > p[ 0 ] ) ? 1 : -1;
+        }
+      while ( p[ 1 ] != q[ 1 ] )
+        {
+          curve.push_back( p );
+          p[ 1 ] += ( q[ 1 ] > p[ 1 ] ) ? 1 : -1;
+        }
+    }
+  return curve;
+}
+
+/**
+ * @return 'true' if the parallel segmentation @a par has the same
+ * maximal segments as the sequential one [ @a it, @a itEnd ).
+ */
+template <typename SegmentIterator, typename ParallelSegmentation>
+bool sameSegments( SegmentIterator it, const SegmentIterator & itEnd,
+                   const ParallelSegmentation & par )
+{
+  typename ParallelSegmentation::SegmentComputerIterator pit = par.begin();
+  for ( ; ( it != itEnd ) && ( pit != par.end() ); ++it, ++pit )
+    if ( ( it->begin() != pit->begin() ) || ( it->end() != pit->end() ) )
+      return false;
+  return ( it == itEnd ) && ( pit == par.end() );
+}
+
+/**
+ * Compares the maximal DSSs of the points of @a curve, seen as an
+ * open range, with the ones of SaturatedSegmentation.
+ */
+bool testOpenRange( const Curve & curve, const std::string & name )
+{
+  typedef ArithmeticalDSS<ConstIterator,int,4> DSS;
+  typedef SaturatedSegmentation<DSS> Segmentation;
+  typedef ParallelSaturatedSegmentation<DSS> ParallelSegmentation;
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  trace.beginBlock ( "Open range: " + name );
+  Segmentation seq( curve.begin(), curve.end(), DSS() );
+  for ( unsigned int threads = 1; threads <= 4; threads *= 2 )
+    for ( unsigned int i = 0; i < 4; ++i )
+      {
+        ParallelSegmentation par( curve.begin(), curve.end(), DSS(),
+                                  threads, nbChunks[ i ] );
+        trace.info() << par << std::endl;
+        nbok += ( par.isValid()
+                  && sameSegments( seq.begin(), seq.end(), par ) ) ? 1 : 0;
+        nb++;
+      }
+  ParallelSegmentation small( curve.begin(), curve.begin() + 40, DSS(), 2, 5 );
+  Segmentation smallSeq( curve.begin(), curve.begin() + 40, DSS() );
+  nbok += sameSegments( smallSeq.begin(), smallSeq.end(), small ) ? 1 : 0;
+  nb++;
+
+  trace.info() << "(" << nbok << "/" << nb << ") "
+               << "same maximal segments as SaturatedSegmentation" << std::endl;
+  trace.endBlock();
+  return nbok == nb;
+}
+
+/**
+ * Compares the maximal DSSs of the closed curve @a curve, seen
+ * through circulators, with the ones of SaturatedSegmentation in
+ * mode "First".
+ */
+bool testClosedCurve( const Curve & curve, const std::string & name )
+{
+  typedef ArithmeticalDSS<ConstCirculator,int,4> DSS;
+  typedef SaturatedSegmentation<DSS> Segmentation;
+  typedef ParallelSaturatedSegmentation<DSS> ParallelSegmentation;
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  trace.beginBlock ( "Closed curve: " + name );
+  ConstCirculator c( curve.begin(), curve.begin(), curve.end() );
+  Clock clock;
+  clock.startClock();
+  Segmentation seq( c, c, DSS() );
+  seq.setMode( "First" );
+  unsigned int nbSeq = 0;
+  for ( Segmentation::SegmentComputerIterator it = seq.begin();
+        it != seq.end(); ++it )
+    ++nbSeq;
+  trace.info() << curve.size() << " points, " << nbSeq
+               << " maximal segments in " << clock.stopClock() << " ms"
+               << std::endl;
+  for ( unsigned int threads = 1; threads <= 4; threads *= 2 )
+    for ( unsigned int i = 0; i < 4; ++i )
+      {
+        clock.startClock();
+        ParallelSegmentation par( c, c, DSS(), threads, nbChunks[ i ] );
+        trace.info() << par << " in " << clock.stopClock() << " ms"
+                     << std::endl;
+        nbok += ( par.isValid()
+                  && sameSegments( seq.begin(), seq.end(), par ) ) ? 1 : 0;
+        nb++;
+      }
+
+  trace.info() << "(" << nbok << "/" << nb << ") "
+               << "same maximal segments as SaturatedSegmentation" << std::endl;
+  trace.endBlock();
+  return nbok == nb;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  trace.beginBlock ( "Testing class ParallelSaturatedSegmentation" );
+  trace.info() << "Args:";
+  for ( int i = 0; i < argc; ++i )
+    trace.info() << " " << argv[ i ];
+  trace.info() << endl;
+
+  std::string filename = testPath + "samples/france.fc";
+  std::fstream inputStream( filename.c_str(), ios::in );
+  FreemanChain<int> fc( inputStream );
+  inputStream.close();
+  Curve france( fc.begin(), fc.end() );
+  if ( france.front() == france.back() )
+    france.pop_back();
+
+  bool res = testOpenRange( france, "france.fc" )
+    && testOpenRange( digitalCircle( 500 ), "circle" )
+    && testClosedCurve( france, "france.fc" )
+    && testClosedCurve( digitalCircle( 2000 ), "circle" );
+  trace.emphase() << ( res ? "Passed." : "Error." ) << endl;
+  trace.endBlock();
+  return res ? 0 : 1;
+}
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
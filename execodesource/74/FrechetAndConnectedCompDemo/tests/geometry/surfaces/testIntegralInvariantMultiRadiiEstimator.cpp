@@ -0,0 +1,200 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testIntegralInvariantMultiRadiiEstimator.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing class IntegralInvariantMultiRadiiEstimator.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/Clock.h"
+
+#include "DGtal/shapes/GaussDigitizer.h"
+#include "DGtal/topology/LightImplicitDigitalSurface.h"
+#include "DGtal/topology/DigitalSurface.h"
+#include "DGtal/geometry/surfaces/FunctorOnCells.h"
+#include "DGtal/images/ImageHelper.h"
+#include "DGtal/graph/DepthFirstVisitor.h"
+#include "DGtal/graph/GraphVisitorRange.h"
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantMeanCurvatureEstimator.h"
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantGaussianCurvatureEstimator.h"
+#include "DGtal/geometry/surfaces/estimation/IntegralInvariantMultiRadiiEstimator.h"
+#include "DGtal/math/MPolynomial.h"
+#include "DGtal/io/readers/MPolynomialReader.h"
+#include "DGtal/shapes/implicit/ImplicitPolynomial3Shape.h"
+
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class IntegralInvariantMultiRadiiEstimator.
+///////////////////////////////////////////////////////////////////////////////
+
+typedef Z3i::KSpace::Surfel Surfel;
+typedef Z3i::Space::RealPoint::Coordinate Ring;
+typedef MPolynomial< 3, Ring > Polynomial3;
+typedef MPolynomialReader< 3, Ring > Polynomial3Reader;
+typedef ImplicitPolynomial3Shape< Z3i::Space > MyShape;
+typedef GaussDigitizer< Z3i::Space, MyShape > MyGaussDigitizer;
+typedef LightImplicitDigitalSurface< Z3i::KSpace, MyGaussDigitizer > MyLightImplicitDigitalSurface;
+typedef DigitalSurface< MyLightImplicitDigitalSurface > MyDigitalSurface;
+typedef ImageSelector< Z3i::Domain, unsigned int >::Type Image;
+typedef ImageToConstantFunctor< Image, MyGaussDigitizer > MyPointFunctor;
+typedef FunctorOnCells< MyPointFunctor, Z3i::KSpace > MyCellFunctor;
+typedef DepthFirstVisitor< MyDigitalSurface > Visitor;
+typedef GraphVisitorRange< Visitor > VisitorRange;
+typedef MyShape::RealPoint RealPoint;
+
+/**
+ * Evaluates @a TEstimator for several radii at once, with 1 and 4
+ * threads, and compares with the evaluation of one estimator per
+ * radius, chunk by chunk. The incremental evaluation depends on the
+ * first surfel of a range: the estimates are also compared with the
+ * ones computed on the whole range.
+ */
+template <typename TEstimator>
+bool testMultiRadii( const std::string & name, double h )
+{
+  typedef typename TEstimator::Quantity Quantity;
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  trace.beginBlock ( "Multi-radii " + name + " curvature of a sphere" );
+
+  std::string poly_str = "x^2 + y^2 + z^2 - 25";
+  double border_min[3] = { -10, -10, -10 };
+  double border_max[3] = { 10, 10, 10 };
+
+  Polynomial3 poly;
+  Polynomial3Reader reader;
+  reader.read ( poly, poly_str.begin(), poly_str.end() );
+  MyShape shape( poly );
+
+  MyGaussDigitizer gaussDigShape;
+  gaussDigShape.attach( shape );
+  gaussDigShape.init( RealPoint( border_min ), RealPoint( border_max ), h );
+  Z3i::Domain domain = gaussDigShape.getDomain();
+  Z3i::KSpace kSpace;
+  kSpace.init( domain.lowerBound(), domain.upperBound(), true );
+
+  Image image( domain );
+  DGtal::imageFromRangeAndValue( domain.begin(), domain.end(), image );
+
+  SurfelAdjacency< Z3i::KSpace::dimension > SAdj( true );
+  Surfel bel = Surfaces< Z3i::KSpace >::findABel( kSpace, gaussDigShape, 100000 );
+  MyLightImplicitDigitalSurface lightImplDigSurf( kSpace, gaussDigShape, SAdj, bel );
+  MyDigitalSurface digSurfShape( lightImplDigSurf );
+
+  MyPointFunctor pointFunctor( &image, &gaussDigShape, 1, true );
+  MyCellFunctor functorShape ( pointFunctor, kSpace );
+
+  // surfels in the order of a surface traversal
+  VisitorRange range( new Visitor( digSurfShape, *digSurfShape.begin() ) );
+  std::vector< Surfel > surfels( range.begin(), range.end() );
+
+  std::vector< double > radii;
+  radii.push_back( 3.0 );
+  radii.push_back( 4.217163327 );
+  radii.push_back( 5.5 );
+
+  const unsigned int chunkSize = 100;
+  Clock c;
+  c.startClock();
+  std::vector< std::vector< Quantity > > expected( radii.size() );
+  std::vector< std::vector< Quantity > > whole( radii.size() );
+  for ( unsigned int r = 0; r < radii.size(); ++r )
+    {
+      TEstimator estimator( kSpace, functorShape );
+      estimator.init( h, radii[ r ] );
+      std::back_insert_iterator< std::vector< Quantity > > out( expected[ r ] );
+      for ( unsigned int i = 0; i < surfels.size(); i += chunkSize )
+        estimator.eval( surfels.begin() + i,
+                        surfels.begin() + std::min<std::size_t>( i + chunkSize, surfels.size() ),
+                        out );
+      std::back_insert_iterator< std::vector< Quantity > > outWhole( whole[ r ] );
+      estimator.eval( surfels.begin(), surfels.end(), outWhole );
+    }
+  trace.info() << surfels.size() << " surfels, one radius at a time: "
+               << c.stopClock() << " ms" << std::endl;
+
+  IntegralInvariantMultiRadiiEstimator< TEstimator > estimator( kSpace, functorShape, chunkSize );
+  estimator.init( h, radii );
+  trace.info() << estimator << std::endl;
+  nbok += estimator.isValid() ? 1 : 0;
+  nb++;
+  for ( unsigned int nbThreads = 1; nbThreads <= 4; nbThreads *= 4 )
+    {
+      std::vector< Quantity > results;
+      c.startClock();
+      estimator.eval( surfels.begin(), surfels.end(), results, nbThreads );
+      trace.info() << nbThreads << " thread(s): " << c.stopClock() << " ms"
+                   << std::endl;
+
+      bool same = ( results.size() == surfels.size() * radii.size() );
+      for ( unsigned int i = 0; same && i < surfels.size(); ++i )
+        for ( unsigned int r = 0; r < radii.size(); ++r )
+          same = same && std::fabs( results[ i * radii.size() + r ]
+                                    - expected[ r ][ i ] ) < 1e-9;
+      nbok += same ? 1 : 0;
+      nb++;
+
+      Quantity diff = 0, mean = 0;
+      for ( unsigned int i = 0; i < surfels.size(); ++i )
+        for ( unsigned int r = 0; r < radii.size(); ++r )
+          {
+            diff += std::fabs( results[ i * radii.size() + r ] - whole[ r ][ i ] );
+            mean += std::fabs( whole[ r ][ i ] );
+          }
+      trace.info() << "relative difference with the whole range: "
+                   << diff / mean << std::endl;
+      nbok += ( diff <= 0.01 * mean ) ? 1 : 0;
+      nb++;
+    }
+  trace.info() << "(" << nbok << "/" << nb << ") "
+               << "same estimates as one estimator per radius" << std::endl;
+  trace.endBlock();
+  return nbok == nb;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  trace.beginBlock ( "Testing class IntegralInvariantMultiRadiiEstimator" );
+  trace.info() << "Args:";
+  for ( int i = 0; i < argc; ++i )
+    trace.info() << " " << argv[ i ];
+  trace.info() << std::endl;
+
+  bool res = testMultiRadii< IntegralInvariantMeanCurvatureEstimator< Z3i::KSpace, MyCellFunctor > >( "mean", 0.6 )
+    && testMultiRadii< IntegralInvariantGaussianCurvatureEstimator< Z3i::KSpace, MyCellFunctor > >( "Gaussian", 0.6 );
+  trace.emphase() << ( res ? "Passed." : "Error." ) << std::endl;
+  trace.endBlock();
+  return res ? 0 : 1;
+}
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
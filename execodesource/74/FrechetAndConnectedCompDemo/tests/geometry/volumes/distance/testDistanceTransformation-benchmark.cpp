@@ -0,0 +1,125 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testDistanceTransformation-benchmark.cpp
+ * @ingroup Tests
+ *
+ * Scaling of the separable distance transformation with the number
+ * of threads of the WorkStealingScheduler, in 2D and 3D.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <cstdlib>
+#include "DGtal/base/Common.h"
+#include "DGtal/base/WorkStealingScheduler.h"
+#include "DGtal/helpers/StdDefs.h"
+#include "DGtal/images/ImageContainerBySTLVector.h"
+#include "DGtal/images/imagesSetsUtils/SimpleThresholdForegroundPredicate.h"
+#include "DGtal/geometry/volumes/distance/ExactPredicateLpSeparableMetric.h"
+#include "DGtal/geometry/volumes/distance/DistanceTransformation.h"
+#include <boost/lexical_cast.hpp>
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class DistanceTransformation-benchmark.
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Computes the exact Euclidean DT of a random image (one background
+ * point out of @a density) with 1, 2, 4, ... threads and checks that
+ * the Voronoi maps are the same as the sequential one.
+ */
+template <typename Space>
+bool runATest( typename Space::Integer size, unsigned int density )
+{
+  typedef HyperRectDomain<Space> Domain;
+  typedef typename Space::Point Point;
+  typedef ImageContainerBySTLVector<Domain, unsigned int> Image;
+  typedef SimpleThresholdForegroundPredicate<Image> Predicate;
+  typedef ExactPredicateLpSeparableMetric<Space, 2> L2Metric;
+  typedef DistanceTransformation<Space, Predicate, L2Metric> DT;
+
+  Domain domain( Point::diagonal( 0 ), Point::diagonal( size - 1 ) );
+  Image image( domain );
+  srand( 0 );
+  for ( typename Image::Iterator it = image.begin(), itend = image.end();
+        it != itend; ++it )
+    *it = ( rand() % density == 0 ) ? 0 : 128;
+  Predicate predicate( image, 0 );
+  L2Metric l2;
+
+  std::string txt = "Testing dimension " 
+    + boost::lexical_cast<string>( (unsigned int) Space::dimension ) 
+    + ", size " + boost::lexical_cast<string>( size );
+  trace.beginBlock( txt );
+
+  WorkStealingScheduler::setDefaultThreadNumber( 1 );
+  trace.beginBlock( "1 thread" );
+  DT reference( &domain, &predicate, &l2 );
+  trace.endBlock();
+
+  bool res = true;
+  const unsigned int maxThreads = 
+    std::max( 4u, WorkStealingScheduler::hardwareConcurrency() );
+  for ( unsigned int t = 2; t <= maxThreads; t *= 2 )
+    {
+      WorkStealingScheduler::setDefaultThreadNumber( t );
+      trace.beginBlock( boost::lexical_cast<string>( t ) + " threads" );
+      DT dt( &domain, &predicate, &l2 );
+      trace.endBlock();
+      for ( typename Domain::ConstIterator it = domain.begin(), 
+              itend = domain.end(); it != itend; ++it )
+        if ( dt.getVoronoiVector( *it ) != reference.getVoronoiVector( *it ) )
+          {
+            trace.error() << "Different sites at " << *it << std::endl;
+            res = false;
+            break;
+          }
+    }
+  WorkStealingScheduler::setDefaultThreadNumber( 0 );
+
+  trace.endBlock();
+  return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  trace.beginBlock ( "Testing class DistanceTransformation-benchmark" );
+  trace.info() << "Args:";
+  for ( int i = 0; i < argc; ++i )
+    trace.info() << " " << argv[ i ];
+  trace.info() << endl;
+  trace.info() << "Hardware concurrency = "
+               << WorkStealingScheduler::hardwareConcurrency() << endl;
+
+  bool res = runATest<Z2i::Space>( 2048, 100 ) 
+    && runATest<Z3i::Space>( 160, 100 );
+  trace.emphase() << ( res ? "Passed." : "Error." ) << endl;
+  trace.endBlock();
+  return res ? 0 : 1;
+}
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
@@ -33,6 +33,8 @@
 #include "DGtal/kernel/SpaceND.h"
 #include "DGtal/kernel/domains/HyperRectDomain.h"
 #include "DGtal/io/boards/Board2D.h"
+#include <sstream>
+#include <string>
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -126,6 +128,72 @@ bool testDomain()
     return true;
 }
 
+/**
+ * Removes the creation date of an EPS drawing.
+ */
+std::string withoutDate( std::string eps )
+{
+  std::string::size_type begin = eps.find( "%%CreationDate" );
+  if ( begin != std::string::npos )
+    eps.erase( begin, eps.find( '\n', begin ) - begin );
+  return eps;
+}
+
+void drawShapes( Board & board )
+{
+  board.setPenColorRGBi( 255, 0, 0 );
+  board.setLineWidth( 2 );
+  for ( int i = 0; i < 20; ++i )
+    {
+      board.drawLine( i, 0, i + 3, 10 );
+      board.fillCircle( i, i, 1 );
+    }
+  board << LibBoard::Rectangle( 0, 30, 30, 30, Color::Blue, Color::None, 0.0 );
+  LibBoard::ShapeList list;
+  list << LibBoard::Circle( 10, 40, 5, Color::Green, Color::None, 1.0 )
+       << LibBoard::Line( 0, 40, 20, 40, Color::Black, 1.0 );
+  board << list;
+}
+
+/**
+ * A drawing written while it is made is the one saved at the end,
+ * when its bounding box is declared.
+ */
+bool testStreamingBoard()
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+
+  trace.beginBlock ( "Streaming board" );
+  Board board;
+  drawShapes( board );
+  Rect box = board.boundingBox();
+  std::ostringstream eps, svg;
+  board.saveEPS( eps, 800, 800 );
+  board.saveSVG( svg, 800, 800 );
+
+  std::ostringstream streamEPS, streamSVG;
+  Board b1;
+  b1.beginStreamEPS( streamEPS, box, 800, 800 );
+  drawShapes( b1 );
+  nbok += ( b1.isStreaming() && b1.boundingBox().width == 0 ) ? 1 : 0;
+  nb++;
+  b1.endStream();
+  nbok += ( withoutDate( eps.str() ) == withoutDate( streamEPS.str() ) ) ? 1 : 0;
+  nb++;
+  {
+    Board b2;
+    b2.beginStreamSVG( streamSVG, box, 800, 800 );
+    drawShapes( b2 );
+  }
+  nbok += ( svg.str() == streamSVG.str() ) ? 1 : 0;
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+               << "same EPS and SVG, no shape stored" << std::endl;
+  trace.endBlock();
+  return nbok == nb;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Standard services - public :
 
@@ -137,7 +205,8 @@ int main( int argc, char** argv )
     trace.info() << " " << argv[ i ];
   trace.info() << endl;
 
-  bool res = testSimpleBoard() && testDomain(); // && ... other tests
+  bool res = testSimpleBoard() && testDomain()
+    && testStreamingBoard(); // && ... other tests
   trace.emphase() << ( res ? "Passed." : "Error." ) << endl;
   trace.endBlock();
   return res ? 0 : 1;
@@ -0,0 +1,320 @@
+/**
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as
+ *  published by the Free Software Foundation, either version 3 of the
+ *  License, or  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ **/
+
+/**
+ * @file testCellCodeSet.cpp
+ * @ingroup Tests
+ *
+ * Functions for testing classes KhalimskyCellCoder, CellCodeSet and
+ * CellCodeMap.
+ *
+ * This file is part of the DGtal library.
+ */
+
+///////////////////////////////////////////////////////////////////////////////
+#include <iostream>
+#include <set>
+#include <map>
+#include <vector>
+#include <cstdlib>
+#include "DGtal/base/Common.h"
+#include "DGtal/topology/KhalimskySpaceND.h"
+#include "DGtal/topology/SurfelAdjacency.h"
+#include "DGtal/topology/KhalimskyCellCoder.h"
+#include "DGtal/topology/CellCodeSet.h"
+#include "DGtal/topology/helpers/Surfaces.h"
+///////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+using namespace DGtal;
+
+///////////////////////////////////////////////////////////////////////////////
+// Functions for testing class CellCodeSet.
+///////////////////////////////////////////////////////////////////////////////
+
+typedef KhalimskySpaceND<3, DGtal::int32_t> KSpace;
+typedef KSpace::Point Point;
+typedef KSpace::Cell Cell;
+typedef KSpace::SCell SCell;
+
+/// The digital points of a Euclidean ball.
+struct BallPredicate
+{
+  typedef KSpace::Point Point;
+  Point myCenter;
+  DGtal::int64_t mySquaredRadius;
+  BallPredicate( const Point & c, DGtal::int64_t r ) 
+    : myCenter( c ), mySquaredRadius( r * r ) {}
+  bool operator()( const Point & p ) const
+  {
+    DGtal::int64_t d = 0;
+    for ( Dimension k = 0; k < Point::dimension; ++k )
+      d += ( (DGtal::int64_t) p[ k ] - myCenter[ k ] ) 
+        * ( (DGtal::int64_t) p[ k ] - myCenter[ k ] );
+    return d <= mySquaredRadius;
+  }
+};
+
+bool testKhalimskyCellCoder()
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+  
+  trace.beginBlock ( "Testing KhalimskyCellCoder ..." );
+  KSpace K;
+  K.init( Point( -3, 2, -7 ), Point( 4, 6, -1 ), true );
+  KhalimskyCellCoder<KSpace> coder( K );
+  trace.info() << coder << std::endl;
+  nbok += coder.isValid() ? 1 : 0; 
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "coder.isValid()" << std::endl;
+
+  // Every cell of the space, with both signs.
+  bool ok = true;
+  std::set<KhalimskyCellCoder<KSpace>::Code> codes;
+  Point kp;
+  for ( kp[ 2 ] = K.lowerCell().myCoordinates[ 2 ]; 
+        kp[ 2 ] <= K.upperCell().myCoordinates[ 2 ]; ++kp[ 2 ] )
+    for ( kp[ 1 ] = K.lowerCell().myCoordinates[ 1 ]; 
+          kp[ 1 ] <= K.upperCell().myCoordinates[ 1 ]; ++kp[ 1 ] )
+      for ( kp[ 0 ] = K.lowerCell().myCoordinates[ 0 ]; 
+            kp[ 0 ] <= K.upperCell().myCoordinates[ 0 ]; ++kp[ 0 ] )
+        {
+          Cell c = K.uCell( kp );
+          Cell dc;
+          coder.decode( coder.code( c ), dc );
+          ok = ok && ( dc == c );
+          for ( int s = 0; s < 2; ++s )
+            {
+              SCell sc = K.sCell( kp, s == 0 );
+              SCell dsc;
+              coder.decode( coder.code( sc ), dsc );
+              ok = ok && ( dsc == sc );
+              codes.insert( coder.code( sc ) );
+            }
+        }
+  nbok += ok ? 1 : 0; 
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "decode( code( c ) ) == c" << std::endl;
+  nbok += ( codes.size() == 2 * 17 * 11 * 15 ) ? 1 : 0; 
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "codes are unique" << std::endl;
+
+  KSpace K2; // default space, too large
+  KhalimskyCellCoder<KSpace> coder2( K2 );
+  nbok += ( ! coder2.isValid() ) ? 1 : 0; 
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "! coder2.isValid() " << coder2 << std::endl;
+  trace.endBlock();
+  
+  return nbok == nb;
+}
+
+bool testCellCodeSet()
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+  
+  trace.beginBlock ( "Testing CellCodeSet and CellCodeMap against std::set and std::map ..." );
+  KSpace K;
+  K.init( Point( -20, -20, -20 ), Point( 20, 20, 20 ), true );
+  CellCodeSet<KSpace> cellSet( K );
+  CellCodeMap<KSpace, int> cellMap( K );
+  std::set<SCell> refSet;
+  std::map<SCell, int> refMap;
+  srand( 0 );
+  bool ok = true;
+  for ( unsigned int i = 0; i < 200000; ++i )
+    {
+      Point kp( rand() % 11, rand() % 11, rand() % 11 );
+      SCell c = K.sCell( K.lowerCell().myCoordinates + kp, rand() % 2 == 0 );
+      const int action = rand() % 3;
+      if ( action == 0 )
+        {
+          ok = ok && ( cellSet.erase( c ) == refSet.erase( c ) );
+          ok = ok && ( cellMap.erase( c ) == refMap.erase( c ) );
+        }
+      else
+        {
+          ok = ok && ( cellSet.insert( c ).second == refSet.insert( c ).second );
+          cellMap[ c ] += action;
+          refMap[ c ] += action;
+        }
+      ok = ok && ( cellSet.count( c ) == refSet.count( c ) );
+    }
+  nbok += ( ok && ( cellSet.size() == refSet.size() ) ) ? 1 : 0; 
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "random insertions/erasures " << cellSet << std::endl;
+
+  ok = true;
+  unsigned int n = 0;
+  for ( CellCodeSet<KSpace>::ConstIterator it = cellSet.begin(), 
+          itE = cellSet.end(); it != itE; ++it, ++n )
+    ok = ok && ( refSet.count( *it ) == 1 );
+  nbok += ( ok && ( n == refSet.size() ) ) ? 1 : 0; 
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "iteration visits each cell once" << std::endl;
+
+  ok = ( cellMap.size() == refMap.size() );
+  for ( CellCodeMap<KSpace, int>::Iterator it = cellMap.begin(), 
+          itE = cellMap.end(); it != itE; ++it )
+    ok = ok && ( refMap[ it.cell() ] == it.value() );
+  nbok += ok ? 1 : 0; 
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "map values " << cellMap << std::endl;
+
+  // Erasing most cells shrinks the table.
+  const CellCodeSet<KSpace>::Size capacity = cellSet.capacity();
+  std::vector<SCell> cells( refSet.begin(), refSet.end() );
+  for ( unsigned int i = 10; i < cells.size(); ++i )
+    {
+      cellSet.erase( cells[ i ] );
+      refSet.erase( cells[ i ] );
+    }
+  ok = ( cellSet.size() == refSet.size() );
+  for ( std::set<SCell>::const_iterator it = refSet.begin(), 
+          itE = refSet.end(); it != itE; ++it )
+    ok = ok && ( cellSet.count( *it ) == 1 );
+  nbok += ( ok && ( cellSet.capacity() < capacity )
+            && ( cellSet.capacity() <= 16 
+                 || 8 * cellSet.size() >= cellSet.capacity() ) ) ? 1 : 0; 
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "erasures shrink the table " << cellSet << std::endl;
+  trace.endBlock();
+  
+  return nbok == nb;
+}
+
+bool testTrackBoundary()
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+  
+  trace.beginBlock ( "Testing trackBoundary with a CellCodeSet ..." );
+  KSpace K;
+  K.init( Point( -70, -70, -70 ), Point( 70, 70, 70 ), true );
+  BallPredicate ball( Point( 1, 2, 3 ), 60 );
+  SurfelAdjacency<3> SAdj( true );
+  SCell bel = Surfaces<KSpace>::findABel( K, ball, 
+                                          Point( 1, 2, 3 ), Point( 69, 2, 3 ) );
+
+  std::set<SCell> refBoundary;
+  trace.beginBlock ( "Tracking into a std::set ..." );
+  Surfaces<KSpace>::trackBoundary( refBoundary, K, SAdj, ball, bel );
+  trace.endBlock();
+
+  CellCodeSet<KSpace> boundary( K );
+  trace.beginBlock ( "Tracking into a CellCodeSet ..." );
+  Surfaces<KSpace>::trackBoundary( boundary, K, SAdj, ball, bel );
+  trace.endBlock();
+
+  bool ok = ( boundary.size() == refBoundary.size() );
+  for ( std::set<SCell>::const_iterator it = refBoundary.begin(), 
+          itE = refBoundary.end(); it != itE; ++it )
+    ok = ok && ( boundary.count( *it ) == 1 );
+  nbok += ok ? 1 : 0; 
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "same boundary, size=" << boundary.size() << std::endl;
+
+  CellCodeSet<KSpace> bdry( K );
+  Surfaces<KSpace>::sMakeBoundary( bdry, K, ball, 
+                                   K.lowerBound(), K.upperBound() );
+  nbok += ( bdry.size() == refBoundary.size() ) ? 1 : 0; 
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "sMakeBoundary size=" << bdry.size() << std::endl;
+  trace.endBlock();
+  
+  return nbok == nb;
+}
+
+typedef KhalimskySpaceND<2, DGtal::int32_t> KSpace2;
+
+/// The digital points of two Euclidean disks.
+struct TwoDisksPredicate
+{
+  typedef KSpace2::Point Point;
+  bool operator()( const Point & p ) const
+  {
+    return ( p[ 0 ] + 20 ) * ( p[ 0 ] + 20 ) + p[ 1 ] * p[ 1 ] <= 225
+      || ( p[ 0 ] - 20 ) * ( p[ 0 ] - 20 ) + p[ 1 ] * p[ 1 ] <= 100;
+  }
+};
+
+bool testExtractAll2DSCellContours()
+{
+  unsigned int nbok = 0;
+  unsigned int nb = 0;
+  
+  trace.beginBlock ( "Testing extractAll2DSCellContours with a CellCodeSet ..." );
+  typedef KSpace2::SCell SCell2;
+  KSpace2 K;
+  K.init( KSpace2::Point( -40, -40 ), KSpace2::Point( 40, 40 ), true );
+  TwoDisksPredicate disks;
+  SurfelAdjacency<2> SAdj( true );
+
+  std::vector< std::vector<SCell2> > refContours;
+  Surfaces<KSpace2>::extractAll2DSCellContours( refContours, K, SAdj, disks );
+  CellCodeSet<KSpace2> bdry( K );
+  std::vector< std::vector<SCell2> > contours;
+  Surfaces<KSpace2>::extractAll2DSCellContours( bdry, contours, K, SAdj, disks );
+
+  // The contours may come in another order and start from other surfels.
+  std::set< std::set<SCell2> > refSet, set;
+  for ( unsigned int i = 0; i < refContours.size(); ++i )
+    refSet.insert( std::set<SCell2>( refContours[ i ].begin(), 
+                                     refContours[ i ].end() ) );
+  for ( unsigned int i = 0; i < contours.size(); ++i )
+    set.insert( std::set<SCell2>( contours[ i ].begin(), 
+                                  contours[ i ].end() ) );
+  nbok += ( refContours.size() == 2 && contours.size() == 2
+            && set == refSet && bdry.empty() ) ? 1 : 0; 
+  nb++;
+  trace.info() << "(" << nbok << "/" << nb << ") "
+	       << "same contours, nb=" << contours.size() << std::endl;
+  trace.endBlock();
+  
+  return nbok == nb;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Standard services - public :
+
+int main( int argc, char** argv )
+{
+  trace.beginBlock ( "Testing class CellCodeSet" );
+  trace.info() << "Args:";
+  for ( int i = 0; i < argc; ++i )
+    trace.info() << " " << argv[ i ];
+  trace.info() << endl;
+
+  bool res = testKhalimskyCellCoder() && testCellCodeSet()
+    && testTrackBoundary() && testExtractAll2DSCellContours();
+  trace.emphase() << ( res ? "Passed." : "Error." ) << endl;
+  trace.endBlock();
+  return res ? 0 : 1;
+}
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
@@ -338,6 +338,14 @@ bool testObject3D()
 
   trace.endBlock();
 
+  trace.beginBlock ( "Components of diamond_clone.border() with a bitmap ..." );
+  ObjectType border1 = objects[ 1 ].border();
+  vector<ObjectType> objects3;
+  back_insert_iterator< vector< ObjectType > > inserter3( objects3 );
+  unsigned int nbc2 = border1.writeComponentsInDomain( inserter3 );
+  INBLOCK_TEST( nbc2 == 3 );
+  trace.endBlock();
+
   return nbok == nb;
 
 }
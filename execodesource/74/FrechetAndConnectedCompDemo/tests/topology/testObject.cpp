@@ -342,6 +342,28 @@ bool testObject3D()
 
   trace.endBlock();
 
+  trace.beginBlock ( "Testing connected component extraction with a bitmap ..." );
+  ObjectType border1 = objects[ 1 ].border();
+  trace.beginBlock ( "Components of diamond_clone.border() with a bitmap ..." );
+  vector<ObjectType> objects3;
+  back_insert_iterator< vector< ObjectType > > inserter3( objects3 );
+  unsigned int nbc2 = ObjectType( border1 ).writeComponentsInDomain( inserter3 );
+  INBLOCK_TEST( nbc2 == 3 );
+  trace.endBlock();
+  bool same = ( objects3.size() + 1 == objects2.size() );
+  for ( unsigned int i = 0; same && i < objects3.size(); ++i )
+    {
+      same = objects3[ i ].size() == objects2[ i + 1 ].size();
+      for ( ObjectType::ConstIterator it = objects3[ i ].begin(),
+              itend = objects3[ i ].end(); same && it != itend; ++it )
+        same = objects2[ i + 1 ].pointSet().find( *it ) 
+          != objects2[ i + 1 ].pointSet().end();
+    }
+  INBLOCK_TEST2( same, "same components as writeComponents" );
+  INBLOCK_TEST( objects[ 0 ].border().computeConnectednessInDomain() == CONNECTED );
+  INBLOCK_TEST( objects[ 1 ].border().computeConnectednessInDomain() == DISCONNECTED );
+  trace.endBlock();
+
   return nbok == nb;
 
 }
@@ -161,7 +161,7 @@ main( int argc, char** argv )
   // Prepare arguments.
 
   args.addOption( "-step", "-step <h>: the discretization step or resolution, the closer to 0, the finer.", "1.0" );
-  args.addOption( "-minimizer", "-minimizer <type> <a>: choose the minimizer for global geometry computation, <type>=STD mix gradient/optimal, <type>=GD gradient descent, <type>=AGD adaptive step gradient descent, <type>=RLX Relaxation.", "RLX", "0.5" );
+  args.addOption( "-minimizer", "-minimizer <type> <a>: choose the minimizer for global geometry computation, <type>=STD mix gradient/optimal, <type>=GD gradient descent, <type>=AGD adaptive step gradient descent, <type>=RLX Relaxation, <type>=RB red-black relaxation (parallel).", "RLX", "0.5" );
   args.addOption( "-eps", "-eps <max> <sum>: specifies max and sum epsilon to stop optimization in global geometry computation.", "0.0000001", "-1.0" );
   
   if ( ( argc <= 0 ) 
@@ -203,6 +203,8 @@ main( int argc, char** argv )
       ( args.getOption( "-minimizer" )->getDoubleValue( 1 ) );
   else if ( args.getOption( "-minimizer" )->getValue( 0 ) == "RLX" )
     lm = new LinearMinimizerByRelaxation;
+  else if ( args.getOption( "-minimizer" )->getValue( 0 ) == "RB" )
+    lm = new LinearMinimizerByRedBlackRelaxation;
   else
     lm = new LinearMinimizer;
 
@@ -152,6 +152,7 @@ main( int argc, char** argv )
   indices[ 0 ] = curv_idx;
   indices[ 1 ] = cabs_idx;
   readShapeGeometry( cin, stats, indices );
+  stats.terminate();
   uint nb = stats.samples( 0 );
   vector<double> x( nb + 1 );
   vector<double> y( nb + 1 );
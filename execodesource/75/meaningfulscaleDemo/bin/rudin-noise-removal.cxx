@@ -111,6 +111,20 @@ public:
   {
     return m_data[ x + y*m_w ];
   }
+  PixelType* data()
+  {
+    return m_data;
+  }
+  const PixelType* data() const
+  {
+    return m_data;
+  }
+  void swap( Image2D<PixelType> & other )
+  {
+    std::swap( m_w, other.m_w );
+    std::swap( m_h, other.m_h );
+    std::swap( m_data, other.m_data );
+  }
 
   void reset( PixelType v )
   {
@@ -422,89 +436,127 @@ void rudinByVese( const Grille2D & u0, Grille2D & uf,
  * the data in the original ROF. However, this trick makes the
  * denoising work well.
  *
+ * The grids are scanned directly as row-major arrays, without
+ * branches in the inner loop so that the compiler vectorizes the
+ * computation of the coefficients. Rows are shared between threads
+ * when OpenMP is available, and u_n and u_n+1 are swapped instead of
+ * copied.
+ *
  * @param u0 the input image
  * @param uf (returns) the denoised image
  * @param dh the grid step which is 1/max(width,height)
- * @param nb the number of iterations
+ * @param nb the maximal number of iterations
  *
  * @param lambda the scale coefficient (small (< 0.5): smooth a lot
  * and removes noise, high (>2): keeps features but also noise).
+ *
+ * @param tol when positive, stops as soon as the mean absolute
+ * variation of the pixels during one iteration is below [tol].
  */
 void rudinByVese2( const Grille2D & u0, Grille2D & uf,
-		   double dh, uint nb, double lambda )
+		   double dh, uint nb, double lambda, double tol )
 {
   cerr << "--- Rudin et al. By Vese 2 (" << u0.w() << "," << u0.h() << ")" 
        << " dh=" << dh << " lambda=" << lambda << endl;
   cerr << "    [";
   
   Grille2D un( u0 );
-  uint w = u0.w();
-  uint h = u0.h();
-  uint wm = w - 1;
-  uint hm = h - 1;
+  int w = u0.w();
+  int h = u0.h();
+  int wm = w - 1;
+  int hm = h - 1;
   double eps = 1e-6;
-  double eps2 = sqr( eps );
   double eps2dh2 = sqr( eps * dh );
   double d = 1 / ( 2.0 * lambda * sqr( dh ) );
+  uint progress = ( nb >= 20 ) ? nb / 20 : 1;
   Grille2D unn( u0 );
-  for ( uint n = 0; n < nb; ++n )
+  const double* f = u0.data();
+  uint n = 0;
+  for ( ; n < nb; ++n )
     {
-      if ( n % ( nb / 20 ) == 0 )
+      if ( n % progress == 0 )
 	cerr << "." << flush;
       // Boundary conditions
-      for ( uint j = 1; j < hm; ++j )
+      double* u = un.data();
+      for ( int j = 1; j < hm; ++j )
 	{
-	  un.setPixel( 0, j, un.u( 1, j ) );
-	  un.setPixel( wm, j, un.u( wm - 1, j ) );
+	  u[ j * w ] = u[ j * w + 1 ];
+	  u[ j * w + wm ] = u[ j * w + wm - 1 ];
 	}
-      for ( uint i = 1; i < wm; ++i )
+      for ( int i = 1; i < wm; ++i )
 	{
-	  un.setPixel( i, 0, un.u( i, 1 ) );
-	  un.setPixel( i, hm, un.u( i, hm - 1 ) );
+	  u[ i ] = u[ w + i ];
+	  u[ hm * w + i ] = u[ ( hm - 1 ) * w + i ];
 	}
-      un.setPixel( 0, 0, un.u( 1, 1 ) );
-      un.setPixel( wm, 0, un.u( wm - 1, 1 ) );
-      un.setPixel( 0, hm, un.u( 1, hm - 1 ) );
-      un.setPixel( wm, hm, un.u( wm - 1, hm - 1 ) );
+      u[ 0 ] = u[ w + 1 ];
+      u[ wm ] = u[ w + wm - 1 ];
+      u[ hm * w ] = u[ ( hm - 1 ) * w + 1 ];
+      u[ hm * w + wm ] = u[ ( hm - 1 ) * w + wm - 1 ];
       // Compute u_n+1
-      double v;
-      double dv;
-      for ( uint j = 1; j < hm; ++j )
-	for ( uint i = 1; i < wm; ++i )
-	  {
-	    double c1 = dh /
-	      sqrt( eps2dh2 + sqr( un.dxp( i, j ) ) 
-		    + sqr( un.dy0( i, j ) ) );
-	    double c2 = dh /
-	      sqrt( eps2dh2 + sqr( un.dxm( i, j ) ) 
-		    + sqr( un.dy0( i - 1, j ) ) );
-	    double c3 = dh /
-	      sqrt( eps2dh2 + sqr( un.dx0( i, j ) ) 
-		    + sqr( un.dyp( i, j ) ) );
-	    double c4 = dh /
-	      sqrt( eps2dh2 + sqr( un.dx0( i, j - 1 ) ) 
-		    + sqr( un.dym( i, j ) ) );
-	    v = 1.0 / ( 1.0 + d * ( c1 + c2 + c3 + c4 ) )
-	      * ( u0.u( i, j ) 
-		  + d * ( c1 * un.u( i + 1, j ) + c2 * un.u( i - 1, j ) 
-			  + c3 * un.u( i, j + 1 ) + c4 * un.u( i, j - 1 ) ) ); 
-	    unn.setPixel( i, j, v );
-	  }
-      // double sum_u = 0.0;
-      // double sum_u2 = 0.0;
-      // for ( uint j = 0; j < h; ++j )
-      // 	for ( uint i = 0; i < w; ++i )
-      // 	  {
-      // 	    sum_u += un.u( i, j );
-      // 	    sum_u2 += sqr( un.u( i, j ) );
-      // 	  }
-      // cerr << ", E[u]=" << ( sum_u / (double) (w*h) )
-      // 	   << ", sigma[u]=" << sqrt( - sqr( sum_u / (double) (w*h) ) 
-      // 				     + sum_u2 / (double) (w*h) ) << endl;
-      un = unn;
+      double* unext = unn.data();
+      double diff = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) reduction(+:diff)
+#endif
+      for ( int j = 1; j < hm; ++j )
+	{
+	  const double* r = u + j * w;
+	  const double* rm = r - w;
+	  const double* rp = r + w;
+	  const double* fr = f + j * w;
+	  double* out = unext + j * w;
+	  for ( int i = 1; i < wm; ++i )
+	    {
+	      double dxp = r[ i + 1 ] - r[ i ];
+	      double dxm = r[ i ] - r[ i - 1 ];
+	      double dyp = rp[ i ] - r[ i ];
+	      double dym = r[ i ] - rm[ i ];
+	      double dx0 = ( r[ i + 1 ] - r[ i - 1 ] ) * 0.5;
+	      double dx0m = ( rm[ i + 1 ] - rm[ i - 1 ] ) * 0.5;
+	      double dy0 = ( rp[ i ] - rm[ i ] ) * 0.5;
+	      double dy0m = ( rp[ i - 1 ] - rm[ i - 1 ] ) * 0.5;
+	      double c1 = dh / sqrt( eps2dh2 + dxp * dxp + dy0 * dy0 );
+	      double c2 = dh / sqrt( eps2dh2 + dxm * dxm + dy0m * dy0m );
+	      double c3 = dh / sqrt( eps2dh2 + dx0 * dx0 + dyp * dyp );
+	      double c4 = dh / sqrt( eps2dh2 + dx0m * dx0m + dym * dym );
+	      out[ i ] = 1.0 / ( 1.0 + d * ( c1 + c2 + c3 + c4 ) )
+		* ( fr[ i ] 
+		    + d * ( c1 * r[ i + 1 ] + c2 * r[ i - 1 ] 
+			    + c3 * rp[ i ] + c4 * rm[ i ] ) ); 
+	    }
+	  // Variation of the row, while it is still in cache.
+	  if ( tol > 0.0 )
+	    for ( int i = 1; i < wm; ++i )
+	      diff += abs( out[ i ] - r[ i ] );
+	}
+      un.swap( unn );
+      if ( ( tol > 0.0 ) && ( w > 2 ) && ( h > 2 )
+	   && ( diff / ( (double) ( w - 2 ) * ( h - 2 ) ) < tol ) )
+	{
+	  ++n;
+	  break;
+	}
+    }
+  // The border of the result is the one of the input image, as when
+  // u_n+1 was copied into u_n.
+  if ( n > 0 )
+    {
+      double* u = un.data();
+      for ( int i = 0; i < w; ++i )
+	{
+	  u[ i ] = f[ i ];
+	  u[ hm * w + i ] = f[ hm * w + i ];
+	}
+      for ( int j = 1; j < hm; ++j )
+	{
+	  u[ j * w ] = f[ j * w ];
+	  u[ j * w + wm ] = f[ j * w + wm ];
+	}
     }
   uf = un;
   cerr << "]" << endl;
+  if ( n < nb )
+    cerr << "--- converged after " << n << " iterations." << endl;
 }
 
 void rudin( const Grille2D & u0, Grille2D & uf,
@@ -618,6 +670,7 @@ main( int argc, char** argv )
   args.addOption( "-c", "-c <val>: the constant in the CFL criterion.", "0.5" );
   args.addOption( "-nb", "-nb <n>: the number of iterations.", "10" );
   args.addOption( "-scheme", "-scheme <n>: 0: Rudin, 1: Vese, 2: Vese opt.", "2" );
+  args.addOption( "-tol", "-tol <val>: with scheme 2, stops before <nb> iterations when the mean absolute variation of the pixels is below <val> (0: no test).", "0.0" );
 
   if ( ( argc <= 0 ) 
        || ! args.readArguments( argc, argv ) ) 
@@ -632,6 +685,7 @@ main( int argc, char** argv )
   double sigma = args.getOption( "-sigma" )->getDoubleValue( 0 );
   double c = args.getOption( "-c" )->getDoubleValue( 0 );
   uint nb = args.getOption( "-nb" )->getIntValue( 0 );
+  double tol = args.getOption( "-tol" )->getDoubleValue( 0 );
 
   istream & in_str = StandardArguments::openInput( args );
   Image2D<unsigned char> img;
@@ -649,7 +703,7 @@ main( int argc, char** argv )
   double dt = c * sqr( dh );
   int scheme = args.getOption( "-scheme" )->getIntValue( 0 );
   if ( scheme == 2 )
-    rudinByVese2( u0, uf, dh, nb, sigma );
+    rudinByVese2( u0, uf, dh, nb, sigma, tol );
   else if ( scheme == 1 )
     rudinByVese( u0, uf, dt, dh, nb, sigma );
   else
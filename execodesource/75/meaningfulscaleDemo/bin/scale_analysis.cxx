@@ -253,6 +253,7 @@ main( int argc, char** argv )
   StandardArguments::addIOArgs( args, true, false );
   args.addOption( "-samplingSizeMax", "-samplingSizeMax <n>: choose how many scales are computed.", "10"  );
   args.addOption( "-nbIterationSpikes", "-nbIterationSpikes <n>: useful for very noisy contours, where their subsampling might be ill-formed. 10 is good for very noisy, 3 is enough for smooth.", "10"  );
+  args.addBooleanOption( "-onDemand", "-onDemand: computes the subsampled contours one at a time instead of keeping them all, so that memory stays linear in the contour length. Not compatible with -detailedProfile." );
   args.addOption( "-profile", "-profile <idx>: draws the profile of the surfel with index <idx> in the input freeman chain.", "0"  );
   args.addOption( "-detailedProfile", "-detailedProfile <idx>: draws the detailed profile of the surfel with index <idx> in the input freeman chain.", "0"  );
   args.addOption( "-affMapping", "-affMapping <r> <x0> <y0>: outputs the mapping between finest resolution and the given subsampling.", "1", "0", "0" );
@@ -307,7 +308,13 @@ main( int argc, char** argv )
 
   MultiscaleProfile MP;
   MP.chooseSubsampler( *ptr_fct, *ptr_fcsub );
-  MP.init( c, samplingSizeMax );
+  if ( args.check( "-onDemand" ) && args.check( "-detailedProfile" ) )
+    {
+      cerr << "Option -detailedProfile requires the stored length samples,"
+	   << " it is not compatible with -onDemand." << endl;
+      return 1;
+    }
+  MP.init( c, samplingSizeMax, args.check( "-onDemand" ) );
 
   if ( args.check( "-affMapping" ) )
     {
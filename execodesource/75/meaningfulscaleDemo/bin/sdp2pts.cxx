@@ -91,6 +91,7 @@ main( int argc, char** argv )
   indices[ 0 ] = 1;
   indices[ 1 ] = 2;
   readShapeGeometry( cin, stats, indices );
+  stats.terminate();
 
   uint n = stats.samples( 0 );
   vector<double> x( n );
@@ -196,23 +196,50 @@ main( int argc, char** argv )
   Clock::startClock();
 
 
+  //Computing the noise level for each pixel of all the contours. The
+  //contours are independent and processed in parallel when OpenMP is
+  //available; the results are displayed afterwards in order.
+  int nbContours = vectFC.size();
+  int userSamplingSizeMax = 20;
+  if(args.check("-setSamplingSizeMax")){    
+    userSamplingSizeMax = args.getOption("-setSamplingSizeMax")->getIntValue(0);    
+  } 
+  std::vector<int> vectSamplingSizeMax(nbContours);
+  std::vector< std::vector<uint> > vectNoiseLevels(nbContours);
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if(nbContours > 1)
+#endif
+  for(int k =0; k<nbContours; k++){
+    int sizeMax = userSamplingSizeMax;
+    uint samplingSizeMaxEstim = estimMaxSamplingSize(vectFC[k]);
+    if(samplingSizeMaxEstim<sizeMax)
+      sizeMax= samplingSizeMaxEstim;
+    vectSamplingSizeMax[k] = sizeMax;
+
+    int nbIterationSpikes = 5;
+    FreemanChainSubsample fcsub( 1, 1, 0, 0 );
+    FreemanChainCleanSpikesCCW fccs( nbIterationSpikes );
+    FreemanChainCompose fcomp( fccs, fcsub );
+    FreemanChainTransform* ptr_fct = &fcomp;
+    FreemanChainSubsample* ptr_fcsub = &fcsub;
+  
+    MultiscaleProfile MP;
+    MP.chooseSubsampler( *ptr_fct, *ptr_fcsub );
+    // Only the noise level is needed: subsampled contours are
+    // computed one at a time to keep memory linear in the contour size.
+    MP.init( vectFC[k], sizeMax, true );
+    MP.noiseLevels( vectNoiseLevels[k], mscales_min_size, mscales_max_slope );
+  }
 
 
   for(int k =0; k<vectFC.size(); k++){
-    samplingSizeMax=20;
     if(args.check("-processAllContours")){
       cerr << "Processing contour " << k << endl;    
     }
     FreemanChain fc = vectFC.at(k);
-  
-    if(args.check("-setSamplingSizeMax")){    
-      samplingSizeMax = args.getOption("-setSamplingSizeMax")->getIntValue(0);    
-    } 
-  
-    uint samplingSizeMaxEstim = estimMaxSamplingSize(fc);
-  
-    if(samplingSizeMaxEstim<samplingSizeMax)
-      samplingSizeMax= samplingSizeMaxEstim;
+    samplingSizeMax = vectSamplingSizeMax[k];
+    const std::vector<uint> & noiseLevels = vectNoiseLevels[k];
 
   
 
@@ -235,22 +262,6 @@ main( int argc, char** argv )
 
 
 
-    //Computing the noise level for each pixel:    
-  
-    int nbIterationSpikes = 5;
-  
-
-  
-    FreemanChainSubsample fcsub( 1, 1, 0, 0 );
-    FreemanChainCleanSpikesCCW fccs( nbIterationSpikes );
-    FreemanChainCompose fcomp( fccs, fcsub );
-    FreemanChainTransform* ptr_fct = &fcomp;
-    FreemanChainSubsample* ptr_fcsub = &fcsub;
-  
-    MultiscaleProfile MP;
-    MP.chooseSubsampler( *ptr_fct, *ptr_fcsub );
-    MP.init( fc, samplingSizeMax );
-
     Clock::startClock();
     cerr<< "Multi-scale computed in :" << time << " ms" << endl;
     cerr << "Contour size: " << fc.chain.size() << " surfels" << endl;
@@ -277,7 +288,7 @@ main( int argc, char** argv )
       uint code = it.getCode();
     
       Vector2i xy( *it );
-      noiseLevel =  MP.noiseLevel(i, mscales_min_size, mscales_max_slope);
+      noiseLevel =  noiseLevels[i];
 
     
     
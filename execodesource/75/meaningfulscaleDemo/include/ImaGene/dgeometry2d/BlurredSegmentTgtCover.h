@@ -277,6 +277,17 @@ namespace ImaGene
 
 
     bool myIsClosed;
+
+    /**
+     * The widths of the last call to 'getMeanLengthsMaximalSegments'.
+     */
+    std::vector<double> myCachedScalesWidth;
+
+    /**
+     * The mean lengths computed by the last call to
+     * 'getMeanLengthsMaximalSegments'.
+     */
+    std::vector< std::vector<double> > myCachedMeanLengths;
     
     Vector2D edgeP, edgeQ, vertexS;
     Vector2D edgePh, edgeQh, vertexSh;
@@ -387,6 +398,22 @@ namespace ImaGene
     Statistics* getStatsMaximalSegments(double scaleWidth);
   
 
+    /**
+     * Mean lengths of the maximal segments of each contour point for
+     * several widths, as given by 'getStatsMaximalSegments'. Each
+     * width is extracted on its own copy of the contour, in parallel
+     * when OpenMP is available, so that the tangential cover of this
+     * object is left unchanged. The result is cached: it is computed
+     * again only after an 'init' or for other widths.
+     *
+     * @param vectScalesWidth the widths of the blurred segments.
+     * @return for each width, the mean length of the maximal segments
+     * of each contour point.
+     */
+    const std::vector< std::vector<double> > & 
+    getMeanLengthsMaximalSegments(const std::vector<double> & vectScalesWidth);
+    
+
     
     
     void  getScaleProfile(std::vector<double>  vectScalesWidth, uint index, ScaleProfile &sp);
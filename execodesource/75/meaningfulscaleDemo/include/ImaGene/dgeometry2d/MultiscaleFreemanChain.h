@@ -145,6 +145,40 @@ namespace ImaGene
       }
     };
 
+    /**
+     * Caller-owned buffers storing, for each surfel of a Freeman
+     * chain, the statistics of the length of the maximal segments
+     * containing it (see getStatsMaximalSegments). The vectors keep
+     * their capacity from one call to the next one, so that
+     * processing many chains does not allocate memory once the
+     * buffers have reached the size of the longest chain.
+     */
+    struct MaximalSegmentStats
+    {
+      /**
+       * For each surfel, the number of maximal segments containing it.
+       */
+      std::vector<uint> samples;
+      /**
+       * For each surfel, the mean of (length - 1) of the maximal
+       * segments containing it.
+       */
+      std::vector<double> mean;
+      /**
+       * For each surfel, the maximum of (length - 1) of the maximal
+       * segments containing it.
+       */
+      std::vector<double> max;
+
+      /**
+       * Work buffers: back surfel, front surfel and length of each
+       * maximal segment of the tangential cover.
+       */
+      std::vector<uint> ms_back;
+      std::vector<uint> ms_front;
+      std::vector<uint> ms_size;
+    };
+
 
     // ----------------------- Standard services ------------------------------
   public:
@@ -177,8 +211,36 @@ namespace ImaGene
      *
      * @param src the source Freeman chain.
      * @param r the maximal resolution.
+     *
+     * @param on_demand when 'false' (default), all the subsampled
+     * chains are computed and stored in [m_map]. When 'true', none
+     * is stored: 'get' computes the requested one into a single
+     * buffer, so that the memory stays linear in the length of
+     * [src] whatever [r], and 'begin'/'end' are empty.
      */
-    void init( const FreemanChain & src, uint r );
+    void init( const FreemanChain & src, uint r, bool on_demand = false );
+
+    /**
+     * @return 'true' if the subsampled chains are computed on demand.
+     * @see init
+     */
+    INLINE bool isOnDemand() const;
+
+    /**
+     * Computes one subsampled chain of the source chain given at
+     * 'init', without storing it.
+     *
+     * @param key the key describing resolution and shifts.
+     *
+     * @param sub (returns) the subsampled chain and its mappings. Its
+     * buffers are reused, so that generating the chains one after
+     * the other into the same object allocates little memory.
+     *
+     * @return 'true' if the subsampling succeeded. Otherwise, [sub]
+     * is the same as the one stored by 'init' for this key.
+     */
+    bool subsample( const SubsampledChainKey & key, 
+		    SubsampledChain & sub ) const;
 
 
     /**
@@ -206,7 +268,9 @@ namespace ImaGene
      * @param key the key describing resolution and shifts.
      *
      * @return a pointer to the corresponding structure storing the
-     * subsampled chain, or 0 if no one was found.
+     * subsampled chain, or 0 if no one was found. In on-demand mode,
+     * the pointed chain is only valid until the next call to 'get'
+     * with another key.
      */
     const SubsampledChain* get( const SubsampledChainKey & key ) const;
 
@@ -214,7 +278,9 @@ namespace ImaGene
      * @param key the key describing resolution and shifts.
      *
      * @return a pointer to the corresponding structure storing the
-     * subsampled chain, or 0 if no one was found.
+     * subsampled chain, or 0 if no one was found. In on-demand mode,
+     * the pointed chain is only valid until the next call to 'get'
+     * with another key.
      */
     SubsampledChain* get( const SubsampledChainKey & key );
 
@@ -260,10 +326,37 @@ namespace ImaGene
      */
     std::map< SubsampledChainKey, SubsampledChain > m_map;
 
+    /**
+     * The maximal resolution given at 'init'.
+     */
+    uint m_r;
+
+    /**
+     * When 'true', subsampled chains are not stored in [m_map] but
+     * computed by 'get' into [m_current].
+     */
+    bool m_on_demand;
+
+    /**
+     * In on-demand mode, the last subsampled chain returned by 'get'
+     * and its key.
+     */
+    mutable SubsampledChain m_current;
+    mutable SubsampledChainKey m_current_key;
+
     // ------------------------- Hidden services ------------------------------
   protected:
 
 
+    /**
+     * In on-demand mode, computes the subsampled chain of key [key]
+     * into [m_current], unless it is already there.
+     *
+     * @return a pointer to [m_current], or 0 if [key] is not one of
+     * the resolutions and shifts given at 'init'.
+     */
+    SubsampledChain* getOnDemand( const SubsampledChainKey & key ) const;
+
   private:
 
     /**
@@ -296,7 +389,23 @@ namespace ImaGene
      * variables as the number of surfels of [fc].
      */
     static Statistics* getStatsMaximalSegments( FreemanChain & fc );
-  
+
+    /**
+     * Same statistics as getStatsMaximalSegments( FreemanChain & ),
+     * bit for bit, computed directly on the codes of [fc]: neither
+     * a digital space nor iterators nor a Statistics object are
+     * allocated, and [fc] is left untouched.
+     *
+     * @param fc the freeman chain code of the (closed) contour.
+     *
+     * @param stats (returns) the length statistics of maximal
+     * segments for each surfel of [fc]. If the contour has at most
+     * one maximal segment, all statistics are zero, as in the
+     * non-terminated Statistics object.
+     */
+    static void getStatsMaximalSegments( const FreemanChain & fc,
+					 MaximalSegmentStats & stats );
+
   };
 
   /**
@@ -246,6 +246,18 @@ public:
 				_ro_word_ptr src_end,
 				_word_ptr dst_beg );
 
+  /**
+   * Performs the bit AND NOT operation with the words between [src_beg] and 
+   * [src_end] into [dst_beg] and following words (ie, resets in the
+   * destination the bits that are set in the source).
+   * @param src_beg a pointer on the first word which to perform and not with.
+   * @param src_end a pointer on the word after the last one which to perform and not with.
+   * @param dst_beg a pointer on the first word which holds the result of the and not operation.
+   */
+  static INLINE void doWordAndNot( _ro_word_ptr src_beg,
+				   _ro_word_ptr src_end,
+				   _word_ptr dst_beg );
+
 
   // ------------------------- Static comparison services ---------------------
 public:
@@ -261,6 +273,17 @@ public:
 			       _ro_word_ptr src1_end,
 			       _ro_word_ptr src2_beg );
 
+  /**
+   * Finds the first word that is not zero between [src_beg] and
+   * [src_end]. Zero words are skipped several at a time with SSE2
+   * when available.
+   * @param src_beg a pointer on the first word to scan.
+   * @param src_end a pointer on the word after the last one to scan.
+   * @return a pointer on the first non-zero word or [src_end] if all words are zero.
+   */
+  static INLINE _ro_word_ptr doWordFindNonZero( _ro_word_ptr src_beg,
+						_ro_word_ptr src_end );
+
 
   // ------------------------- Standard services ------------------------------
 public:
@@ -436,6 +459,13 @@ public:
    * @return a reference on 'this'.
    */
   INLINE Bitset1 & operator^=( const Bitset1 & other );
+  /**
+   * Assignment with AND NOT operation (set difference). Sizes must be
+   * identical.
+   * @param other the object whose bits are reset in 'this'.
+   * @return a reference on 'this'.
+   */
+  INLINE Bitset1 & operator-=( const Bitset1 & other );
 
 
   // ------------------------- Comparisons ------------------------------------
@@ -138,6 +138,11 @@ public:
      * Current position in set.
      */
     Kn_gid m_current;
+    /**
+     * The bits of the word of [m_current] that follow it, so that
+     * 'next' visits the elements of a word without scanning the set.
+     */
+    _word m_bits;
 
     // ------------------------- Standard services ----------------------------
   public:
@@ -214,6 +219,13 @@ public:
      */
     INLINE bool operator<( const cell_iterator & other ) const;
 
+    // ------------------------- Internals ------------------------------------
+  private:
+    /**
+     * Reads [m_bits] from the set at position [m_current].
+     */
+    INLINE void loadBits();
+
   };
 
   /**
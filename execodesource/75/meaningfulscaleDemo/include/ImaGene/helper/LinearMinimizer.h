@@ -236,7 +236,7 @@ public:
    * @return the sum of the displacements.
    * @see oneStep
    */
-  double optimize( uint i1, uint i2 );
+  virtual double optimize( uint i1, uint i2 );
 
 
   /**
@@ -313,7 +313,6 @@ protected:
    */
   bool m_is_curve_open;
 
-private:
   /**
    * Sum of all the absolute displacements of the last optimisation step.
    */
@@ -396,6 +395,67 @@ public:
   
 
 
+  /**
+   * Specializes LinearMinimizerByRelaxation to relax the whole
+   * contour in parallel. Values of even index are relaxed first
+   * between their odd neighbors, then values of odd index between the
+   * new even ones (plus a third pass for the last value of a closed
+   * contour with an odd number of values). Each pass has no
+   * dependencies and is shared between threads when OpenMP is
+   * available, and the result does not depend on the number of
+   * threads. The displacements are accumulated during the passes.
+   * Optimizing a part of the contour is done sequentially as with
+   * LinearMinimizerByRelaxation.
+   */
+  class LinearMinimizerByRedBlackRelaxation 
+    : public LinearMinimizerByRelaxation
+  {
+  public:
+    /**
+     * Default constructor. Does nothing.
+     */
+    INLINE LinearMinimizerByRedBlackRelaxation();
+
+    /**
+     * Destructor. Does nothing.
+     */
+    INLINE virtual ~LinearMinimizerByRedBlackRelaxation();
+
+    /**
+     * Relaxes the values [i1] included to [i2] excluded. The whole
+     * contour (i1 == i2) is relaxed in parallel.
+     *
+     * @param i1 the first value to be optimized (between 0 and 'size()-1').
+     * @param i2 the value after the last to be optimized (between 0 and 'size()-1').
+     * @return the sum of the displacements.
+     */
+    virtual double optimize( uint i1, uint i2 );
+
+    // ----------------------- Interface --------------------------------------
+  public:
+    /**
+     * Writes/Displays the object on an output stream.
+     * @param that_stream the output stream where the object is written.
+     */
+    virtual void selfDisplay( std::ostream & that_stream ) const;
+
+  private:
+
+    /**
+     * Relaxes the values [first], [first]+2, ... below [last]
+     * (excluded) between their current neighbors.
+     *
+     * @param first the first value to relax.
+     * @param last the upper bound of the relaxed values.
+     * @param sum (updated) the sum of the displacements.
+     * @param max (updated) the max of the displacements.
+     */
+    void relaxEvery2( uint first, uint last, double & sum, double & max );
+
+  };
+  
+
+
   /**
    * Specializes LinearMinimizer to optimize with a gradient descent method.
    */
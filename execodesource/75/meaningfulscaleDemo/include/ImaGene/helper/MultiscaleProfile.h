@@ -94,8 +94,17 @@ namespace ImaGene
      *
      * @param src the source Freeman chain.
      * @param r the maximal resolution.
+     *
+     * @param on_demand when 'true', the subsampled chains are
+     * computed one at a time and not kept (see
+     * MultiscaleFreemanChain::init), and the individual length
+     * samples are not stored either, so that the memory stays linear
+     * in the length of [src]. 'profile', 'meaningfulScales' and
+     * 'noiseLevel' give the same results in both modes, but
+     * 'profileFromMedian' and 'detailedProfile' need the stored
+     * samples of the default mode.
      */
-    void init( const FreemanChain & src, uint r );
+    void init( const FreemanChain & src, uint r, bool on_demand = false );
 
     /**
      * @param x (returns) the x-value of the profile (log(scale+1)).
@@ -165,6 +174,38 @@ namespace ImaGene
 		     uint min_width = 1,
 		     double max_slope = -0.2 ) const;
 
+    /**
+     * Batch version of 'meaningfulScales' for all the surfels. The
+     * abscissae log(scale) are computed once, and the profiles are
+     * read scale after scale for blocks of consecutive surfels, so
+     * that the slopes of a block are computed in tight loops over
+     * contiguous arrays. Blocks are processed in parallel when
+     * OpenMP is available. Gives the same intervals as
+     * 'meaningfulScales' for each surfel.
+     *
+     * @param intervals (returns) for each surfel, its list of
+     * meaningful scales.
+     * @param min_width the minimum length for the meaningful scales.
+     * @param max_slope the maximum allowed slope for length evolution.
+     */
+    void allMeaningfulScales
+    ( std::vector< std::vector< std::pair< uint, uint > > > & intervals,
+      uint min_width = 1,
+      double max_slope = -0.2 ) const;
+
+    /**
+     * Batch version of 'noiseLevel' for all the surfels (see
+     * 'allMeaningfulScales').
+     *
+     * @param levels (returns) for each surfel, its noise level or
+     * zero if none was found.
+     * @param min_width the minimum length for the meaningful scales.
+     * @param max_slope the maximum allowed slope for length evolution.
+     */
+    void noiseLevels( std::vector<uint> & levels,
+		      uint min_width = 1,
+		      double max_slope = -0.2 ) const;
+
 
     /**
      * Test BK 21/09/09
@@ -241,6 +282,16 @@ namespace ImaGene
     
     
   private:
+
+    /**
+     * Common part of 'allMeaningfulScales' and 'noiseLevels'. Either
+     * pointer may be 0.
+     */
+    void batchMeaningfulScales
+    ( std::vector< std::vector< std::pair< uint, uint > > >* intervals,
+      std::vector<uint>* levels,
+      uint min_width,
+      double max_slope ) const;
     
     /**
      * Copy constructor.
@@ -190,6 +190,8 @@ namespace ImaGene
      * 
      * @return the [i]-th value for this variable.
      *
+     * @pre method 'terminate' or 'merge' must have been called after
+     * the last 'addValue'.
      * @see Statistics, init
      */
     INLINE double value( uint k, uint i ) const;
@@ -222,12 +224,27 @@ namespace ImaGene
     template <class Iter>
     void addValues( uint k, Iter b, Iter e );
 
+    /**
+     * Adds all the sample values of [other] to this object, as if
+     * they had been given with 'addValue' after the ones of this
+     * object. Both objects should have the same number of variables
+     * and store their samples or not alike, and 'terminate' should
+     * not have been called on any of them. Only sums, extrema and
+     * the stored values are concatenated, so that several objects
+     * filled in parallel are cheaply gathered into one. The stored
+     * values are then sorted by variable, as by 'terminate'.
+     *
+     * @param other any object filled with the same variables.
+     */
+    void merge( const Statistics & other );
+
     /** 
      * Once all sample values have been added to this object, computes
      * meaningful statistics like sample mean, variance and unbiased
-     * variance.
+     * variance, and sorts the stored values by variable so that
+     * 'value' can read them.
      * 
-     * @see mean, variance, unbiasedVariance, min, max
+     * @see mean, variance, unbiasedVariance, min, max, value
      */
     void terminate();
 
@@ -380,10 +397,27 @@ namespace ImaGene
     bool m_store_samples;
 
     /**
-     * For each variable, stores the sample values if
-     * [m_store_samples] is 'true'.
+     * Stores the sample values of all variables if [m_store_samples]
+     * is 'true'. They are in the order they were given until they
+     * are sorted by variable (see 'sortValues').
+     */
+    std::vector<double> m_values;
+
+    /**
+     * For each value of [m_values] not sorted yet, its variable.
      */
-    std::vector<double>* m_values;
+    std::vector<uint> m_values_var;
+
+    /**
+     * When [m_values] are sorted, the values of variable k are
+     * between indices m_values_offset[ k ] and m_values_offset[ k+1 ].
+     */
+    std::vector<uint> m_values_offset;
+
+    /**
+     * 'true' when [m_values] are sorted by variable.
+     */
+    bool m_values_sorted;
 
 
     // ------------------------- Hidden services ------------------------------
@@ -414,6 +448,19 @@ namespace ImaGene
   
     // ------------------------- Internals ------------------------------------
   private:
+
+    /**
+     * Sorts the stored values by variable (keeping their order within
+     * a variable) so that the values of each variable are contiguous,
+     * and frees [m_values_var]. Only one pass of counting sort.
+     */
+    void sortValues();
+
+    /**
+     * Undoes 'sortValues' so that new values can be appended: builds
+     * again the variable of each stored value.
+     */
+    void unsortValues();
   
   };
 
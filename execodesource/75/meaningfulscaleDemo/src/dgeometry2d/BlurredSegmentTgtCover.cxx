@@ -105,6 +105,8 @@ ImaGene::BlurredSegmentTgtCover::init( const FreemanChain & c )
       it.nextInLoop();
     }
   nbpointsCurve = PointsCurve.size(); 
+  myCachedScalesWidth.clear();
+  myCachedMeanLengths.clear();
 }
 
 
@@ -126,6 +128,8 @@ ImaGene::BlurredSegmentTgtCover::init( const vector<Vector2D> & contourVect, boo
   PointsCurve = contourVect;
   nbpointsCurve = PointsCurve.size(); 
   myIsClosed = isClosed;
+  myCachedScalesWidth.clear();
+  myCachedMeanLengths.clear();
 }
 
 
@@ -738,24 +742,75 @@ ImaGene::BlurredSegmentTgtCover::getStatsMaximalSegments(double scaleWidth){
 
 
 
+/**
+ * Mean lengths of the maximal segments of each contour point for
+ * several widths, as given by 'getStatsMaximalSegments'. Each
+ * width is extracted on its own copy of the contour, in parallel
+ * when OpenMP is available, so that the tangential cover of this
+ * object is left unchanged. The result is cached: it is computed
+ * again only after an 'init' or for other widths.
+ *
+ * @param vectScalesWidth the widths of the blurred segments.
+ * @return for each width, the mean length of the maximal segments
+ * of each contour point.
+ */
+const vector< vector<double> > & 
+ImaGene::BlurredSegmentTgtCover::getMeanLengthsMaximalSegments(const vector<double> & vectScalesWidth){
+  if( ( vectScalesWidth == myCachedScalesWidth ) 
+      && ( myCachedMeanLengths.size() == vectScalesWidth.size() ) ){
+    return myCachedMeanLengths;
+  }
+  int nbScales = vectScalesWidth.size();
+  int nbPoints = PointsCurve.size();
+  myCachedMeanLengths.assign( nbScales, vector<double>( nbPoints ) );
+  cerr<< "CurveSize :" << nbPoints << endl;
+  cerr << "Computing stats to all scales : [" ;
+  
+  // The Melkman hulls depend on the width: widths are extracted
+  // independently, each thread with its own copy of the contour.
+#ifdef _OPENMP
+#pragma omp parallel if(nbScales > 1)
+#endif
+  {
+    BlurredSegmentTgtCover tgc;
+    tgc.PointsCurve = PointsCurve;
+    tgc.nbpointsCurve = nbpointsCurve;
+    tgc.myIsClosed = myIsClosed;
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for(int i=0; i < nbScales; i++){
+      Statistics* stats = tgc.getStatsMaximalSegments(vectScalesWidth.at(i));
+      vector<double> & means = myCachedMeanLengths[i];
+      for(int k=0; k < nbPoints; k++){
+	means[k] = stats->mean(k);
+      }
+      delete stats;
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      cerr << ".";
+    }
+  }
+  cerr << "]" << endl;
+  myCachedScalesWidth = vectScalesWidth;
+  return myCachedMeanLengths;
+}
+
+
+
+
 void 
 ImaGene::BlurredSegmentTgtCover::computeNoiseAndSlope(std::vector<double> &vectNoise, 
 						      std::vector<double> &vectSlope, 
 						      std::vector<double> vectScalesWidth, uint minSize, double maxSlope){  
-  vector<Statistics *> allStats;
-  cerr<< "CurveSize :" << PointsCurve.size()<< endl;
-  cerr << "Computing stats to all scales : [" ;
-  for(uint i=0; i <vectScalesWidth.size(); i++){
-    allStats.push_back(getStatsMaximalSegments(vectScalesWidth.at(i)));
-    cerr << ".";
-  }
-  cerr << "]" << endl;
+  const vector< vector<double> > & allMeans = getMeanLengthsMaximalSegments(vectScalesWidth);
   // Construction of all the scale profiles:  
   for(int i=0; i<PointsCurve.size(); i++){
     ScaleProfile sp; 
     sp.init(vectScalesWidth.size());
     for(int j = 0; j< vectScalesWidth.size(); j++){
-      sp.addValue(j, (allStats.at(j)->mean(i))/(vectScalesWidth.at(j)));      
+      sp.addValue(j, (allMeans[j][i])/(vectScalesWidth.at(j)));      
     }
     vectNoise.push_back(sp.noiseLevel(minSize, maxSlope));
     std::pair<bool ,double> slope= sp.getSlopeFromMeaningfulScales(maxSlope, -1e20, minSize);
@@ -769,10 +824,6 @@ ImaGene::BlurredSegmentTgtCover::computeNoiseAndSlope(std::vector<double> &vectN
 
     
   }
-  for(int i=0;i < allStats.size(); i++){
-    delete allStats.at(i);
-  }  
-  
 }
     
     
@@ -780,26 +831,16 @@ ImaGene::BlurredSegmentTgtCover::computeNoiseAndSlope(std::vector<double> &vectN
 vector<double> 
 ImaGene::BlurredSegmentTgtCover::getNoiseLevels(vector<double>  vectScalesWidth, uint minSize, double maxSlope){
   vector<double> noiseLevels;
-  vector<Statistics *> allStats;
-  cerr<< "CurveSize :" << PointsCurve.size()<< endl;
-  cerr << "Computing stats to all scales : [" ;
-  for(uint i=0; i <vectScalesWidth.size(); i++){
-    allStats.push_back(getStatsMaximalSegments(vectScalesWidth.at(i)));
-    cerr << ".";
-  }
-  cerr << "]" << endl;
+  const vector< vector<double> > & allMeans = getMeanLengthsMaximalSegments(vectScalesWidth);
   // Construction of all the scale profiles:  
   for(int i=0; i<PointsCurve.size(); i++){
     ScaleProfile sp; 
     sp.init(vectScalesWidth.size());
     for(int j = 0; j< vectScalesWidth.size(); j++){
-      sp.addValue(j, (allStats.at(j)->mean(i))/(vectScalesWidth.at(j)));
+      sp.addValue(j, (allMeans[j][i])/(vectScalesWidth.at(j)));
     }
     noiseLevels.push_back(sp.noiseLevel(minSize, maxSlope));
   }  
-  for(int i=0;i < allStats.size(); i++){
-    delete allStats.at(i);
-  }  
   return noiseLevels;  
 }
 
@@ -808,18 +849,10 @@ ImaGene::BlurredSegmentTgtCover::getNoiseLevels(vector<double>  vectScalesWidth,
 
 void
 ImaGene::BlurredSegmentTgtCover::getScaleProfile(vector<double>  vectScalesWidth, uint index, ScaleProfile &sp){
-  vector<Statistics *> allStats;
-  cerr<< "CurveSize :" << PointsCurve.size()<< endl;
-  cerr << "Computing stats to alls scales : [" ;
-  for(uint i=0; i <vectScalesWidth.size(); i++){
-    allStats.push_back(getStatsMaximalSegments(vectScalesWidth.at(i)));
-    cerr << ".";
-  }
-  cerr << "]" << endl;
-  
+  const vector< vector<double> > & allMeans = getMeanLengthsMaximalSegments(vectScalesWidth);
   sp.init(vectScalesWidth.size());
   for(int j = 0; j< vectScalesWidth.size(); j++){
-    sp.addValue(j, (allStats.at(j)->mean(index))/(vectScalesWidth.at(j)));      
+    sp.addValue(j, (allMeans[j][index])/(vectScalesWidth.at(j)));      
   }  
 }
 
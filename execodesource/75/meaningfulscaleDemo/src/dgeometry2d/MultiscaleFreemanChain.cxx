@@ -30,6 +30,7 @@
 
 
 ///////////////////////////////////////////////////////////////////////////////
+#include <climits>
 #include "ImaGene/mathutils/Statistics.h"
 #include "ImaGene/mathutils/Mathutils.h"
 #include "ImaGene/dgeometry2d/C4CTangentialCover.h"
@@ -50,6 +51,66 @@ using namespace std;
 const char* const MultiscaleFreemanChain_RCS_ID = "@(#)class MultiscaleFreemanChain definition.";
 
 
+namespace {
+
+  /**
+   * Moves along the surfels of a Freeman chain exactly like a
+   * C4CIteratorOnFreemanChain (same returned codes, same behaviour at
+   * the extremities of open chains), but is a plain value: copying it
+   * replaces 'clone()' and it needs neither a digital space nor
+   * virtual calls.
+   */
+  struct FreemanCodeIterator
+  {
+    const std::string* chain;
+    uint pos;
+    bool loop;
+
+    FreemanCodeIterator( const std::string & c, bool l )
+      : chain( &c ), pos( 0 ), loop( l )
+    {}
+
+    uint code( uint i ) const
+    {
+      return (*chain)[ i ] - '0';
+    }
+
+    uint next()
+    {
+      uint ccur = code( pos );
+      ++pos;
+      if ( pos == chain->size() )
+	{
+	  if ( loop )
+	    pos = 0;
+	  else
+	    {
+	      --pos;
+	      return 0;
+	    }
+	}
+      return ( 6 + ccur - code( pos ) ) % 4; // cf FFMTable
+    }
+
+    uint previous()
+    {
+      if ( ( ! loop ) && ( pos == 0 ) )
+	return 0;
+      uint ccur = code( pos );
+      pos = ( pos == 0 ) ? chain->size() - 1 : pos - 1;
+      return ( 6 - ccur + code( pos ) ) % 4; // cf FBMTable
+    }
+
+    bool equals( const FreemanCodeIterator & other ) const
+    {
+      return pos == other.pos;
+    }
+  };
+
+}
+
+
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // class MultiscaleFreemanChain
@@ -91,33 +152,35 @@ ImaGene::MultiscaleFreemanChain::chooseSubsampler
  *
  * @param src the source Freeman chain.
  * @param r the maximal resolution.
+ *
+ * @param on_demand when 'false' (default), all the subsampled
+ * chains are computed and stored in [m_map]. When 'true', none
+ * is stored: 'get' computes the requested one into a single
+ * buffer, so that the memory stays linear in the length of
+ * [src] whatever [r], and 'begin'/'end' are empty.
  */
 void
-ImaGene::MultiscaleFreemanChain::init( const FreemanChain & src, uint r )
+ImaGene::MultiscaleFreemanChain::init( const FreemanChain & src, uint r,
+				       bool on_demand )
 {
-  cerr << "+--- computing multiresolution " << flush;
   m_src = &src;
+  m_r = r;
+  m_on_demand = on_demand;
+  m_current_key = SubsampledChainKey( 0, 0, 0, 0 );
+  if ( on_demand )
+    {
+      m_map.clear();
+      return;
+    }
+  cerr << "+--- computing multiresolution " << flush;
   for ( uint h = 1; h <= r; ++h )
     {
       cerr << "." << h << flush;
-      m_subsample->m_h = h;
-      m_subsample->m_v = h;
       // Computes all possible shifts for more robust multiscale analysis.
       for(int x0 = 0; x0 < h; x0++ ) {
 	for(int y0 = 0; y0 < h; y0++ ) {
-	  m_subsample->m_x0 = x0;
-	  m_subsample->m_y0 = y0;
 	  SubsampledChainKey key( h, h, x0, y0 );
-	  SubsampledChain sub_chain;
-	  if ( ! m_transform->apply( sub_chain.subc,
-				     sub_chain.c2subc,
-				     sub_chain.subc2c,
-				     src ) )
-	    cerr << endl 
-		 << "      +--- ERROR at scale " 
-		 << h << ", (" << x0 << "," << y0 << ")" << endl;
-	  // cerr << sub_chain.subc.chain << endl;
-	  m_map[ key ] = sub_chain;
+	  subsample( key, m_map[ key ] );
 	}
       }
     }
@@ -125,16 +188,82 @@ ImaGene::MultiscaleFreemanChain::init( const FreemanChain & src, uint r )
 }
 
 
+/**
+ * Computes one subsampled chain of the source chain given at
+ * 'init', without storing it.
+ *
+ * @param key the key describing resolution and shifts.
+ *
+ * @param sub (returns) the subsampled chain and its mappings. Its
+ * buffers are reused, so that generating the chains one after
+ * the other into the same object allocates little memory.
+ *
+ * @return 'true' if the subsampling succeeded. Otherwise, [sub]
+ * is the same as the one stored by 'init' for this key.
+ */
+bool
+ImaGene::MultiscaleFreemanChain::subsample
+( const SubsampledChainKey & key, SubsampledChain & sub ) const
+{
+  // A failed transform may leave [sub] untouched: starts from an
+  // empty chain, as a newly created one.
+  sub.subc.chain.clear();
+  sub.subc.x0 = 0;
+  sub.subc.y0 = 0;
+  sub.c2subc.clear();
+  sub.subc2c.clear();
+  m_subsample->m_h = key.h;
+  m_subsample->m_v = key.v;
+  m_subsample->m_x0 = key.x0;
+  m_subsample->m_y0 = key.y0;
+  if ( ! m_transform->apply( sub.subc, sub.c2subc, sub.subc2c, *m_src ) )
+    {
+      cerr << endl 
+	   << "      +--- ERROR at scale " 
+	   << key.h << ", (" << key.x0 << "," << key.y0 << ")" << endl;
+      return false;
+    }
+  return true;
+}
+
+
+/**
+ * In on-demand mode, computes the subsampled chain of key [key]
+ * into [m_current], unless it is already there.
+ *
+ * @return a pointer to [m_current], or 0 if [key] is not one of
+ * the resolutions and shifts given at 'init'.
+ */
+ImaGene::MultiscaleFreemanChain::SubsampledChain* 
+ImaGene::MultiscaleFreemanChain::getOnDemand
+( const MultiscaleFreemanChain::SubsampledChainKey & key ) const
+{
+  if ( ( key.h < 1 ) || ( key.h > m_r ) || ( key.v != key.h )
+       || ( key.x0 < 0 ) || ( key.x0 >= (int) key.h )
+       || ( key.y0 < 0 ) || ( key.y0 >= (int) key.v ) )
+    return 0;
+  if ( ( key < m_current_key ) || ( m_current_key < key ) )
+    {
+      subsample( key, m_current );
+      m_current_key = key;
+    }
+  return &m_current;
+}
+
+
 /**
  * @param key the key describing resolution and shifts.
  *
  * @return a pointer to the corresponding structure storing the
- * subsampled chain, or 0 if no one was found.
+ * subsampled chain, or 0 if no one was found. In on-demand mode,
+ * the pointed chain is only valid until the next call to 'get'
+ * with another key.
  */
 const ImaGene::MultiscaleFreemanChain::SubsampledChain* 
 ImaGene::MultiscaleFreemanChain::get
 ( const MultiscaleFreemanChain::SubsampledChainKey & key ) const
 {
+  if ( m_on_demand ) return getOnDemand( key );
   std::map< SubsampledChainKey, SubsampledChain >::const_iterator it;
   it = m_map.find( key );
   if ( it == m_map.end() ) return 0;
@@ -147,12 +276,15 @@ ImaGene::MultiscaleFreemanChain::get
  * @param key the key describing resolution and shifts.
  *
  * @return a pointer to the corresponding structure storing the
- * subsampled chain, or 0 if no one was found.
+ * subsampled chain, or 0 if no one was found. In on-demand mode,
+ * the pointed chain is only valid until the next call to 'get'
+ * with another key.
  */
 ImaGene::MultiscaleFreemanChain::SubsampledChain* 
 ImaGene::MultiscaleFreemanChain::get
 ( const MultiscaleFreemanChain::SubsampledChainKey & key )
 {
+  if ( m_on_demand ) return getOnDemand( key );
   std::map< SubsampledChainKey, SubsampledChain >::iterator it;
   it = m_map.find( key );
   if ( it == m_map.end() ) return 0;
@@ -218,6 +350,206 @@ ImaGene::MultiscaleFreemanChain::getStatsMaximalSegments( FreemanChain & fc )
 }
 
 
+/**
+ * Same statistics as getStatsMaximalSegments( FreemanChain & ),
+ * bit for bit, computed directly on the codes of [fc]: neither
+ * a digital space nor iterators nor a Statistics object are
+ * allocated, and [fc] is left untouched.
+ *
+ * @param fc the freeman chain code of the (closed) contour.
+ *
+ * @param stats (returns) the length statistics of maximal
+ * segments for each surfel of [fc]. If the contour has at most
+ * one maximal segment, all statistics are zero, as in the
+ * non-terminated Statistics object.
+ */
+void
+ImaGene::MultiscaleFreemanChain::getStatsMaximalSegments
+( const FreemanChain & fc, MaximalSegmentStats & stats )
+{
+  stats.ms_back.clear();
+  stats.ms_front.clear();
+  stats.ms_size.clear();
+  if ( fc.chain.empty() )
+    { // e.g. failed subsampling: one surfel without maximal segment.
+      stats.samples.assign( 1, 0 );
+      stats.mean.assign( 1, 0.0 );
+      stats.max.assign( 1, 0.0 );
+      return;
+    }
+  FreemanCodeIterator it( fc.chain, fc.isClosed() != 0 );
+
+  // Number of surfels, as C4CIterator::size.
+  bool is_open = false;
+  uint nb_surfels = 0;
+  FreemanCodeIterator it2 = it;
+  do
+    {
+      if ( it2.next() == 0 )
+	{
+	  is_open = true;
+	  break;
+	}
+      ++nb_surfels;
+    }
+  while ( ! it.equals( it2 ) );
+  if ( is_open )
+    {
+      while ( it.previous() != 0 ) ++nb_surfels;
+      ++nb_surfels;
+    }
+  stats.samples.assign( nb_surfels, 0 );
+  stats.mean.assign( nb_surfels, 0.0 );
+  stats.max.assign( nb_surfels, 0.0 );
+
+  // Tangential cover, as C4CTangentialCover::init. Starts with the
+  // maximal back tangent (C4CGeometry::maximalBackTangent).
+  Mathutils::ModuloComputer mc( nb_surfels );
+  FreemanCodeIterator itcur = it;
+  FreemanCodeIterator itfwd = it;
+  FreemanCodeIterator itbwd = it;
+  C4CSegment dsscur;
+  dsscur.init();
+  while ( true )
+    {
+      uint code = itbwd.previous();
+      if ( dsscur.extendsBack( code ) != 0 )
+	{
+	  if ( code != 0 ) itbwd.next();
+	  break;
+	}
+    }
+  while ( true )
+    {
+      uint code = itfwd.next();
+      if ( dsscur.extendsFront( code ) != 0 )
+	{
+	  if ( code != 0 ) itfwd.previous();
+	  break;
+	}
+    }
+  FreemanCodeIterator itloop = itfwd;
+
+  int idxcur = 0;
+  int idxback = dsscur.relIndex( dsscur.c_n() );
+  int idxfront = dsscur.relIndex( dsscur.cp_n() ) - 1;
+  do
+    {
+      while ( idxcur != idxfront )
+	{
+	  dsscur.slidesForward( itcur.next() );
+	  ++idxcur;
+	}
+      stats.ms_back.push_back( mc.cast( idxback ) );
+      stats.ms_front.push_back( mc.cast( idxfront ) );
+      stats.ms_size.push_back( dsscur.size() );
+
+      uint code_front = itfwd.next();
+      if ( code_front != 0 )
+	{
+	  do
+	    {
+	      dsscur.retractsBack( itbwd.next() );
+	      ++idxback;
+	    }
+	  while ( dsscur.extendsFront( code_front ) != 0 );
+	  ++idxfront;
+	  while ( ( code_front = itfwd.next() ) != 0 )
+	    if ( dsscur.extendsFront( code_front ) == 0 )
+	      ++idxfront;
+	    else
+	      break;
+	  if ( code_front == 0 )
+	    continue;
+	  else
+	    itfwd.previous();
+	}
+      else
+	break;
+    }
+  while ( ! itloop.equals( itfwd ) );
+
+  uint nb_ms = stats.ms_size.size();
+  if ( nb_ms <= 1 )
+    return;
+
+  // Maximal segments of the first surfel, as C4CTangentialCover::beginSMS.
+  Mathutils::ModuloComputer mcb( is_open ? UINT_MAX : nb_surfels );
+  uint idx = 0;
+  uint lo = 0;
+  uint hi = nb_ms - 1;
+  uint cur = 0;
+  while ( true )
+    {
+      if ( mcb.less( idx, stats.ms_back[ cur ] ) )
+	{
+	  hi = cur - 1;
+	  cur = ( lo + hi ) / 2;
+	}
+      else if ( mcb.less( stats.ms_front[ cur ], idx ) )
+	{
+	  lo = cur + 1;
+	  cur = ( lo + hi ) / 2;
+	}
+      else break;
+    }
+  uint begin_ms = 0;
+  lo = cur;
+  if ( lo != 0 )
+    {
+      while ( ! mcb.less( stats.ms_front[ --lo ], idx ) )
+	;
+      begin_ms = lo + 1;
+    }
+  hi = cur;
+  do
+    {
+      ++hi;
+      if ( hi == nb_ms )
+	{
+	  if ( is_open )
+	    {
+	      --hi;
+	      break;
+	    }
+	  hi = 0;
+	  idx -= nb_surfels;
+	}
+    }
+  while ( ! mcb.less( idx, stats.ms_back[ hi ] ) );
+  uint end_ms = hi;
+
+  // Walks the surfels, as C4CTangentialCover::nextSMS, and
+  // accumulates as Statistics::addValue and Statistics::terminate.
+  Mathutils::ModuloComputer msmc( nb_ms );
+  Mathutils::ModuloComputer sc( nb_surfels );
+  uint idx_surfel = 0;
+  do
+    {
+      for ( uint idx_ms = begin_ms; idx_ms != end_ms; 
+	    msmc.increment( idx_ms ) )
+	{
+	  double v = (double) stats.ms_size[ idx_ms ] - 1.0;
+	  stats.mean[ idx_surfel ] += v;
+	  if ( ++stats.samples[ idx_surfel ] == 1 )
+	    stats.max[ idx_surfel ] = v;
+	  else if ( v > stats.max[ idx_surfel ] )
+	    stats.max[ idx_surfel ] = v;
+	}
+      if ( ( idx_surfel == nb_surfels - 1 ) && is_open )
+	break;
+      if ( stats.ms_front[ begin_ms ] == idx_surfel )
+	msmc.increment( begin_ms );
+      sc.increment( idx_surfel );
+      if ( stats.ms_back[ end_ms ] == idx_surfel )
+	msmc.increment( end_ms );
+    }
+  while ( idx_surfel != 0 );
+  for ( uint k = 0; k < nb_surfels; ++k )
+    stats.mean[ k ] /= stats.samples[ k ];
+}
+
+
 
 ///////////////////////////////////////////////////////////////////////////////
 // Interface - public :
@@ -205,14 +205,34 @@ Kn_size
 Bitset1::nbElements() const
 {
   Kn_size nb = 0;
-  const uint8* byte_ptr = (const uint8*) data();
-  const uint8* end_ptr = (const uint8*) ( data() + nbWords() );
-
-  while ( byte_ptr < end_ptr )
+  _ro_word_ptr ptr = m_data;
+  _ro_word_ptr end_ptr = m_data + m_nb_words;
+#if defined(__SSE2__)
+  // 128 bits at a time: bits are summed within each byte, then the
+  // bytes are summed in 64-bit lanes.
+  const __m128i m1 = _mm_set1_epi8( 0x55 );
+  const __m128i m2 = _mm_set1_epi8( 0x33 );
+  const __m128i m4 = _mm_set1_epi8( 0x0f );
+  const __m128i zero = _mm_setzero_si128();
+  __m128i acc = zero;
+  for ( ; end_ptr - ptr >= 4; ptr += 4 )
     {
-      nb += KnUtils::countSetBits( *byte_ptr );
-      ++byte_ptr;
+      __m128i v = _mm_loadu_si128( (const __m128i*) ptr );
+      v = _mm_sub_epi8( v, _mm_and_si128( _mm_srli_epi64( v, 1 ), m1 ) );
+      v = _mm_add_epi8( _mm_and_si128( v, m2 ),
+			_mm_and_si128( _mm_srli_epi64( v, 2 ), m2 ) );
+      v = _mm_and_si128( _mm_add_epi8( v, _mm_srli_epi64( v, 4 ) ), m4 );
+      acc = _mm_add_epi64( acc, _mm_sad_epu8( v, zero ) );
     }
+  uint64 lanes[ 2 ];
+  _mm_storeu_si128( (__m128i*) lanes, acc );
+  nb += lanes[ 0 ] + lanes[ 1 ];
+#endif
+  // 64 bits at a time.
+  for ( ; end_ptr - ptr >= 2; ptr += 2 )
+    nb += KnUtils::countSetBits( ( ( (uint64) ptr[ 1 ] ) << 32 ) | ptr[ 0 ] );
+  if ( ptr != end_ptr )
+    nb += KnUtils::countSetBits( *ptr );
   return nb;
 }
 
@@ -227,24 +247,13 @@ Bitset1::nbElements() const
 Kn_size 
 Bitset1::findFirst( Kn_size not_found ) const
 {
-  for ( Kn_size i = 0; i < m_nb_words; ++i )
-    {
-      _word w = m_data[ i ];
-      if ( w != _W_ZERO )
-	{
-	  // find byte within word
-	  for ( uint j = 0; j < sizeof( _word ); ++j )
-	    {
-	      uint8 b = static_cast<uint8>( w & (~(uint8)0));
-	      if ( b )
-		return _W_POSFROMWORD( i ) + ( j << 3 )
-		  + KnUtils::getLSB( b );
-	      w >>= 8;
-	    }
-	}
-    }
-  // not found, so return an indication of failure.
-  return not_found;
+  _ro_word_ptr end_ptr = m_data + m_nb_words;
+  _ro_word_ptr ptr = doWordFindNonZero( m_data, end_ptr );
+  if ( ptr == end_ptr )
+    // not found, so return an indication of failure.
+    return not_found;
+  Kn_size i = ptr - m_data;
+  return _W_POSFROMWORD( i ) + KnUtils::getLSB( *ptr );
 }
 
 /**
@@ -260,48 +269,22 @@ Bitset1::findNext( Kn_size prev, Kn_size not_found ) const
   // check out of bounds
   if ( prev >= m_size ) return not_found;
 
-  // search first word
+  // search first word, masking off bits below bound
   Kn_size i = _W_WHICHWORD( prev );
-  _word w = m_data[ i ];
-
-  // mask off bits below bound
-  w &= (~ _W_ZERO ) << _W_WHICHBIT( prev );
-
-  if ( w != _W_ZERO ) 
-    {
-      // find byte within word
-      // get first byte into place
-      w >>= _W_WHICHBYTE( prev ) * 8;
-      for ( uint j = _W_WHICHBYTE( prev ); j < sizeof(_word ); ++j )
-	{
-	  uint8 b = static_cast<uint8>( w & (~(uint8)0));
-	  if ( b )
-	    return _W_POSFROMWORD( i ) + ( j << 3 )
-	      + KnUtils::getLSB( b );
-	  w >>= 8;
-	}
-    }
+  _word w = m_data[ i ] & _W_MASKGEBITS( prev );
 
-  // check subsequent words
-  ++i;
-  for ( ; i < m_nb_words; ++i )
+  // skip subsequent zero words
+  if ( w == _W_ZERO )
     {
-      _word w = m_data[ i ];
-      if ( w != _W_ZERO )
-	{
-	  // find byte within word
-	  for ( uint j = 0; j < sizeof( _word ); ++j )
-	    {
-	      uint8 b = static_cast<uint8>( w & (~(uint8)0));
-	      if ( b )
-		return _W_POSFROMWORD( i ) + ( j << 3 )
-		  + KnUtils::getLSB( b );
-	      w >>= 8;
-	    }
-	}
+      _ro_word_ptr end_ptr = m_data + m_nb_words;
+      _ro_word_ptr ptr = doWordFindNonZero( m_data + i + 1, end_ptr );
+      if ( ptr == end_ptr )
+	// not found, so return an indication of failure.
+	return not_found;
+      i = ptr - m_data;
+      w = *ptr;
     }
-  // not found, so return an indication of failure.
-  return not_found;
+  return _W_POSFROMWORD( i ) + KnUtils::getLSB( w );
 }
 
 
@@ -532,6 +532,110 @@ ImaGene::LinearMinimizerByRelaxation::lastDelta() const
 
 
 
+/**
+ * Relaxes the values [i1] included to [i2] excluded. The whole
+ * contour (i1 == i2) is relaxed in parallel.
+ *
+ * @param i1 the first value to be optimized (between 0 and 'size()-1').
+ * @param i2 the value after the last to be optimized (between 0 and 'size()-1').
+ * @return the sum of the displacements.
+ */
+double
+ImaGene::LinearMinimizerByRedBlackRelaxation::optimize( uint i1, uint i2 )
+{
+  if ( i1 != i2 )
+    return LinearMinimizer::optimize( i1, i2 );
+
+  ASSERT_LinearMinimizer( size() > 2 );
+
+  int n = size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for ( int i = 0; i < n; ++i )
+    {
+      ValueInfo & vi = this->rw( i );
+      vi.old_value = vi.value;
+    }
+  m_sum = 0.0;
+  m_max = 0.0;
+  // On a closed contour with an odd number of values, the last value
+  // and the first one are both even neighbors.
+  uint last_even = ( ! m_is_curve_open && ( n % 2 == 1 ) ) ? n - 1 : n;
+  relaxEvery2( 0, last_even, m_sum, m_max );
+  relaxEvery2( 1, n, m_sum, m_max );
+  if ( last_even != (uint) n )
+    relaxEvery2( last_even, n, m_sum, m_max );
+  return m_sum;
+}
+
+/**
+ * Relaxes the values [first], [first]+2, ... below [last]
+ * (excluded) between their current neighbors.
+ *
+ * @param first the first value to relax.
+ * @param last the upper bound of the relaxed values.
+ * @param sum (updated) the sum of the displacements.
+ * @param max (updated) the max of the displacements.
+ */
+void
+ImaGene::LinearMinimizerByRedBlackRelaxation::relaxEvery2
+( uint first, uint last, double & sum, double & max )
+{
+  int n = size();
+  int nb = ( last > first ) ? ( last - first + 1 ) / 2 : 0;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    Mathutils::AngleComputer ac;
+    double local_sum = 0.0;
+    double local_max = 0.0;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for ( int k = 0; k < nb; ++k )
+      {
+	int i = first + 2 * k;
+	ValueInfo & vi = this->rw( i );
+	double mid;
+	if ( m_is_curve_open && ( i == ( n - 1 ) ) )
+	  { // free extremity to the front/right.
+	    mid = this->ro( i - 1 ).value;
+	  }
+	else if ( m_is_curve_open && ( i == 0 ) )
+	  { // free extremity to the back/left.
+	    mid = this->ro( 1 ).old_value;
+	  }
+	else
+	  { // standard case.
+	    const ValueInfo & viprev = this->ro( i == 0 ? n - 1 : i - 1 );
+	    const ValueInfo & vinext = this->ro( i == n - 1 ? 0 : i + 1 );
+	    double valp = viprev.value;
+	    double y = ac.deviation( vinext.value, valp );
+	    mid = ( viprev.dist_to_next * y )
+	      / ( vi.dist_to_next + viprev.dist_to_next );
+	    mid = ac.cast( mid + valp );
+	  }
+	if ( ac.less( mid, vi.min ) ) mid = vi.min;
+	if ( ac.less( vi.max, mid ) ) mid = vi.max;
+	vi.value = mid;
+	// Displacement of the step, for the convergence test.
+	double diff = fabs( ac.deviation( mid, vi.old_value ) );
+	if ( diff > local_max ) local_max = diff;
+	local_sum += diff;
+      }
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+    {
+      sum += local_sum;
+      if ( local_max > max ) max = local_max;
+    }
+  }
+}
+
+
 /**
  * The method which performs the optimization effectively. The user
  * may override it. The optimization is performed on values [i1]
@@ -880,6 +984,16 @@ ImaGene::LinearMinimizerByRelaxation::selfDisplay( ostream& that_stream ) const
   that_stream << "[LinearMinimizer::relaxation]";
 }
 
+/**
+ * Writes/Displays the object on an output stream.
+ * @param that_stream the output stream where the object is written.
+ */
+void 
+ImaGene::LinearMinimizerByRedBlackRelaxation::selfDisplay( ostream& that_stream ) const
+{
+  that_stream << "[LinearMinimizer::red-black relaxation]";
+}
+
 /**
  * Writes/Displays the object on an output stream.
  * @param that_stream the output stream where the object is written.
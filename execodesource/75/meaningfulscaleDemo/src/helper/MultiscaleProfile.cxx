@@ -30,6 +30,7 @@
 
 
 ///////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
 #include "ImaGene/mathutils/SimpleLinearRegression.h"
 #include "ImaGene/mathutils/Statistics.h"
 #include "ImaGene/helper/MultiscaleProfile.h"
@@ -75,37 +76,45 @@ ImaGene::MultiscaleProfile::MultiscaleProfile()
  *
  * @param src the source Freeman chain.
  * @param r the maximal resolution.
+ *
+ * @param on_demand when 'true', the subsampled chains are
+ * computed one at a time and not kept (see
+ * MultiscaleFreemanChain::init), and the individual length
+ * samples are not stored either, so that the memory stays linear
+ * in the length of [src]. 'profile', 'meaningfulScales' and
+ * 'noiseLevel' give the same results in both modes, but
+ * 'profileFromMedian' and 'detailedProfile' need the stored
+ * samples of the default mode.
  */
 void
-ImaGene::MultiscaleProfile::init( const FreemanChain & src, uint r )
+ImaGene::MultiscaleProfile::init( const FreemanChain & src, uint r, 
+				  bool on_demand )
 {
-  MultiscaleFreemanChain::init( src, r );
+  MultiscaleFreemanChain::init( src, r, on_demand );
   cerr << "+--- computing length statistics " << flush;
   uint src_size = src.chain.size();
+  // Reused for every subsampled chain.
+  MaximalSegmentStats stats1;
   all_stats.resize( r );
   for( int k = 0; k < r; k++ ) {
     int res = k + 1;
     cerr << "." << res << flush;
     all_stats[ k ].scale = res;
-    all_stats[ k ].stats = new Statistics( src_size, true );
+    all_stats[ k ].stats = new Statistics( src_size, ! on_demand );
     bool first = true;
     for(int x0 = 0; x0 < res; x0++ ) {
       for(int y0 = 0; y0 < res; y0++ ) {	  
 	MultiscaleFreemanChain::SubsampledChainKey key( res, res, x0, y0 );
 	const MultiscaleFreemanChain::SubsampledChain* ptrsub
 	  = get( key );
-	uint size = ptrsub->subc.chain.size();
-	// Computes ms length statistics for one shift. 
-	FreemanChain subc_copy;
-	subc_copy.x0 = ptrsub->subc.x0;
-	subc_copy.y0 = ptrsub->subc.y0;
-	subc_copy.chain = ptrsub->subc.chain;
-	Statistics* stats1 = getStatsMaximalSegments( subc_copy );
+	// Computes ms length statistics for one shift. In on-demand
+	// mode, [ptrsub] is overwritten by the next 'get'.
+	getStatsMaximalSegments( ptrsub->subc, stats1 );
 	// Relates these statistics to surfels on the original contour.
 	for ( uint i = 0; i < src_size; ++i )
 	  {
-	    double mean = stats1->mean( ptrsub->c2subc[ i ] );
-	    double max = stats1->max( ptrsub->c2subc[ i ] );
+	    double mean = stats1.mean[ ptrsub->c2subc[ i ] ];
+	    double max = stats1.max[ ptrsub->c2subc[ i ] ];
 	    all_stats[ k ].stats->addValue( i, mean );
 	    if ( first )
 	      {
@@ -124,7 +133,6 @@ ImaGene::MultiscaleProfile::init( const FreemanChain & src, uint r )
 		    = std::make_pair( key, mean );
 	      }
 	  }
-	delete stats1;
 	first = false;
       }
     }
@@ -275,6 +283,132 @@ ImaGene::MultiscaleProfile::noiseLevel
 
 
 
+/**
+ * Batch version of 'meaningfulScales' for all the surfels. The
+ * abscissae log(scale) are computed once, and the profiles are
+ * read scale after scale for blocks of consecutive surfels, so
+ * that the slopes of a block are computed in tight loops over
+ * contiguous arrays. Blocks are processed in parallel when
+ * OpenMP is available. Gives the same intervals as
+ * 'meaningfulScales' for each surfel.
+ *
+ * @param intervals (returns) for each surfel, its list of
+ * meaningful scales.
+ * @param min_width the minimum length for the meaningful scales.
+ * @param max_slope the maximum allowed slope for length evolution.
+ */
+void
+ImaGene::MultiscaleProfile::allMeaningfulScales
+( std::vector< std::vector< std::pair< uint, uint > > > & intervals,
+  uint min_width,
+  double max_slope ) const
+{
+  batchMeaningfulScales( &intervals, 0, min_width, max_slope );
+}
+
+/**
+ * Batch version of 'noiseLevel' for all the surfels (see
+ * 'allMeaningfulScales').
+ *
+ * @param levels (returns) for each surfel, its noise level or
+ * zero if none was found.
+ * @param min_width the minimum length for the meaningful scales.
+ * @param max_slope the maximum allowed slope for length evolution.
+ */
+void
+ImaGene::MultiscaleProfile::noiseLevels
+( std::vector<uint> & levels,
+  uint min_width,
+  double max_slope ) const
+{
+  batchMeaningfulScales( 0, &levels, min_width, max_slope );
+}
+
+/**
+ * Common part of 'allMeaningfulScales' and 'noiseLevels'. Either
+ * pointer may be 0.
+ */
+void
+ImaGene::MultiscaleProfile::batchMeaningfulScales
+( std::vector< std::vector< std::pair< uint, uint > > >* intervals,
+  std::vector<uint>* levels,
+  uint min_width,
+  double max_slope ) const
+{
+  const uint nb_surfels = m_src != 0 ? m_src->chain.size() : 0;
+  const uint nb_scales = all_stats.size();
+  if ( intervals != 0 )
+    {
+      intervals->clear();
+      intervals->resize( nb_surfels );
+    }
+  if ( levels != 0 )
+    levels->assign( nb_surfels, 0 );
+  if ( nb_scales < 2 ) return;
+
+  // Abscissae of the profiles, and their differences, for all surfels.
+  vector<double> dx( nb_scales );
+  double x_prev = log( all_stats[ 0 ].scale );
+  for ( uint k = 1; k < nb_scales; ++k )
+    {
+      double x = log( all_stats[ k ].scale );
+      dx[ k ] = x - x_prev;
+      x_prev = x;
+    }
+
+  // Surfels are processed by blocks: the profile values of a block at
+  // two consecutive scales stay in cache.
+  const int block_size = 1024;
+  const int nb_blocks = ( nb_surfels + block_size - 1 ) / block_size;
+#ifdef _OPENMP
+#pragma omp parallel
+#endif
+  {
+    vector<double> y_prev( block_size );
+    vector<double> y_cur( block_size );
+    vector<uint> l( block_size );
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic)
+#endif
+    for ( int b = 0; b < nb_blocks; ++b )
+      {
+	const uint begin = b * block_size;
+	const uint size = std::min( (uint) block_size, nb_surfels - begin );
+	const Statistics & stats0 = *all_stats[ 0 ].stats;
+	for ( uint j = 0; j < size; ++j )
+	  {
+	    y_prev[ j ] = log( stats0.mean( begin + j ) );
+	    l[ j ] = 0;
+	  }
+	for ( uint k = 1; k < nb_scales; ++k )
+	  {
+	    const Statistics & stats = *all_stats[ k ].stats;
+	    const bool last = ( k + 1 ) == nb_scales;
+	    for ( uint j = 0; j < size; ++j )
+	      y_cur[ j ] = log( stats.mean( begin + j ) );
+	    for ( uint j = 0; j < size; ++j )
+	      {
+		double slope = ( y_cur[ j ] - y_prev[ j ] ) / dx[ k ];
+		if ( ( slope > max_slope ) || last )
+		  {
+		    if ( ( k - 1 - l[ j ] ) >= min_width )
+		      {
+			if ( intervals != 0 )
+			  (*intervals)[ begin + j ].push_back
+			    ( std::make_pair( l[ j ] + 1, k ) );
+			if ( ( levels != 0 ) && ( (*levels)[ begin + j ] == 0 ) )
+			  (*levels)[ begin + j ] = l[ j ] + 1;
+		      }
+		    l[ j ] = k;
+		  }
+	      }
+	    y_prev.swap( y_cur );
+	  }
+      }
+  }
+}
+
+
 /**
  * Test BK 21/09/09
  *
@@ -125,9 +125,9 @@ ImaGene::Statistics::Statistics( uint size,
   m_unbiased_var = 0;
   m_max = 0;
   m_min = 0;
-  m_values = 0;
   m_indice_max = 0;
   m_indice_min = 0;
+  m_values_sorted = false;
 
   init( size, store_samples );
 
@@ -166,15 +166,83 @@ ImaGene::Statistics::addValue( uint k, double v )
     m_indice_min[k]=m_samples[k]-1;
   }
   if ( m_store_samples )
-    m_values[ k ].push_back( v );
+    {
+      if ( m_values_sorted ) unsortValues();
+      m_values.push_back( v );
+      m_values_var.push_back( k );
+    }
+}
+
+/**
+ * Adds all the sample values of [other] to this object, as if
+ * they had been given with 'addValue' after the ones of this
+ * object. Both objects should have the same number of variables
+ * and store their samples or not alike, and 'terminate' should
+ * not have been called on any of them. Only sums, extrema and
+ * the stored values are concatenated, so that several objects
+ * filled in parallel are cheaply gathered into one. The stored
+ * values are then sorted by variable, as by 'terminate'.
+ *
+ * @param other any object filled with the same variables.
+ */
+void
+ImaGene::Statistics::merge( const Statistics & other )
+{
+  ASSERT_Statistics( ( other.m_nb == m_nb )
+		     && ( other.m_store_samples == m_store_samples ) );
+  for ( uint k = 0; k < m_nb; ++k )
+    {
+      if ( other.m_samples[ k ] == 0 ) continue;
+      if ( m_samples[ k ] == 0 )
+	{
+	  m_max[ k ] = other.m_max[ k ];
+	  m_min[ k ] = other.m_min[ k ];
+	  m_indice_max[ k ] = other.m_indice_max[ k ];
+	  m_indice_min[ k ] = other.m_indice_min[ k ];
+	}
+      else
+	{
+	  if ( other.m_max[ k ] > m_max[ k ] )
+	    {
+	      m_max[ k ] = other.m_max[ k ];
+	      m_indice_max[ k ] = m_samples[ k ] + other.m_indice_max[ k ];
+	    }
+	  if ( other.m_min[ k ] < m_min[ k ] )
+	    {
+	      m_min[ k ] = other.m_min[ k ];
+	      m_indice_min[ k ] = m_samples[ k ] + other.m_indice_min[ k ];
+	    }
+	}
+      m_samples[ k ] += other.m_samples[ k ];
+      m_exp[ k ] += other.m_exp[ k ];
+      m_exp2[ k ] += other.m_exp2[ k ];
+    }
+  if ( m_store_samples && ! other.m_values.empty() )
+    {
+      if ( m_values_sorted ) unsortValues();
+      m_values.insert( m_values.end(), 
+		       other.m_values.begin(), other.m_values.end() );
+      if ( ! other.m_values_sorted )
+	m_values_var.insert( m_values_var.end(),
+			     other.m_values_var.begin(), 
+			     other.m_values_var.end() );
+      else
+	for ( uint k = 0; k < m_nb; ++k )
+	  m_values_var.insert( m_values_var.end(), 
+			       other.m_values_offset[ k + 1 ] 
+			       - other.m_values_offset[ k ], k );
+    }
+  if ( m_store_samples && ! m_values_sorted )
+    sortValues();
 }
   
 /** 
  * Once all sample values have been added to this object, computes
  * meaningful statistics like sample mean, variance and unbiased
- * variance.
+ * variance, and sorts the stored values by variable so that
+ * 'value' can read them.
  * 
- * @see mean, variance, unbiasedVariance, min, max
+ * @see mean, variance, unbiasedVariance, min, max, value
  */
 void 
 ImaGene::Statistics::terminate()
@@ -187,6 +255,8 @@ ImaGene::Statistics::terminate()
       m_unbiased_var[ k ] = m_samples[ k ] * m_var[ k ] 
 	/ ( m_samples[ k ] - 1 );
     }
+  if ( m_store_samples && ! m_values_sorted )
+    sortValues();
 }
 
 
@@ -219,8 +289,6 @@ ImaGene::Statistics::init( uint size, bool store_samples )
   m_indice_max = new uint[ size ];
   m_indice_min = new uint[ size ];
   m_store_samples = store_samples;
-  if ( m_store_samples )
-    m_values = new vector<double>[ size ];
   clear();
 }
 
@@ -245,12 +313,11 @@ ImaGene::Statistics::clear()
       m_min[ i ] = 0.0;
       m_indice_min[ i ] = 0;
       m_indice_max[ i ] = 0;
-      
-      if ( m_store_samples ) {
-	m_values[ i ].clear();
-	m_values[ i ].reserve( 128 );
-      }
     }
+  m_values.clear();
+  m_values_var.clear();
+  m_values_offset.clear();
+  m_values_sorted = false;
 }
   
 
@@ -272,7 +339,6 @@ ImaGene::Statistics::erase()
   if ( m_min != 0 ) delete[] m_min;
   if ( m_indice_max != 0 ) delete[] m_indice_max;
   if ( m_indice_min != 0 ) delete[] m_indice_min;
-  if ( m_values != 0 ) delete[] m_values;
 
   m_samples = 0;
   m_exp = 0;
@@ -284,7 +350,10 @@ ImaGene::Statistics::erase()
   m_max = 0;
   m_indice_min = 0;
   m_indice_max = 0;  
-  m_values = 0;
+  vector<double>().swap( m_values );
+  vector<uint>().swap( m_values_var );
+  vector<uint>().swap( m_values_offset );
+  m_values_sorted = false;
  
   m_store_samples = false;
 }
@@ -370,11 +439,12 @@ ImaGene::Statistics::linearRegression( uint x, uint y ) const
 double
 ImaGene::Statistics::median( uint k ) 
 {
-  ASSERT_Statistics( m_store_samples );
-  
-  nth_element( m_values[ k ].begin(), m_values[ k ].begin()+(m_values[k].size()/2), 
-	       m_values[ k ].end());
-  return *(m_values[ k ].begin()+(m_values[k].size()/2));
+  ASSERT_Statistics( m_store_samples && ( k < m_nb ) );
+  if ( ! m_values_sorted ) sortValues();
+  vector<double>::iterator b = m_values.begin() + m_values_offset[ k ];
+  vector<double>::iterator e = m_values.begin() + m_values_offset[ k + 1 ];
+  nth_element( b, b + ( e - b ) / 2, e );
+  return *( b + ( e - b ) / 2 );
 }
 
 
@@ -409,5 +479,41 @@ ImaGene::Statistics::OK() const
 ///////////////////////////////////////////////////////////////////////////////
 // Internals - private :
 
+/**
+ * Sorts the stored values by variable (keeping their order within
+ * a variable) so that the values of each variable are contiguous,
+ * and frees [m_values_var]. Only one pass of counting sort.
+ */
+void
+ImaGene::Statistics::sortValues()
+{
+  m_values_offset.assign( m_nb + 1, 0 );
+  for ( uint j = 0; j < m_values_var.size(); ++j )
+    ++m_values_offset[ m_values_var[ j ] + 1 ];
+  for ( uint k = 0; k < m_nb; ++k )
+    m_values_offset[ k + 1 ] += m_values_offset[ k ];
+  vector<uint> pos( m_values_offset.begin(), m_values_offset.end() - 1 );
+  vector<double> sorted( m_values.size() );
+  for ( uint j = 0; j < m_values_var.size(); ++j )
+    sorted[ pos[ m_values_var[ j ] ]++ ] = m_values[ j ];
+  m_values.swap( sorted );
+  vector<uint>().swap( m_values_var );
+  m_values_sorted = true;
+}
+
+/**
+ * Undoes 'sortValues' so that new values can be appended: builds
+ * again the variable of each stored value.
+ */
+void
+ImaGene::Statistics::unsortValues()
+{
+  m_values_var.resize( m_values.size() );
+  for ( uint k = 0; k < m_nb; ++k )
+    for ( uint j = m_values_offset[ k ]; j != m_values_offset[ k + 1 ]; ++j )
+      m_values_var[ j ] = k;
+  m_values_sorted = false;
+}
+
 //                                                                           //
 ///////////////////////////////////////////////////////////////////////////////
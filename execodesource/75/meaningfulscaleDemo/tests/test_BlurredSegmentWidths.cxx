@@ -0,0 +1,140 @@
+///////////////////////////////////////////////////////////////////////////////
+// Test the multi-width computation of the blurred segment lengths
+// against the computation width after width.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "ImaGene/base/Arguments.h"
+#include "ImaGene/base/StandardArguments.h"
+#include "ImaGene/base/Vector.h"
+#include "ImaGene/mathutils/Statistics.h"
+#include "ImaGene/timetools/Clock.h"
+#include "ImaGene/dgeometry2d/FreemanChain.h"
+#include "ImaGene/dgeometry2d/BlurredSegmentTgtCover.h"
+#include "ImaGene/helper/ScaleProfile.h"
+
+
+using namespace std;
+using namespace ImaGene;
+
+
+static Arguments args;
+
+/**
+ * @return 'true' if both doubles have the same bits (so that NaN
+ * values compare equal).
+ */
+static bool
+sameBits( double a, double b )
+{
+  return memcmp( &a, &b, sizeof( double ) ) == 0;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//
+// M A I N
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char** argv )
+{
+  // -------------------------------------------------------------------------
+  // Prepare arguments.
+  StandardArguments::addIOArgs( args, true, false );
+  args.addOption( "-widths", "-widths <max> <step>: the widths of the blurred segments are 1, 1+step, ... up to max.", "5", "1" );
+  args.addOption( "-meaningfulScales", "-meaningfulScales <min_size> <max_slope>: parameters of the meaningful scales.", "1", "-0.0" );
+
+  if ( ( argc <= 0 )
+       || ! args.readArguments( argc, argv ) )
+    {
+      cerr << args.usage( "test_BlurredSegmentWidths",
+			  "Checks that the mean lengths of blurred segments computed for all widths at once, and the noise levels and scale profiles deduced from them, are identical to the ones computed width after width."
+			  ,"" ) << endl;
+      return 1;
+    }
+
+  double widthMax = args.getOption( "-widths" )->getDoubleValue( 0 );
+  double widthStep = args.getOption( "-widths" )->getDoubleValue( 1 );
+  uint mscales_min_size = args.getOption( "-meaningfulScales" )->getIntValue( 0 );
+  double mscales_max_slope = args.getOption( "-meaningfulScales" )->getDoubleValue( 1 );
+
+  // -------------------------------------------------------------------------
+  // Read Freeman chain.
+  FreemanChain c;
+  istream & in_str = StandardArguments::openInput( args );
+  FreemanChain::read( in_str, c );
+  if ( ! in_str.good() )
+    {
+      cerr << "Error reading Freeman chain code." << endl;
+      return 2;
+    }
+  vector<Vector2D> contour;
+  for ( FreemanChain::const_iterator it = c.begin(); it != c.end(); ++it )
+    contour.push_back( Vector2D( (*it).x(), (*it).y() ) );
+
+  vector<double> widths;
+  for ( double w = 1.0; w <= widthMax; w += widthStep )
+    widths.push_back( w );
+
+  // -------------------------------------------------------------------------
+  // Width after width.
+  BlurredSegmentTgtCover ref;
+  ref.init( contour, true );
+  Clock::startClock();
+  vector<Statistics*> ref_stats;
+  for ( uint j = 0; j < widths.size(); ++j )
+    ref_stats.push_back( ref.getStatsMaximalSegments( widths[ j ] ) );
+  long t_ref = Clock::stopClock();
+
+  // -------------------------------------------------------------------------
+  // All widths at once.
+  BlurredSegmentTgtCover tgc;
+  tgc.init( contour, true );
+  Clock::startClock();
+  const vector< vector<double> > & means
+    = tgc.getMeanLengthsMaximalSegments( widths );
+  long t_multi = Clock::stopClock();
+
+  uint errors = means.size() == widths.size() ? 0 : 1;
+  for ( uint j = 0; ( j < widths.size() ) && ( j < means.size() ); ++j )
+    for ( uint i = 0; i < contour.size(); ++i )
+      if ( ! sameBits( means[ j ][ i ], ref_stats[ j ]->mean( i ) ) )
+	++errors;
+
+  // Noise levels and profiles use the cached lengths.
+  Clock::startClock();
+  vector<double> noiseLevels =
+    tgc.getNoiseLevels( widths, mscales_min_size, mscales_max_slope );
+  for ( uint i = 0; i < contour.size(); ++i )
+    {
+      ScaleProfile sp, ref_sp;
+      tgc.getScaleProfile( widths, i, sp );
+      ref_sp.init( widths.size() );
+      for ( uint j = 0; j < widths.size(); ++j )
+	ref_sp.addValue( j, ref_stats[ j ]->mean( i ) / widths[ j ] );
+      vector<double> x, y, ref_x, ref_y;
+      sp.getProfile( x, y );
+      ref_sp.getProfile( ref_x, ref_y );
+      if ( ( x != ref_x ) || ( y != ref_y )
+	   || ( noiseLevels[ i ]
+		!= ref_sp.noiseLevel( mscales_min_size, mscales_max_slope ) ) )
+	++errors;
+    }
+  long t_profiles = Clock::stopClock();
+
+  for ( uint j = 0; j < ref_stats.size(); ++j )
+    delete ref_stats[ j ];
+
+  cout << "# " << contour.size() << " points, " << widths.size()
+       << " widths, " << errors << " errors." << endl
+       << "# width after width " << t_ref << " ms, all widths "
+       << t_multi << " ms, noise levels and all profiles (cached) "
+       << t_profiles << " ms." << endl;
+  return errors == 0 ? 0 : 1;
+}
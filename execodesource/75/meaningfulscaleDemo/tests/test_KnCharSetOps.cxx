@@ -0,0 +1,176 @@
+///////////////////////////////////////////////////////////////////////////////
+// Benchmark of the set operations and of the iteration of KnCharSet
+// on the 3D shapes of gen3dShapes, checked bit by bit.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include "ImaGene/base/Arguments.h"
+#include "ImaGene/base/StandardArguments.h"
+#include "ImaGene/timetools/Clock.h"
+#include "ImaGene/digitalnD/KnSpace.h"
+#include "ImaGene/digitalnD/KnCharSet.h"
+#include "ImaGene/digitalnD/KnShapes.h"
+#include "ImaGene/helper/ShapeHelper.h"
+
+
+using namespace std;
+using namespace ImaGene;
+
+
+static Arguments args;
+
+/**
+ * @return a sphere of spels of [ks] of radius [r], whose center is at
+ * [x],[y],[z] times the sizes of [ks].
+ */
+static KnCharSet
+makeSphere( const KnSpace & ks, float x, float y, float z, float r )
+{
+  Kn_size center[ 3 ];
+  center[ 0 ] = 2 * (Kn_size) ( x * ks.size( 0 ) ) + 1;
+  center[ 1 ] = 2 * (Kn_size) ( y * ks.size( 1 ) ) + 1;
+  center[ 2 ] = 2 * (Kn_size) ( z * ks.size( 2 ) ) + 1;
+  return KnShapes::umakeVolumicSphere( ks, ks.ukcode( center ), r );
+}
+
+/**
+ * @return the number of cells of [s] visited by its cell_iterator.
+ */
+static Kn_size
+countByIteration( const KnCharSet & s )
+{
+  Kn_size nb = 0;
+  for ( KnCharSet::cell_iterator it = s.begin(), it_end = s.end();
+	it != it_end; ++it )
+    ++nb;
+  return nb;
+}
+
+/**
+ * @return the number of errors of the iteration of [s]: visited
+ * cells which are not in [s], and cells of [s] which are not
+ * visited.
+ */
+static uint
+checkIteration( const KnCharSet & s )
+{
+  uint errors = 0;
+  Kn_gid c = s.min();
+  for ( KnCharSet::cell_iterator it = s.begin(), it_end = s.end();
+	it != it_end; ++it )
+    {
+      for ( ; c < *it; ++c )
+	if ( s.at( c ) ) ++errors;
+      if ( ! s.at( c ) ) ++errors;
+      ++c;
+    }
+  for ( ; c <= s.max(); ++c )
+    if ( s.at( c ) ) ++errors;
+  return errors;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//
+// M A I N
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char** argv )
+{
+  // -------------------------------------------------------------------------
+  // Prepare arguments.
+  StandardArguments::addDigitalArgs( args, 3, false, false );
+  ShapeHelper::addSimple3DShapesArgs( args );
+  args.addOption( "-nbIter", "-nbIter <n>: number of times each operation is timed.", "10" );
+
+  if ( ( argc <= 1 )
+       || ! args.readArguments( argc, argv ) )
+    {
+      cerr << args.usage( "test_KnCharSetOps",
+			  "Builds a shape of gen3dShapes, a sphere overlapping it and a small sphere, times the union, intersection, difference, complement, counting and iteration of these sets of spels, and checks them bit by bit. Example: test_KnCharSetOps -d 3 -x 128 -y 128 -z 128 -cms 80 50"
+			  ,"" ) << endl;
+      return 1;
+    }
+  if ( StandardArguments::dim( args ) != 3 )
+    {
+      cerr << "Dimension should be 3." << endl;
+      return 2;
+    }
+  uint nb_iter = args.getOption( "-nbIter" )->getIntValue( 0 );
+
+  // -------------------------------------------------------------------------
+  // Build space and shapes.
+  Kn_size sizes[ 3 ];
+  StandardArguments::fillSizes( args, sizes );
+  KnSpace ks( 3, sizes );
+  KnCharSet A = ShapeHelper::makeSimple3DShapesFromArgs( args, ks );
+  KnCharSet B = makeSphere( ks, 0.6, 0.55, 0.5, 0.3 * ks.size( 0 ) );
+  KnCharSet C = makeSphere( ks, 0.3, 0.3, 0.3, 0.05 * ks.size( 0 ) );
+
+  // -------------------------------------------------------------------------
+  // Times the operations.
+  KnCharSet U( A ), I( A ), D( A ), N( A );
+  Kn_size nbA = 0, nbA_it = 0, nbC_it = 0;
+  Clock::startClock();
+  for ( uint i = 0; i < nb_iter; ++i ) U = A + B;
+  long t_union = Clock::stopClock();
+  Clock::startClock();
+  for ( uint i = 0; i < nb_iter; ++i ) I = A * B;
+  long t_inter = Clock::stopClock();
+  Clock::startClock();
+  for ( uint i = 0; i < nb_iter; ++i ) D = A - B;
+  long t_diff = Clock::stopClock();
+  Clock::startClock();
+  for ( uint i = 0; i < nb_iter; ++i ) N = ~A;
+  long t_compl = Clock::stopClock();
+  Clock::startClock();
+  for ( uint i = 0; i < nb_iter; ++i ) nbA = A.nbElements();
+  long t_count = Clock::stopClock();
+  Clock::startClock();
+  for ( uint i = 0; i < nb_iter; ++i ) nbA_it = countByIteration( A );
+  long t_iter = Clock::stopClock();
+  Clock::startClock();
+  for ( uint i = 0; i < nb_iter; ++i ) nbC_it = countByIteration( C );
+  long t_iter_sparse = Clock::stopClock();
+
+  // -------------------------------------------------------------------------
+  // Checks them bit by bit.
+  uint errors = 0;
+  Kn_size nbA_ref = 0;
+  Kn_size nbN = 0;
+  for ( Kn_gid c = A.min(); c <= A.max(); ++c )
+    {
+      bool a = A.at( c );
+      bool b = B.at( c );
+      if ( a ) ++nbA_ref;
+      if ( ( U.at( c ) != ( a || b ) )
+	   || ( I.at( c ) != ( a && b ) )
+	   || ( D.at( c ) != ( a && ! b ) ) )
+	++errors;
+      // The complement only contains spels.
+      if ( N.at( c ) )
+	{
+	  ++nbN;
+	  if ( a || ( ks.udim( c ) != 3 ) ) ++errors;
+	}
+    }
+  if ( ( nbA != nbA_ref ) || ( nbA_it != nbA_ref )
+       || ( nbC_it != C.nbElements() )
+       || ( nbN + nbA_ref != ks.nbCells( 3 ) ) )
+    ++errors;
+  errors += checkIteration( A ) + checkIteration( C ) + checkIteration( D );
+
+  cout << "# " << nbA_ref << " spels in shape, " << C.nbElements()
+       << " in small sphere, " << A.max() - A.min() + 1 << " bits, "
+       << errors << " errors." << endl
+       << "# " << nb_iter << " times: union " << t_union
+       << " ms, intersection " << t_inter << " ms, difference " << t_diff
+       << " ms, complement " << t_compl << " ms, count " << t_count
+       << " ms, iteration " << t_iter << " ms, sparse iteration "
+       << t_iter_sparse << " ms." << endl;
+  return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////
+// Compares the convergence of the linear minimizers used by GMC on
+// noisy tangent directions of a circle.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "ImaGene/base/Arguments.h"
+#include "ImaGene/mathutils/Mathutils.h"
+#include "ImaGene/timetools/Clock.h"
+#include "ImaGene/helper/LinearMinimizer.h"
+
+
+using namespace std;
+using namespace ImaGene;
+
+
+static Arguments args;
+
+/**
+ * Fills [lm] with [nb] tangent directions of a circle, each one known
+ * up to [delta] around a noisy estimation.
+ */
+static void
+initCircle( LinearMinimizer & lm, uint nb, double delta )
+{
+  Mathutils::AngleComputer ac;
+  lm.init( nb );
+  srand( 1 );
+  for ( uint i = 0; i < nb; ++i )
+    {
+      LinearMinimizer::ValueInfo & vi = lm.rw( i );
+      double angle = 2.0 * M_PI * i / nb + M_PI / 2.0;
+      double noise = delta * ( 2.0 * rand() / (double) RAND_MAX - 1.0 );
+      vi.value = ac.cast( angle + noise );
+      vi.old_value = vi.value;
+      vi.min = ac.cast( vi.value - delta );
+      vi.max = ac.cast( vi.value + delta );
+      vi.dist_to_next = 1.0;
+    }
+}
+
+/**
+ * Optimizes [lm] until its last displacement is below [eps] or after
+ * [max_iter] steps, and displays the number of steps, time and
+ * final energy.
+ *
+ * @return the final energy.
+ */
+static double
+run( const string & name, LinearMinimizer & lm,
+     uint nb, double delta, double eps, uint max_iter )
+{
+  initCircle( lm, nb, delta );
+  double E0 = lm.getEnergy( 0, 0 );
+  Clock::startClock();
+  uint n = 0;
+  do
+    {
+      lm.optimize();
+      ++n;
+    }
+  while ( ( lm.lastDelta() > eps ) && ( n < max_iter ) );
+  long t = Clock::stopClock();
+  double E = lm.getEnergy( 0, 0 );
+  cout << "# " << name << ": " << n << " steps, " << t << " ms, energy "
+       << E0 << " -> " << E << ", last delta " << lm.lastDelta() << endl;
+  return E;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//
+// M A I N
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char** argv )
+{
+  // -------------------------------------------------------------------------
+  // Prepare arguments.
+  args.addOption( "-nb", "-nb <n>: number of values on the circle.", "2001" );
+  args.addOption( "-delta", "-delta <d>: half-width of the interval of each value.", "0.05" );
+  args.addOption( "-eps", "-eps <e>: stops when the last displacement is below <e>.", "0.0000001" );
+  args.addOption( "-maxIter", "-maxIter <n>: maximal number of steps.", "100000" );
+  args.addBooleanOption( "-gradient", "-gradient: also runs the gradient descents (which display their energy at each step)." );
+
+  if ( ( argc <= 0 )
+       || ! args.readArguments( argc, argv ) )
+    {
+      cerr << args.usage( "test_LinearMinimizer",
+			  "Optimizes noisy tangent directions of a circle with the linear minimizers, compares their number of steps and time, and checks that the red-black relaxation reaches the same energy as the relaxation."
+			  ,"" ) << endl;
+      return 1;
+    }
+
+  uint nb = args.getOption( "-nb" )->getIntValue( 0 );
+  double delta = args.getOption( "-delta" )->getDoubleValue( 0 );
+  double eps = args.getOption( "-eps" )->getDoubleValue( 0 );
+  uint max_iter = args.getOption( "-maxIter" )->getIntValue( 0 );
+
+  LinearMinimizer lm_std;
+  LinearMinimizerByRelaxation lm_rlx;
+  LinearMinimizerByRedBlackRelaxation lm_rb;
+  run( "STD", lm_std, nb, delta, eps, max_iter );
+  double E_rlx = run( "RLX", lm_rlx, nb, delta, eps, max_iter );
+  double E_rb = run( "RB ", lm_rb, nb, delta, eps, max_iter );
+  if ( args.check( "-gradient" ) )
+    {
+      LinearMinimizerByGradientDescent lm_gd( 0.1 );
+      LinearMinimizerByAdaptiveStepGradientDescent lm_agd( 0.1 );
+      run( "GD ", lm_gd, nb, delta, eps, max_iter );
+      run( "AGD", lm_agd, nb, delta, eps, max_iter );
+    }
+
+  bool ok = fabs( E_rb - E_rlx ) <= 1e-3 * E_rlx;
+  cout << "# RB/RLX energy " << ( ok ? "match." : "differ." ) << endl;
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+// Test the allocation-free length statistics of maximal segments
+// against the tangential cover computed on a digital space.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include "ImaGene/base/Arguments.h"
+#include "ImaGene/base/StandardArguments.h"
+#include "ImaGene/mathutils/Statistics.h"
+#include "ImaGene/timetools/Clock.h"
+#include "ImaGene/dgeometry2d/FreemanChain.h"
+#include "ImaGene/dgeometry2d/FreemanChainTransform.h"
+#include "ImaGene/dgeometry2d/MultiscaleFreemanChain.h"
+
+
+using namespace std;
+using namespace ImaGene;
+
+
+static Arguments args;
+
+/**
+ * @return 'true' if both doubles have the same bits (so that NaN
+ * values compare equal).
+ */
+static bool
+sameBits( double a, double b )
+{
+  return memcmp( &a, &b, sizeof( double ) ) == 0;
+}
+
+/**
+ * Compares both computations of the statistics on [fc].
+ *
+ * @return the number of surfels whose statistics differ.
+ */
+static uint
+compareStats( const FreemanChain & fc,
+	      MultiscaleFreemanChain::MaximalSegmentStats & stats )
+{
+  FreemanChain fc_copy( fc );
+  Statistics* ref = MultiscaleFreemanChain::getStatsMaximalSegments( fc_copy );
+  MultiscaleFreemanChain::getStatsMaximalSegments( fc, stats );
+  uint errors = 0;
+  if ( stats.mean.size() != ref->nb() )
+    return ref->nb() + 1;
+  for ( uint i = 0; i < ref->nb(); ++i )
+    if ( ( stats.samples[ i ] != ref->samples( i ) )
+	 || ! sameBits( stats.mean[ i ], ref->mean( i ) )
+	 || ! sameBits( stats.max[ i ], ref->max( i ) ) )
+      ++errors;
+  delete ref;
+  return errors;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//
+// M A I N
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char** argv )
+{
+  // -------------------------------------------------------------------------
+  // Prepare arguments.
+  StandardArguments::addIOArgs( args, true, false );
+  args.addOption( "-samplingSizeMax", "-samplingSizeMax <n>: choose how many scales are checked.", "4"  );
+  args.addOption( "-nbIterationSpikes", "-nbIterationSpikes <n>: number of spike cleaning passes of the subsampling.", "10"  );
+  args.addOption( "-bench", "-bench <n>: times <n> computations of the statistics on the whole chain with both methods.", "0"  );
+
+  if ( ( argc <= 0 )
+       || ! args.readArguments( argc, argv ) )
+    {
+      cerr << args.usage( "test_MaximalSegmentStats",
+			  "Checks that the allocation-free length statistics of maximal segments are identical to the ones computed with a tangential cover on a digital space, on the given contour and its subsamplings. Optionally compares their speed."
+			  ,"" ) << endl;
+      return 1;
+    }
+
+  uint samplingSizeMax = args.getOption( "-samplingSizeMax" )->getIntValue( 0 );
+  uint nbIterationSpikes = args.getOption( "-nbIterationSpikes" )->getIntValue( 0 );
+  uint nbBench = args.getOption( "-bench" )->getIntValue( 0 );
+
+  // -------------------------------------------------------------------------
+  // Read Freeman chain.
+  FreemanChain c;
+  istream & in_str = StandardArguments::openInput( args );
+  FreemanChain::read( in_str, c );
+  if ( ! in_str.good() )
+    {
+      cerr << "Error reading Freeman chain code." << endl;
+      return 2;
+    }
+
+  // -------------------------------------------------------------------------
+  // Compares both methods on every subsampled chain.
+  FreemanChainSubsample fcsub( 1, 1, 0, 0 );
+  FreemanChainCleanSpikesCCW fccs( nbIterationSpikes );
+  FreemanChainCompose fcomp( fccs, fcsub );
+  MultiscaleFreemanChain MFC;
+  MFC.chooseSubsampler( fcomp, fcsub );
+  MFC.init( c, samplingSizeMax );
+
+  // The same buffers are reused for all chains.
+  MultiscaleFreemanChain::MaximalSegmentStats stats;
+  uint nb_chains = 0;
+  uint errors = compareStats( c, stats );
+  for ( MultiscaleFreemanChain::const_iterator it = MFC.begin();
+	it != MFC.end(); ++it )
+    {
+      errors += compareStats( it->second.subc, stats );
+      ++nb_chains;
+    }
+  cout << "# " << c.chain.size() << " surfels, " << nb_chains
+       << " subsampled chains, " << errors << " errors." << endl;
+
+  // -------------------------------------------------------------------------
+  // Timings on the whole chain.
+  if ( nbBench != 0 )
+    {
+      Clock::startClock();
+      for ( uint n = 0; n < nbBench; ++n )
+	{
+	  FreemanChain fc_copy( c );
+	  Statistics* ref = MultiscaleFreemanChain::getStatsMaximalSegments( fc_copy );
+	  delete ref;
+	}
+      long t_ref = Clock::stopClock();
+      Clock::startClock();
+      for ( uint n = 0; n < nbBench; ++n )
+	MultiscaleFreemanChain::getStatsMaximalSegments( c, stats );
+      long t_new = Clock::stopClock();
+      cout << "# " << nbBench << " x " << c.chain.size() << " surfels:"
+	   << " KnSpace tangential cover " << t_ref << " ms,"
+	   << " allocation-free " << t_new << " ms." << endl;
+    }
+
+  return errors == 0 ? 0 : 1;
+}
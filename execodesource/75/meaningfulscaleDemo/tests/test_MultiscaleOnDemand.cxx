@@ -0,0 +1,180 @@
+///////////////////////////////////////////////////////////////////////////////
+// Test the on-demand computation of subsampled contours: compares the
+// multiscale profiles, memory and time with the stored subsamplings.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include "ImaGene/base/Arguments.h"
+#include "ImaGene/base/StandardArguments.h"
+#include "ImaGene/mathutils/Statistics.h"
+#include "ImaGene/timetools/Clock.h"
+#include "ImaGene/dgeometry2d/FreemanChain.h"
+#include "ImaGene/dgeometry2d/FreemanChainTransform.h"
+#include "ImaGene/dgeometry2d/MultiscaleFreemanChain.h"
+#include "ImaGene/helper/MultiscaleProfile.h"
+
+
+using namespace std;
+using namespace ImaGene;
+
+
+static Arguments args;
+
+/**
+ * @return the peak resident memory of the process in kilobytes.
+ */
+static long
+peakMemory()
+{
+  struct rusage usage;
+  getrusage( RUSAGE_SELF, &usage );
+  return usage.ru_maxrss;
+}
+
+/**
+ * @return 'true' if both doubles have the same bits (so that NaN
+ * values compare equal).
+ */
+static bool
+sameBits( double a, double b )
+{
+  return memcmp( &a, &b, sizeof( double ) ) == 0;
+}
+
+static bool
+sameKey( const MultiscaleFreemanChain::SubsampledChainKey & k1,
+	 const MultiscaleFreemanChain::SubsampledChainKey & k2 )
+{
+  return ! ( ( k1 < k2 ) || ( k2 < k1 ) );
+}
+
+/**
+ * @return the number of bytes used by the stored subsampled chains
+ * of [MP] and their mappings.
+ */
+static unsigned long
+storedBytes( const MultiscaleFreemanChain & MP )
+{
+  unsigned long bytes = 0;
+  for ( MultiscaleFreemanChain::const_iterator it = MP.begin();
+	it != MP.end(); ++it )
+    bytes += it->second.subc.chain.capacity()
+      + ( it->second.c2subc.capacity() + it->second.subc2c.capacity() )
+      * sizeof( uint );
+  return bytes;
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//
+// M A I N
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char** argv )
+{
+  // -------------------------------------------------------------------------
+  // Prepare arguments.
+  StandardArguments::addIOArgs( args, true, false );
+  args.addOption( "-samplingSizeMax", "-samplingSizeMax <n>: choose how many scales are computed.", "10"  );
+  args.addOption( "-nbIterationSpikes", "-nbIterationSpikes <n>: number of spike cleaning passes of the subsampling.", "10"  );
+  args.addOption( "-meaningfulScales", "-meaningfulScales <min_size> <max_slope>: parameters of the compared noise levels.", "1", "-0.2" );
+
+  if ( ( argc <= 0 )
+       || ! args.readArguments( argc, argv ) )
+    {
+      cerr << args.usage( "test_MultiscaleOnDemand",
+			  "Computes the multiscale profile of a contour with subsampled contours computed on demand, then stored, and compares the profiles, noise levels, peak memory and time of both."
+			  ,"" ) << endl;
+      return 1;
+    }
+
+  uint samplingSizeMax = args.getOption( "-samplingSizeMax" )->getIntValue( 0 );
+  uint nbIterationSpikes = args.getOption( "-nbIterationSpikes" )->getIntValue( 0 );
+  uint mscales_min_size = args.getOption( "-meaningfulScales" )->getIntValue( 0 );
+  double mscales_max_slope = args.getOption( "-meaningfulScales" )->getDoubleValue( 1 );
+
+  // -------------------------------------------------------------------------
+  // Read Freeman chain.
+  FreemanChain c;
+  istream & in_str = StandardArguments::openInput( args );
+  FreemanChain::read( in_str, c );
+  if ( ! in_str.good() )
+    {
+      cerr << "Error reading Freeman chain code." << endl;
+      return 2;
+    }
+
+  FreemanChainSubsample fcsub( 1, 1, 0, 0 );
+  FreemanChainCleanSpikesCCW fccs( nbIterationSpikes );
+  FreemanChainCompose fcomp( fccs, fcsub );
+
+  // -------------------------------------------------------------------------
+  // On-demand first, so that its peak memory is not hidden by the
+  // stored subsamplings.
+  long mem_start = peakMemory();
+  Clock::startClock();
+  MultiscaleProfile MPd;
+  MPd.chooseSubsampler( fcomp, fcsub );
+  MPd.init( c, samplingSizeMax, true );
+  long t_demand = Clock::stopClock();
+  long mem_demand = peakMemory();
+
+  Clock::startClock();
+  MultiscaleProfile MPs;
+  MPs.chooseSubsampler( fcomp, fcsub );
+  MPs.init( c, samplingSizeMax );
+  long t_stored = Clock::stopClock();
+  long mem_stored = peakMemory();
+
+  // -------------------------------------------------------------------------
+  // Compares profiles and noise levels.
+  uint errors = 0;
+  for ( uint k = 0; k < samplingSizeMax; ++k )
+    for ( uint i = 0; i < c.chain.size(); ++i )
+      {
+	const MultiscaleProfile::LengthStatsAtScale & sd = MPd.all_stats[ k ];
+	const MultiscaleProfile::LengthStatsAtScale & ss = MPs.all_stats[ k ];
+	if ( ( sd.stats->samples( i ) != ss.stats->samples( i ) )
+	     || ! sameBits( sd.stats->mean( i ), ss.stats->mean( i ) )
+	     || ! sameKey( sd.longest_ms[ i ].first, ss.longest_ms[ i ].first )
+	     || ! sameBits( sd.longest_ms[ i ].second, ss.longest_ms[ i ].second )
+	     || ! sameKey( sd.longest_mean[ i ].first, ss.longest_mean[ i ].first )
+	     || ! sameBits( sd.longest_mean[ i ].second, ss.longest_mean[ i ].second ) )
+	  ++errors;
+      }
+  for ( uint i = 0; i < c.chain.size(); ++i )
+    if ( MPd.noiseLevel( i, mscales_min_size, mscales_max_slope )
+	 != MPs.noiseLevel( i, mscales_min_size, mscales_max_slope ) )
+      ++errors;
+
+  // Chains given by 'get' are the stored ones.
+  for ( MultiscaleFreemanChain::const_iterator it = MPs.begin();
+	it != MPs.end(); ++it )
+    {
+      const MultiscaleFreemanChain::SubsampledChain* sub = MPd.get( it->first );
+      if ( ( sub == 0 )
+	   || ( sub->subc.chain != it->second.subc.chain )
+	   || ( sub->subc.x0 != it->second.subc.x0 )
+	   || ( sub->subc.y0 != it->second.subc.y0 )
+	   || ( sub->c2subc != it->second.c2subc )
+	   || ( sub->subc2c != it->second.subc2c ) )
+	++errors;
+    }
+
+  cout << "# " << c.chain.size() << " surfels, scales 1-" << samplingSizeMax
+       << ", " << errors << " errors." << endl
+       << "# on-demand: " << t_demand << " ms, peak memory +"
+       << ( mem_demand - mem_start ) << " kB" << endl
+       << "# stored:    " << t_stored << " ms, peak memory +"
+       << ( mem_stored - mem_demand ) << " kB over on-demand, "
+       << storedBytes( MPs ) / 1024 << " kB of subsampled contours" << endl;
+  return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,111 @@
+///////////////////////////////////////////////////////////////////////////////
+// Test the batch computation of meaningful scales and noise levels
+// against the surfel by surfel computation.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+#include <vector>
+#include "ImaGene/base/Arguments.h"
+#include "ImaGene/base/StandardArguments.h"
+#include "ImaGene/timetools/Clock.h"
+#include "ImaGene/dgeometry2d/FreemanChain.h"
+#include "ImaGene/dgeometry2d/FreemanChainTransform.h"
+#include "ImaGene/helper/MultiscaleProfile.h"
+
+
+using namespace std;
+using namespace ImaGene;
+
+
+static Arguments args;
+
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//
+// M A I N
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char** argv )
+{
+  // -------------------------------------------------------------------------
+  // Prepare arguments.
+  StandardArguments::addIOArgs( args, true, false );
+  args.addOption( "-samplingSizeMax", "-samplingSizeMax <n>: choose how many scales are computed.", "10"  );
+  args.addOption( "-nbIterationSpikes", "-nbIterationSpikes <n>: number of spike cleaning passes of the subsampling.", "5"  );
+  args.addOption( "-meaningfulScales", "-meaningfulScales <min_size> <max_slope>: parameters of the meaningful scales.", "1", "-0.2" );
+
+  if ( ( argc <= 0 )
+       || ! args.readArguments( argc, argv ) )
+    {
+      cerr << args.usage( "test_NoiseLevels",
+			  "Checks that the batch computation of the meaningful scales and noise levels of all the surfels of a contour gives the same results as the computation surfel by surfel, and compares their speed."
+			  ,"" ) << endl;
+      return 1;
+    }
+
+  uint samplingSizeMax = args.getOption( "-samplingSizeMax" )->getIntValue( 0 );
+  uint nbIterationSpikes = args.getOption( "-nbIterationSpikes" )->getIntValue( 0 );
+  uint mscales_min_size = args.getOption( "-meaningfulScales" )->getIntValue( 0 );
+  double mscales_max_slope = args.getOption( "-meaningfulScales" )->getDoubleValue( 1 );
+
+  // -------------------------------------------------------------------------
+  // Read Freeman chain.
+  FreemanChain c;
+  istream & in_str = StandardArguments::openInput( args );
+  FreemanChain::read( in_str, c );
+  if ( ! in_str.good() )
+    {
+      cerr << "Error reading Freeman chain code." << endl;
+      return 2;
+    }
+
+  FreemanChainSubsample fcsub( 1, 1, 0, 0 );
+  FreemanChainCleanSpikesCCW fccs( nbIterationSpikes );
+  FreemanChainCompose fcomp( fccs, fcsub );
+  MultiscaleProfile MP;
+  MP.chooseSubsampler( fcomp, fcsub );
+  MP.init( c, samplingSizeMax, true );
+
+  // -------------------------------------------------------------------------
+  // Surfel by surfel.
+  const uint nb = c.chain.size();
+  Clock::startClock();
+  vector<uint> ref_levels( nb );
+  for ( uint i = 0; i < nb; ++i )
+    ref_levels[ i ] = MP.noiseLevel( i, mscales_min_size, mscales_max_slope );
+  long t_ref = Clock::stopClock();
+
+  // -------------------------------------------------------------------------
+  // Batch.
+  Clock::startClock();
+  vector<uint> levels;
+  MP.noiseLevels( levels, mscales_min_size, mscales_max_slope );
+  long t_batch = Clock::stopClock();
+
+  uint errors = levels.size() == nb ? 0 : nb + 1;
+  for ( uint i = 0; ( i < nb ) && ( i < levels.size() ); ++i )
+    if ( levels[ i ] != ref_levels[ i ] )
+      ++errors;
+
+  vector< vector< pair<uint,uint> > > intervals;
+  MP.allMeaningfulScales( intervals, mscales_min_size, mscales_max_slope );
+  if ( intervals.size() != nb )
+    errors += nb + 1;
+  for ( uint i = 0; ( i < nb ) && ( i < intervals.size() ); ++i )
+    {
+      vector< pair<uint,uint> > ref_intervals;
+      MP.meaningfulScales( ref_intervals, i, mscales_min_size, mscales_max_slope );
+      if ( ref_intervals != intervals[ i ] )
+	++errors;
+    }
+
+  cout << "# " << nb << " surfels, scales 1-" << samplingSizeMax
+       << ", " << errors << " errors." << endl
+       << "# noise levels: surfel by surfel " << t_ref << " ms,"
+       << " batch " << t_batch << " ms." << endl;
+  return errors == 0 ? 0 : 1;
+}
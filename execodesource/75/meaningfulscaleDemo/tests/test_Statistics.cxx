@@ -0,0 +1,181 @@
+///////////////////////////////////////////////////////////////////////////////
+// Test the storage of sample values in Statistics and the merge of
+// statistics filled in parallel, against per-variable vectors.
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+#include <sys/time.h>
+#include <sys/resource.h>
+#include "ImaGene/base/Arguments.h"
+#include "ImaGene/mathutils/Statistics.h"
+#include "ImaGene/timetools/Clock.h"
+
+
+using namespace std;
+using namespace ImaGene;
+
+
+static Arguments args;
+
+/**
+ * @return the peak resident memory of the process in kilobytes.
+ */
+static long
+peakMemory()
+{
+  struct rusage usage;
+  getrusage( RUSAGE_SELF, &usage );
+  return usage.ru_maxrss;
+}
+
+/**
+ * @return the sample value given to variable [i] at shift [s], in
+ * the same order as MultiscaleProfile::init (shift by shift, then
+ * variable by variable).
+ */
+static double
+sampleValue( uint i, uint s )
+{
+  return 1.0 + ( ( i * 7919 + s * 104729 ) % 1000 ) / 37.0
+    + sin( 0.01 * i );
+}
+
+/**
+ * Adds the sample values of shifts [s0] to [s1] (excluded) of [nb]
+ * variables to [stats].
+ */
+static void
+fill( Statistics & stats, uint nb, uint s0, uint s1 )
+{
+  for ( uint s = s0; s < s1; ++s )
+    for ( uint i = 0; i < nb; ++i )
+      stats.addValue( i, sampleValue( i, s ) );
+}
+
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+//
+// M A I N
+//
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+int
+main( int argc, char** argv )
+{
+  // -------------------------------------------------------------------------
+  // Prepare arguments.
+  args.addOption( "-nb", "-nb <n>: number of statistical variables.", "100000" );
+  args.addOption( "-shifts", "-shifts <n>: number of samples per variable.", "16" );
+  args.addOption( "-parts", "-parts <n>: number of partial statistics merged together.", "4" );
+
+  if ( ( argc <= 0 )
+       || ! args.readArguments( argc, argv ) )
+    {
+      cerr << args.usage( "test_Statistics",
+			  "Fills statistics storing their samples like MultiscaleProfile does, checks their values, extrema and medians against per-variable vectors, checks that merging partial statistics filled in parallel gives the same results, and compares their times."
+			  ,"" ) << endl;
+      return 1;
+    }
+
+  uint nb = args.getOption( "-nb" )->getIntValue( 0 );
+  uint shifts = args.getOption( "-shifts" )->getIntValue( 0 );
+  int parts = args.getOption( "-parts" )->getIntValue( 0 );
+
+  // -------------------------------------------------------------------------
+  // Stored values first, so that their peak memory is not hidden by
+  // the other ones.
+  long mem_start = peakMemory();
+  Clock::startClock();
+  Statistics stats( nb, true );
+  fill( stats, nb, 0, shifts );
+  stats.terminate();
+  long t_stats = Clock::stopClock();
+  long mem_stats = peakMemory();
+
+  // -------------------------------------------------------------------------
+  // One vector per variable, as stored before.
+  Clock::startClock();
+  vector<double>* ref = new vector<double>[ nb ];
+  for ( uint i = 0; i < nb; ++i )
+    ref[ i ].reserve( 128 );
+  for ( uint s = 0; s < shifts; ++s )
+    for ( uint i = 0; i < nb; ++i )
+      ref[ i ].push_back( sampleValue( i, s ) );
+  long t_ref = Clock::stopClock();
+  long mem_ref = peakMemory();
+
+  // -------------------------------------------------------------------------
+  // Partial statistics filled in parallel, then merged.
+  Clock::startClock();
+  Statistics merged( nb, true );
+  vector<Statistics*> partial( parts );
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+  for ( int p = 0; p < parts; ++p )
+    {
+      partial[ p ] = new Statistics( nb, true );
+      fill( *partial[ p ], nb,
+	    p * shifts / parts, ( p + 1 ) * shifts / parts );
+    }
+  for ( int p = 0; p < parts; ++p )
+    {
+      merged.merge( *partial[ p ] );
+      delete partial[ p ];
+    }
+  merged.terminate();
+  long t_merged = Clock::stopClock();
+
+  uint errors = 0;
+  for ( uint i = 0; i < nb; ++i )
+    {
+      const vector<double> & v = ref[ i ];
+      uint imax = max_element( v.begin(), v.end() ) - v.begin();
+      uint imin = min_element( v.begin(), v.end() ) - v.begin();
+      double sum = 0.0;
+      for ( uint j = 0; j < v.size(); ++j )
+	sum += v[ j ];
+      vector<double> w( v );
+      nth_element( w.begin(), w.begin() + w.size() / 2, w.end() );
+      double med = w[ w.size() / 2 ];
+      for ( uint j = 0; j < v.size(); ++j )
+	if ( ( stats.value( i, j ) != v[ j ] )
+	     || ( merged.value( i, j ) != v[ j ] ) )
+	  ++errors;
+      if ( ( stats.samples( i ) != v.size() )
+	   || ( stats.mean( i ) != sum / v.size() )
+	   || ( stats.max( i ) != v[ imax ] )
+	   || ( stats.maxIndice( i ) != imax )
+	   || ( stats.min( i ) != v[ imin ] )
+	   || ( stats.minIndice( i ) != imin )
+	   || ( stats.median( i ) != med ) )
+	++errors;
+      // Merging changes the order of the summation.
+      if ( ( merged.samples( i ) != v.size() )
+	   || ( fabs( merged.mean( i ) - stats.mean( i ) )
+		> 1e-12 * stats.mean( i ) )
+	   || ( fabs( merged.variance( i ) - stats.variance( i ) )
+		> 1e-9 * stats.mean( i ) * stats.mean( i ) )
+	   || ( merged.max( i ) != v[ imax ] )
+	   || ( merged.maxIndice( i ) != imax )
+	   || ( merged.min( i ) != v[ imin ] )
+	   || ( merged.minIndice( i ) != imin )
+	   || ( merged.median( i ) != med ) )
+	++errors;
+    }
+  delete[] ref;
+
+  cout << "# " << nb << " variables, " << shifts << " samples each, "
+       << errors << " errors." << endl
+       << "# stored values: " << t_stats << " ms, peak memory +"
+       << ( mem_stats - mem_start ) << " kB" << endl
+       << "# one vector per variable: " << t_ref << " ms, peak memory +"
+       << ( mem_ref - mem_stats ) << " kB over stored values" << endl
+       << "# " << parts << " merged parts: " << t_merged << " ms." << endl;
+  return errors == 0 ? 0 : 1;
+}